@@ -0,0 +1,147 @@
+/**
+ *
+ *  @file codec_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <vix/sync/Codec.hpp>
+#include <vix/sync/wal/Wal.hpp>
+
+using namespace vix::sync;
+
+// Usage: vix_sync_codec_bench [payload_bytes] [payload_count]
+//
+// Reports, per codec, the compression ratio and the CPU cost per MB of
+// original bytes, then the WAL bytes written for the same payloads.
+
+static std::string make_json_payload(std::size_t target, std::mt19937_64 &rng)
+{
+  static const char *kNames[] = {"alice", "bob", "carol", "dave", "erin", "frank"};
+  static const char *kStatus[] = {"pending", "sent", "delivered", "read"};
+
+  std::string out = "{\"items\":[";
+  std::size_t i = 0;
+  while (out.size() < target)
+  {
+    if (i++ > 0)
+      out += ',';
+    out += "{\"id\":" + std::to_string(rng() % 1000000) +
+           ",\"user\":\"" + kNames[rng() % 6] +
+           "\",\"status\":\"" + kStatus[rng() % 4] +
+           "\",\"ts\":" + std::to_string(1700000000000 + rng() % 100000000) +
+           ",\"text\":\"message body " + std::to_string(rng() % 1000) + "\"}";
+  }
+  out += "]}";
+  return out;
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point t0)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static std::uint64_t wal_bytes(const std::vector<std::string> &payloads, CodecId codec)
+{
+  const auto path = std::filesystem::temp_directory_path() / "vix_sync_codec_bench.wal";
+  std::filesystem::remove(path);
+
+  wal::Wal::Config cfg;
+  cfg.file_path = path;
+  cfg.compression.codec = codec;
+  wal::Wal w(cfg);
+
+  for (const auto &p : payloads)
+  {
+    wal::WalRecord r;
+    r.id = "op";
+    r.type = wal::RecordType::PutOperation;
+    r.payload.assign(p.begin(), p.end());
+    w.append(r);
+  }
+
+  const auto size = std::filesystem::file_size(path);
+  std::filesystem::remove(path);
+  return size;
+}
+
+int main(int argc, char **argv)
+{
+  const std::size_t payload_bytes = argc > 1 ? std::stoul(argv[1]) : 4096;
+  const std::size_t count = argc > 2 ? std::stoul(argv[2]) : 2000;
+
+  std::mt19937_64 rng(42);
+  std::vector<std::string> payloads;
+  payloads.reserve(count);
+  std::uint64_t raw_total = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    payloads.push_back(make_json_payload(payload_bytes, rng));
+    raw_total += payloads.back().size();
+  }
+  const double raw_mb = static_cast<double>(raw_total) / (1024.0 * 1024.0);
+
+  std::printf("payloads: %zu x ~%zu bytes (%.1f MB)\n\n", count, payload_bytes, raw_mb);
+  std::printf("%-6s %12s %8s %14s %14s %14s\n",
+              "codec", "bytes_out", "ratio", "comp_ms/MB", "decomp_ms/MB", "wal_bytes");
+
+  std::printf("%-6s %12llu %8.2f %14s %14s %14llu\n",
+              "none",
+              static_cast<unsigned long long>(raw_total), 1.0, "-", "-",
+              static_cast<unsigned long long>(wal_bytes(payloads, CodecId::None)));
+
+  for (auto id : {CodecId::Lz, CodecId::Lz4, CodecId::Zstd})
+  {
+    auto codec = find_codec(id);
+    if (!codec)
+      continue;
+
+    std::vector<std::string> packed;
+    packed.reserve(count);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (const auto &p : payloads)
+      packed.push_back(codec->compress(p));
+    const double comp_s = seconds_since(t0);
+
+    std::uint64_t out_total = 0;
+    std::size_t check = 0;
+    t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      out_total += packed[i].size();
+      check += codec->decompress(packed[i], payloads[i].size()).size();
+    }
+    const double decomp_s = seconds_since(t0);
+
+    if (check != raw_total)
+    {
+      std::fprintf(stderr, "%s: round-trip mismatch\n", std::string(codec->name()).c_str());
+      return 1;
+    }
+
+    std::printf("%-6s %12llu %8.2f %14.3f %14.3f %14llu\n",
+                std::string(codec->name()).c_str(),
+                static_cast<unsigned long long>(out_total),
+                static_cast<double>(raw_total) / static_cast<double>(out_total),
+                comp_s * 1000.0 / raw_mb,
+                decomp_s * 1000.0 / raw_mb,
+                static_cast<unsigned long long>(wal_bytes(payloads, id)));
+  }
+
+  return 0;
+}
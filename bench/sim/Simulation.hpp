@@ -0,0 +1,490 @@
+/**
+ *
+ *  @file Simulation.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_SIM_SIMULATION_HPP
+#define VIX_SYNC_SIM_SIMULATION_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <vix/sync/Clock.hpp>
+#include <vix/sync/engine/SyncEngine.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+
+namespace vix::sync::sim
+{
+  /**
+   * @brief Deterministic random source (same seed, same run on any platform).
+   */
+  class Random
+  {
+  public:
+    explicit Random(std::uint64_t seed) : state_(seed ? seed : 0x9e3779b97f4a7c15ull) {}
+
+    /**
+     * @brief Next 64 random bits (splitmix64).
+     */
+    std::uint64_t next() noexcept
+    {
+      std::uint64_t z = (state_ += 0x9e3779b97f4a7c15ull);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Uniform double in [0, 1).
+     */
+    double uniform() noexcept
+    {
+      return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+    /**
+     * @brief Exponentially distributed value with the given mean.
+     */
+    double exponential(double mean) noexcept
+    {
+      if (mean <= 0.0)
+        return 0.0;
+      return -std::log(1.0 - uniform()) * mean;
+    }
+
+  private:
+    std::uint64_t state_;
+  };
+
+  /**
+   * @brief Window of virtual time during which a target is unreachable.
+   */
+  struct Outage
+  {
+    std::int64_t start_ms{0};
+    std::int64_t end_ms{0};
+  };
+
+  /**
+   * @brief Behavior of one simulated remote target.
+   *
+   * A send_batch() call to the target takes
+   * latency_ms + per_op_ms * batch size + exponential(jitter_ms)
+   * of virtual time. During an outage every operation fails (retryable).
+   * Otherwise each operation fails with error_rate (retryable) or
+   * permanent_error_rate (not retryable).
+   */
+  struct TargetModel
+  {
+    std::string target{"/api/sim"};
+    double weight{1.0};
+    double latency_ms{20.0};
+    double jitter_ms{10.0};
+    double per_op_ms{0.0};
+    double error_rate{0.0};
+    double permanent_error_rate{0.0};
+    std::vector<Outage> outages;
+
+    /**
+     * @brief Periodic outages: every outage_every_ms, for outage_duration_ms.
+     */
+    std::int64_t outage_every_ms{0};
+    std::int64_t outage_duration_ms{0};
+
+    bool in_outage(std::int64_t t_ms) const noexcept
+    {
+      for (const auto &o : outages)
+      {
+        if (t_ms >= o.start_ms && t_ms < o.end_ms)
+          return true;
+      }
+      return outage_every_ms > 0 && outage_duration_ms > 0 &&
+             t_ms % outage_every_ms >= outage_every_ms - outage_duration_ms;
+    }
+  };
+
+  /**
+   * @brief Workload, target models and engine settings of one run.
+   */
+  struct Scenario
+  {
+    std::uint64_t seed{1};
+
+    /**
+     * @brief Number of operations enqueued over the run.
+     */
+    std::size_t ops{100'000};
+
+    /**
+     * @brief Mean arrival rate (Poisson arrivals).
+     */
+    double arrival_rate_per_sec{1'000.0};
+
+    std::size_t payload_bytes{128};
+
+    std::vector<TargetModel> targets{TargetModel{}};
+
+    /**
+     * @brief Minimum virtual time between two engine ticks that did work.
+     */
+    std::int64_t tick_ms{1};
+
+    /**
+     * @brief Virtual time between two queue-depth samples.
+     */
+    std::int64_t sample_every_ms{1'000};
+
+    /**
+     * @brief Stop after this much virtual time even if work remains.
+     */
+    std::int64_t max_sim_ms{24 * 60 * 60 * 1000};
+
+    vix::sync::engine::SyncEngine::Config engine{};
+    vix::sync::outbox::Outbox::Config outbox{};
+  };
+
+  /**
+   * @brief Outcome of a simulation run.
+   */
+  struct Report
+  {
+    std::size_t enqueued{0};
+    std::size_t completed{0};
+    std::size_t failed{0};
+    std::size_t remaining{0};
+    std::uint64_t attempts{0};
+    std::uint64_t retryable_errors{0};
+    std::uint64_t permanent_errors{0};
+    std::uint64_t ticks{0};
+    std::int64_t sim_ms{0};
+    double wall_ms{0.0};
+    double throughput_per_sec{0.0};
+    std::size_t max_depth{0};
+
+    /**
+     * @brief End-to-end latency (enqueue to acknowledged send) percentiles.
+     */
+    std::vector<std::pair<std::string, double>> latency_ms;
+
+    /**
+     * @brief Queue depth samples as (virtual time, live operations).
+     */
+    std::vector<std::pair<std::int64_t, std::size_t>> depth;
+
+    std::string to_json() const
+    {
+      std::ostringstream out;
+      out << "{\"enqueued\":" << enqueued
+          << ",\"completed\":" << completed
+          << ",\"failed\":" << failed
+          << ",\"remaining\":" << remaining
+          << ",\"attempts\":" << attempts
+          << ",\"retryable_errors\":" << retryable_errors
+          << ",\"permanent_errors\":" << permanent_errors
+          << ",\"ticks\":" << ticks
+          << ",\"sim_ms\":" << sim_ms
+          << ",\"wall_ms\":" << wall_ms
+          << ",\"throughput_per_sec\":" << throughput_per_sec
+          << ",\"max_depth\":" << max_depth
+          << ",\"latency_ms\":{";
+      for (std::size_t i = 0; i < latency_ms.size(); ++i)
+        out << (i ? "," : "") << "\"" << latency_ms[i].first << "\":" << latency_ms[i].second;
+      out << "},\"depth\":[";
+      for (std::size_t i = 0; i < depth.size(); ++i)
+        out << (i ? "," : "") << "[" << depth[i].first << "," << depth[i].second << "]";
+      out << "]}";
+      return out.str();
+    }
+  };
+
+  /**
+   * @brief Transport answering from per-target models in virtual time.
+   *
+   * Sends are synchronous in SyncWorker, so the engine is busy for the
+   * whole simulated latency of each batch: a tick that sends batches
+   * totalling 80 ms of latency ends 80 ms of virtual time later, and each
+   * operation is acknowledged at the tick start plus the latency of the
+   * batches sent before it.
+   */
+  class SimTransport final : public vix::sync::engine::ISyncTransport
+  {
+  public:
+    SimTransport(std::vector<TargetModel> targets, std::uint64_t seed)
+        : targets_(std::move(targets)), rng_(seed ^ 0x5deece66dull)
+    {
+      for (std::size_t i = 0; i < targets_.size(); ++i)
+        index_[targets_[i].target] = i;
+    }
+
+    /**
+     * @brief Start a tick at virtual time now_ms.
+     */
+    void begin_tick(std::int64_t now_ms) noexcept
+    {
+      tick_start_ms_ = now_ms;
+      busy_ms_ = 0.0;
+    }
+
+    /**
+     * @brief Virtual time spent sending since begin_tick().
+     */
+    double busy_ms() const noexcept { return busy_ms_; }
+
+    vix::sync::engine::SendResult send(const vix::sync::Operation &op) override
+    {
+      return send_batch(std::span<const vix::sync::Operation>(&op, 1)).front();
+    }
+
+    std::vector<vix::sync::engine::SendResult> send_batch(std::span<const vix::sync::Operation> ops) override
+    {
+      std::vector<vix::sync::engine::SendResult> out(ops.size());
+      if (ops.empty())
+        return out;
+
+      const auto &model = model_(ops.front().target);
+      const double latency = model.latency_ms +
+                             model.per_op_ms * static_cast<double>(ops.size()) +
+                             rng_.exponential(model.jitter_ms);
+
+      const auto sent_at = tick_start_ms_ + static_cast<std::int64_t>(busy_ms_);
+      busy_ms_ += latency;
+      const double acked_at = static_cast<double>(tick_start_ms_) + busy_ms_;
+      const bool down = model.in_outage(sent_at);
+
+      for (std::size_t i = 0; i < ops.size(); ++i)
+      {
+        ++attempts;
+        auto &r = out[i];
+
+        if (down)
+        {
+          r.error = "outage";
+          ++retryable_errors;
+          continue;
+        }
+
+        const double u = rng_.uniform();
+        if (u < model.permanent_error_rate)
+        {
+          r.retryable = false;
+          r.error = "rejected";
+          ++permanent_errors;
+        }
+        else if (u < model.permanent_error_rate + model.error_rate)
+        {
+          r.error = "unavailable";
+          ++retryable_errors;
+        }
+        else
+        {
+          r.ok = true;
+          latencies_ms.push_back(acked_at - static_cast<double>(ops[i].created_at_ms));
+        }
+      }
+      return out;
+    }
+
+    std::uint64_t attempts{0};
+    std::uint64_t retryable_errors{0};
+    std::uint64_t permanent_errors{0};
+
+    /**
+     * @brief End-to-end latency of each acknowledged operation.
+     */
+    std::vector<double> latencies_ms;
+
+  private:
+    const TargetModel &model_(const std::string &target) const
+    {
+      auto it = index_.find(target);
+      return it == index_.end() ? targets_.front() : targets_[it->second];
+    }
+
+    std::vector<TargetModel> targets_;
+    std::unordered_map<std::string, std::size_t> index_;
+    Random rng_;
+    std::int64_t tick_start_ms_{0};
+    double busy_ms_{0.0};
+  };
+
+  /**
+   * @brief Discrete-event driver running SyncEngine::tick in virtual time.
+   *
+   * The engine runs single-threaded against an in-memory FileOutboxStore,
+   * with a VirtualClock shared by the outbox and the engine.
+   * Virtual time jumps from one event to the next: the end of a busy tick,
+   * the next idle wake-up (idle_sleep_ms, or earlier for a rate-limit
+   * token), or the tick following the next arrival when the queue is empty.
+   */
+  class Simulator
+  {
+  public:
+    explicit Simulator(Scenario sc) : sc_(std::move(sc))
+    {
+      if (sc_.targets.empty())
+        sc_.targets.push_back(TargetModel{});
+    }
+
+    Report run()
+    {
+      using namespace vix::sync;
+
+      const auto wall_start = std::chrono::steady_clock::now();
+
+      outbox::FileOutboxStore::Config scfg;
+      scfg.file_path.clear();
+      scfg.idempotency_retention_ms = 0;
+      auto store = std::make_shared<outbox::FileOutboxStore>(scfg);
+
+      auto clock = std::make_shared<VirtualClock>(0);
+      auto ocfg = sc_.outbox;
+      ocfg.clock = clock;
+      auto box = std::make_shared<outbox::Outbox>(ocfg, store);
+
+      auto transport = std::make_shared<SimTransport>(sc_.targets, sc_.seed);
+      engine::SyncEngine eng(sc_.engine, box, nullptr, transport);
+
+      Random arrivals(sc_.seed);
+      double total_weight = 0.0;
+      for (const auto &t : sc_.targets)
+        total_weight += std::max(t.weight, 0.0);
+
+      const double mean_gap_ms = sc_.arrival_rate_per_sec > 0.0 ? 1000.0 / sc_.arrival_rate_per_sec : 0.0;
+      const std::string payload(sc_.payload_bytes, 'p');
+      const std::int64_t idle_ms = std::max<std::int64_t>(sc_.engine.idle_sleep_ms, 1);
+
+      Report rep;
+      std::size_t issued = 0;
+      double next_arrival = 0.0;
+      std::int64_t now = clock->now_ms();
+      std::int64_t next_sample = 0;
+
+      auto pick_target = [&]() -> const std::string &
+      {
+        double x = arrivals.uniform() * total_weight;
+        for (const auto &t : sc_.targets)
+        {
+          x -= std::max(t.weight, 0.0);
+          if (x < 0.0)
+            return t.target;
+        }
+        return sc_.targets.back().target;
+      };
+
+      while (true)
+      {
+        while (issued < sc_.ops && next_arrival <= static_cast<double>(now))
+        {
+          Operation op;
+          op.kind = "sim.send";
+          op.target = pick_target();
+          op.payload = payload;
+          box->enqueue(std::move(op), static_cast<std::int64_t>(next_arrival));
+          ++issued;
+          next_arrival += arrivals.exponential(mean_gap_ms);
+        }
+
+        transport->begin_tick(now);
+        const auto processed = eng.tick();
+        ++rep.ticks;
+
+        const auto depth = box->depth().ops;
+        rep.max_depth = std::max(rep.max_depth, depth);
+        if (now >= next_sample)
+        {
+          rep.depth.emplace_back(now, depth);
+          store->prune_done(now);
+          next_sample = now + sc_.sample_every_ms;
+        }
+
+        if ((issued == sc_.ops && depth == 0) || now >= sc_.max_sim_ms)
+          break;
+
+        const auto busy = static_cast<std::int64_t>(std::ceil(transport->busy_ms()));
+        std::int64_t next = now;
+        if (processed > 0)
+        {
+          next += std::max(sc_.tick_ms, busy);
+        }
+        else
+        {
+          auto sleep = idle_ms;
+          const auto wake = eng.next_wake_at_ms();
+          if (wake > now)
+            sleep = std::min(sleep, wake - now);
+          next += std::max(sleep, busy);
+
+          // Nothing queued: skip the idle ticks before the next arrival.
+          if (depth == 0 && issued < sc_.ops && static_cast<double>(next) < next_arrival)
+          {
+            const auto gap = static_cast<std::int64_t>(std::ceil(next_arrival)) - now;
+            next = now + (gap + idle_ms - 1) / idle_ms * idle_ms;
+          }
+        }
+        now = next;
+        clock->set_ms(now);
+      }
+
+      rep.enqueued = issued;
+      rep.completed = transport->latencies_ms.size();
+      rep.remaining = box->depth().ops;
+      rep.failed = rep.enqueued - rep.completed - rep.remaining;
+      rep.attempts = transport->attempts;
+      rep.retryable_errors = transport->retryable_errors;
+      rep.permanent_errors = transport->permanent_errors;
+      rep.sim_ms = now;
+      rep.throughput_per_sec = now > 0 ? static_cast<double>(rep.completed) * 1000.0 / static_cast<double>(now) : 0.0;
+      rep.latency_ms = percentiles_(transport->latencies_ms);
+      rep.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall_start).count();
+      return rep;
+    }
+
+  private:
+    static std::vector<std::pair<std::string, double>> percentiles_(std::vector<double> &v)
+    {
+      if (v.empty())
+        return {};
+
+      std::vector<std::pair<std::string, double>> out;
+      const std::pair<const char *, double> qs[] = {
+          {"p50", 0.50}, {"p90", 0.90}, {"p99", 0.99}, {"p999", 0.999}};
+      for (const auto &[name, q] : qs)
+      {
+        auto nth = v.begin() + static_cast<std::ptrdiff_t>(q * static_cast<double>(v.size() - 1));
+        std::nth_element(v.begin(), nth, v.end());
+        out.emplace_back(name, *nth);
+      }
+      out.emplace_back("max", *std::max_element(v.begin(), v.end()));
+
+      double sum = 0.0;
+      for (const auto x : v)
+        sum += x;
+      out.emplace_back("mean", sum / static_cast<double>(v.size()));
+      return out;
+    }
+
+    Scenario sc_;
+  };
+
+} // namespace vix::sync::sim
+
+#endif // VIX_SYNC_SIM_SIMULATION_HPP
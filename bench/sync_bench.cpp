@@ -0,0 +1,364 @@
+/**
+ *
+ *  @file sync_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+#include <vix/sync/wal/Wal.hpp>
+#include <vix/sync/wal/WalWriter.hpp>
+
+// Usage:
+//   vix_sync_bench [--ops N] [--load-sizes 10000,100000,1000000]
+//                  [--fsync-ops N] [--payload-bytes N] [--filter SUBSTR]
+//                  [--out FILE]
+//
+// Results are written as JSON to stdout (or FILE):
+//   {"benchmarks":[{"name":..., "params":{...}, "iterations":N,
+//                   "total_ms":..., "ns_per_op":..., "ops_per_sec":...}, ...]}
+//
+// FileOutboxStore rewrites its file on every mutation, so Outbox benchmarks
+// default to a few thousand operations; load benchmarks write the store file
+// directly and go up to a million operations.
+
+using namespace vix::sync;
+using namespace vix::sync::outbox;
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  struct Options
+  {
+    std::size_t ops{1'000};
+    std::vector<std::size_t> load_sizes{10'000, 100'000, 1'000'000};
+    std::size_t fsync_ops{200};
+    std::size_t payload_bytes{256};
+    std::string filter;
+    std::string out;
+    std::filesystem::path dir{std::filesystem::temp_directory_path() / "vix_sync_bench"};
+  };
+
+  struct Result
+  {
+    std::string name;
+    std::vector<std::pair<std::string, std::uint64_t>> params;
+    std::uint64_t iterations{0};
+    double total_ms{0.0};
+  };
+
+  std::vector<Result> g_results;
+
+  void record(
+      std::string name,
+      std::vector<std::pair<std::string, std::uint64_t>> params,
+      std::uint64_t iterations,
+      Clock::duration elapsed)
+  {
+    Result r;
+    r.name = std::move(name);
+    r.params = std::move(params);
+    r.iterations = iterations;
+    r.total_ms = std::chrono::duration<double, std::milli>(elapsed).count();
+
+    std::fprintf(stderr, "%-28s %10llu ops %12.1f ns/op\n",
+                 r.name.c_str(),
+                 static_cast<unsigned long long>(r.iterations),
+                 r.iterations ? r.total_ms * 1e6 / static_cast<double>(r.iterations) : 0.0);
+    g_results.push_back(std::move(r));
+  }
+
+  std::string results_json()
+  {
+    std::ostringstream out;
+    out << "{\"benchmarks\":[";
+    for (std::size_t i = 0; i < g_results.size(); ++i)
+    {
+      const auto &r = g_results[i];
+      const double ns_per_op = r.iterations ? r.total_ms * 1e6 / static_cast<double>(r.iterations) : 0.0;
+      const double ops_per_sec = r.total_ms > 0.0 ? static_cast<double>(r.iterations) * 1000.0 / r.total_ms : 0.0;
+
+      out << (i ? "," : "") << "\n  {\"name\":\"" << r.name << "\",\"params\":{";
+      for (std::size_t k = 0; k < r.params.size(); ++k)
+        out << (k ? "," : "") << "\"" << r.params[k].first << "\":" << r.params[k].second;
+      out << "},\"iterations\":" << r.iterations
+          << ",\"total_ms\":" << r.total_ms
+          << ",\"ns_per_op\":" << ns_per_op
+          << ",\"ops_per_sec\":" << ops_per_sec << "}";
+    }
+    out << "\n]}\n";
+    return out.str();
+  }
+
+  void reset_dir(const std::filesystem::path &dir)
+  {
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    std::filesystem::create_directories(dir, ec);
+  }
+
+  Operation make_op(std::size_t i, const std::string &payload)
+  {
+    Operation op;
+    op.kind = "http.post";
+    op.target = "/api/items/" + std::to_string(i % 16);
+    op.payload = payload;
+    return op;
+  }
+
+  std::shared_ptr<FileOutboxStore> make_store(const std::filesystem::path &file)
+  {
+    FileOutboxStore::Config cfg;
+    cfg.file_path = file;
+    cfg.pretty_json = false;
+    return std::make_shared<FileOutboxStore>(cfg);
+  }
+
+  void bench_outbox(const Options &opt)
+  {
+    const auto dir = opt.dir / "outbox";
+    reset_dir(dir);
+
+    auto store = make_store(dir / "outbox.json");
+    Outbox outbox(Outbox::Config{.owner = "bench"}, store);
+
+    const std::string payload(opt.payload_bytes, 'p');
+    const std::vector<std::pair<std::string, std::uint64_t>> params = {
+        {"ops", opt.ops}, {"payload_bytes", opt.payload_bytes}};
+
+    std::vector<std::string> ids;
+    ids.reserve(opt.ops);
+
+    auto t0 = Clock::now();
+    for (std::size_t i = 0; i < opt.ops; ++i)
+      ids.push_back(outbox.enqueue(make_op(i, payload), 1'000));
+    record("outbox.enqueue", params, opt.ops, Clock::now() - t0);
+
+    const std::size_t peeks = std::max<std::size_t>(opt.ops / 10, 1);
+    std::size_t seen = 0;
+    t0 = Clock::now();
+    for (std::size_t i = 0; i < peeks; ++i)
+      seen += outbox.peek_ready(2'000, 50).size();
+    record("outbox.peek_ready", {{"ops", opt.ops}, {"limit", 50}}, peeks, Clock::now() - t0);
+    if (seen == 0)
+      std::fprintf(stderr, "outbox.peek_ready: no ready operation\n");
+
+    t0 = Clock::now();
+    for (const auto &id : ids)
+      outbox.claim(id, 2'000);
+    record("outbox.claim", params, ids.size(), Clock::now() - t0);
+
+    t0 = Clock::now();
+    for (const auto &id : ids)
+      outbox.complete(id, 3'000);
+    record("outbox.complete", params, ids.size(), Clock::now() - t0);
+  }
+
+  // Writes a store file with n pending operations, in the format written
+  // by FileOutboxStore, without going through n full rewrites.
+  void write_store_file(const std::filesystem::path &file, std::size_t n, std::size_t payload_bytes)
+  {
+    std::ofstream out(file, std::ios::trunc);
+    const std::string payload(payload_bytes, 'p');
+
+    out << "{\"version\":1,\"ops\":{";
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      char id[32];
+      std::snprintf(id, sizeof(id), "op_%010zu", i);
+      out << (i ? "," : "") << "\"" << id << "\":{"
+          << "\"id\":\"" << id << "\","
+          << "\"kind\":\"http.post\","
+          << "\"target\":\"/api/items/" << (i % 16) << "\","
+          << "\"payload\":\"" << payload << "\","
+          << "\"idempotency_key\":\"idem_" << id << "\","
+          << "\"created_at_ms\":1000,\"updated_at_ms\":1000,\"attempt\":0,"
+          << "\"next_retry_at_ms\":1000,\"status\":0,\"last_error\":\"\","
+          << "\"priority\":0,\"coalesce_key\":\"\",\"deadline_at_ms\":0}";
+    }
+    out << "},\"owners\":{},\"idempotency\":{}}";
+  }
+
+  void bench_store_load(const Options &opt)
+  {
+    const auto dir = opt.dir / "load";
+    reset_dir(dir);
+
+    for (const auto n : opt.load_sizes)
+    {
+      const auto file = dir / ("outbox_" + std::to_string(n) + ".json");
+      write_store_file(file, n, opt.payload_bytes);
+
+      auto t0 = Clock::now();
+      auto store = make_store(file);
+      const auto depth = store->depth();
+      const auto elapsed = Clock::now() - t0;
+
+      if (depth.ops != n)
+        std::fprintf(stderr, "store.load: expected %zu ops, loaded %zu\n", n, depth.ops);
+
+      record("store.load",
+             {{"ops", n},
+              {"payload_bytes", opt.payload_bytes},
+              {"file_bytes", std::filesystem::file_size(file)}},
+             n, elapsed);
+
+      std::filesystem::remove(file);
+    }
+  }
+
+  void bench_wal(const Options &opt)
+  {
+    const auto dir = opt.dir / "wal";
+    reset_dir(dir);
+
+    wal::WalRecord rec;
+    rec.id = "op_0000000000";
+    rec.type = wal::RecordType::PutOperation;
+    rec.payload.assign(opt.payload_bytes, 'p');
+
+    for (const bool fsync : {false, true})
+    {
+      const auto file = dir / (fsync ? "wal_fsync.log" : "wal.log");
+      const std::size_t n = fsync ? opt.fsync_ops : opt.ops * 10;
+
+      wal::WalWriter w({file, fsync});
+      auto t0 = Clock::now();
+      for (std::size_t i = 0; i < n; ++i)
+        w.append(rec);
+      record(fsync ? "wal.append_fsync" : "wal.append",
+             {{"records", n}, {"payload_bytes", opt.payload_bytes}},
+             n, Clock::now() - t0);
+    }
+
+    const auto file = dir / "wal.log";
+    wal::Wal::Config cfg;
+    cfg.file_path = file;
+    wal::Wal log(cfg);
+
+    std::size_t n = 0;
+    auto t0 = Clock::now();
+    log.replay(0, [&](const wal::WalRecord &)
+               { ++n; });
+    record("wal.replay",
+           {{"records", n}, {"payload_bytes", opt.payload_bytes}, {"file_bytes", std::filesystem::file_size(file)}},
+           n, Clock::now() - t0);
+  }
+
+  std::vector<std::size_t> parse_sizes(const std::string &s)
+  {
+    std::vector<std::size_t> out;
+    std::stringstream in(s);
+    std::string item;
+    while (std::getline(in, item, ','))
+    {
+      if (!item.empty())
+        out.push_back(std::stoul(item));
+    }
+    return out;
+  }
+
+  bool parse_args(int argc, char **argv, Options &opt)
+  {
+    for (int i = 1; i < argc; ++i)
+    {
+      const std::string arg = argv[i];
+      auto value = [&]() -> std::string
+      {
+        if (i + 1 >= argc)
+          throw std::invalid_argument("missing value for " + arg);
+        return argv[++i];
+      };
+
+      if (arg == "--ops")
+        opt.ops = std::stoul(value());
+      else if (arg == "--load-sizes")
+        opt.load_sizes = parse_sizes(value());
+      else if (arg == "--fsync-ops")
+        opt.fsync_ops = std::stoul(value());
+      else if (arg == "--payload-bytes")
+        opt.payload_bytes = std::stoul(value());
+      else if (arg == "--filter")
+        opt.filter = value();
+      else if (arg == "--out")
+        opt.out = value();
+      else if (arg == "--dir")
+        opt.dir = value();
+      else
+        return false;
+    }
+    return true;
+  }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  Options opt;
+  try
+  {
+    if (!parse_args(argc, argv, opt))
+    {
+      std::fprintf(stderr,
+                   "usage: %s [--ops N] [--load-sizes N,N,...] [--fsync-ops N]\n"
+                   "          [--payload-bytes N] [--filter SUBSTR] [--out FILE] [--dir DIR]\n",
+                   argv[0]);
+      return 2;
+    }
+  }
+  catch (const std::exception &e)
+  {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 2;
+  }
+
+  const std::vector<std::pair<std::string, std::function<void(const Options &)>>> suites = {
+      {"outbox", bench_outbox},
+      {"store", bench_store_load},
+      {"wal", bench_wal},
+  };
+
+  for (const auto &[name, run] : suites)
+  {
+    if (opt.filter.empty() || name.find(opt.filter) != std::string::npos)
+      run(opt);
+  }
+
+  std::error_code ec;
+  std::filesystem::remove_all(opt.dir, ec);
+
+  const auto json = results_json();
+  if (opt.out.empty())
+  {
+    std::cout << json;
+  }
+  else
+  {
+    std::ofstream out(opt.out, std::ios::trunc);
+    out << json;
+  }
+  return 0;
+}
@@ -0,0 +1,183 @@
+/**
+ *
+ *  @file sync_sim.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "sim/Simulation.hpp"
+
+// Usage:
+//   vix_sync_sim [--ops N] [--rate OPS_PER_SEC] [--seed N] [--payload-bytes N]
+//                [--workers N] [--batch-limit N] [--send-batch N]
+//                [--idle-sleep-ms N] [--max-attempts N] [--base-delay-ms N]
+//                [--target SPEC]... [--out FILE]
+//
+// A target SPEC is a name followed by optional key=value settings:
+//   /api/a:latency=20,jitter=10,per_op=0.5,error=0.01,permanent=0.001,
+//          weight=2,outage=60000-90000,outage_every=300000,outage_for=20000
+//
+// The report (throughput, outcome counts, end-to-end latency percentiles
+// and the queue-depth curve) is written as JSON to stdout or FILE.
+
+using namespace vix::sync;
+
+namespace
+{
+  sim::TargetModel parse_target(const std::string &spec)
+  {
+    sim::TargetModel t;
+    const auto colon = spec.find(':');
+    t.target = spec.substr(0, colon);
+    if (colon == std::string::npos)
+      return t;
+
+    std::stringstream in(spec.substr(colon + 1));
+    std::string kv;
+    while (std::getline(in, kv, ','))
+    {
+      const auto eq = kv.find('=');
+      if (eq == std::string::npos)
+        throw std::invalid_argument("bad target setting: " + kv);
+
+      const auto key = kv.substr(0, eq);
+      const auto value = kv.substr(eq + 1);
+
+      if (key == "latency")
+        t.latency_ms = std::stod(value);
+      else if (key == "jitter")
+        t.jitter_ms = std::stod(value);
+      else if (key == "per_op")
+        t.per_op_ms = std::stod(value);
+      else if (key == "error")
+        t.error_rate = std::stod(value);
+      else if (key == "permanent")
+        t.permanent_error_rate = std::stod(value);
+      else if (key == "weight")
+        t.weight = std::stod(value);
+      else if (key == "outage")
+      {
+        const auto dash = value.find('-');
+        if (dash == std::string::npos)
+          throw std::invalid_argument("outage expects START-END: " + value);
+        t.outages.push_back({std::stoll(value.substr(0, dash)), std::stoll(value.substr(dash + 1))});
+      }
+      else if (key == "outage_every")
+        t.outage_every_ms = std::stoll(value);
+      else if (key == "outage_for")
+        t.outage_duration_ms = std::stoll(value);
+      else
+        throw std::invalid_argument("unknown target setting: " + key);
+    }
+    return t;
+  }
+
+  bool parse_args(int argc, char **argv, sim::Scenario &sc, std::string &out)
+  {
+    bool custom_targets = false;
+    for (int i = 1; i < argc; ++i)
+    {
+      const std::string arg = argv[i];
+      auto value = [&]() -> std::string
+      {
+        if (i + 1 >= argc)
+          throw std::invalid_argument("missing value for " + arg);
+        return argv[++i];
+      };
+
+      if (arg == "--ops")
+        sc.ops = std::stoul(value());
+      else if (arg == "--rate")
+        sc.arrival_rate_per_sec = std::stod(value());
+      else if (arg == "--seed")
+        sc.seed = std::stoull(value());
+      else if (arg == "--payload-bytes")
+        sc.payload_bytes = std::stoul(value());
+      else if (arg == "--workers")
+        sc.engine.worker_count = std::stoul(value());
+      else if (arg == "--batch-limit")
+        sc.engine.batch_limit = std::stoul(value());
+      else if (arg == "--send-batch")
+        sc.engine.send_batch_max_ops = std::stoul(value());
+      else if (arg == "--idle-sleep-ms")
+        sc.engine.idle_sleep_ms = std::stoll(value());
+      else if (arg == "--max-attempts")
+        sc.outbox.retry.max_attempts = static_cast<std::uint32_t>(std::stoul(value()));
+      else if (arg == "--base-delay-ms")
+        sc.outbox.retry.base_delay_ms = std::stoll(value());
+      else if (arg == "--target")
+      {
+        if (!custom_targets)
+          sc.targets.clear();
+        custom_targets = true;
+        sc.targets.push_back(parse_target(value()));
+      }
+      else if (arg == "--out")
+        out = value();
+      else
+        return false;
+    }
+    return true;
+  }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  sim::Scenario sc;
+  sc.outbox.owner = "sim";
+  std::string out;
+
+  try
+  {
+    if (!parse_args(argc, argv, sc, out))
+    {
+      std::fprintf(stderr,
+                   "usage: %s [--ops N] [--rate OPS_PER_SEC] [--seed N] [--payload-bytes N]\n"
+                   "          [--workers N] [--batch-limit N] [--send-batch N] [--idle-sleep-ms N]\n"
+                   "          [--max-attempts N] [--base-delay-ms N] [--target SPEC]... [--out FILE]\n",
+                   argv[0]);
+      return 2;
+    }
+  }
+  catch (const std::exception &e)
+  {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 2;
+  }
+
+  const auto report = sim::Simulator(sc).run();
+
+  std::fprintf(stderr, "%zu ops in %.1f s simulated (%.0f ms wall): %.0f ops/s, %zu completed, %zu failed\n",
+               report.enqueued,
+               static_cast<double>(report.sim_ms) / 1000.0,
+               report.wall_ms,
+               report.throughput_per_sec,
+               report.completed,
+               report.failed);
+
+  const auto json = report.to_json() + "\n";
+  if (out.empty())
+  {
+    std::cout << json;
+  }
+  else
+  {
+    std::ofstream f(out, std::ios::trunc);
+    f << json;
+  }
+  return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ *
+ *  @file Clock.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_CLOCK_HPP
+#define VIX_SYNC_CLOCK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace vix::sync
+{
+  /**
+   * @brief Source of the millisecond timestamps used by the sync module.
+   *
+   * Every time value handed to the outbox, stores and engine (now_ms,
+   * next_retry_at_ms, deadlines...) comes from one Clock, so timestamps
+   * that are persisted and those computed later stay comparable.
+   *
+   * @note Implementations are thread-safe.
+   */
+  class Clock
+  {
+  public:
+    /**
+     * @brief Virtual destructor.
+     */
+    virtual ~Clock() = default;
+
+    /**
+     * @brief Current time in milliseconds.
+     */
+    virtual std::int64_t now_ms() const noexcept = 0;
+  };
+
+  /**
+   * @brief Cheap monotonic clock (CLOCK_MONOTONIC_COARSE where available).
+   *
+   * Reading it costs a few nanoseconds (vDSO, no timer access) at the price
+   * of a resolution of a few milliseconds. Its epoch is arbitrary and resets
+   * on reboot, so its values must not be persisted.
+   */
+  class MonotonicClock final : public Clock
+  {
+  public:
+    std::int64_t now_ms() const noexcept override;
+  };
+
+  /**
+   * @brief Monotonic clock anchored to Unix time (default clock).
+   *
+   * Reads the system clock once at construction, then advances with the
+   * coarse monotonic clock: values are Unix milliseconds, so they can be
+   * persisted and compared across restarts, yet never jump backwards when
+   * the system time is adjusted while the process runs.
+   */
+  class WallClock final : public Clock
+  {
+  public:
+    /**
+     * @brief Anchor the clock to the current system time.
+     */
+    WallClock();
+
+    std::int64_t now_ms() const noexcept override;
+
+  private:
+    /**
+     * @brief Unix time at construction.
+     */
+    std::int64_t wall_anchor_ms_{0};
+
+    /**
+     * @brief Monotonic time at construction.
+     */
+    std::int64_t mono_anchor_ms_{0};
+
+    /**
+     * @brief Monotonic source.
+     */
+    MonotonicClock mono_;
+  };
+
+  /**
+   * @brief Manually driven clock for tests, benchmarks and simulations.
+   */
+  class VirtualClock final : public Clock
+  {
+  public:
+    /**
+     * @brief Start at the given time.
+     */
+    explicit VirtualClock(std::int64_t start_ms = 0) noexcept : now_(start_ms) {}
+
+    std::int64_t now_ms() const noexcept override { return now_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Jump to an absolute time.
+     */
+    void set_ms(std::int64_t t_ms) noexcept { now_.store(t_ms, std::memory_order_release); }
+
+    /**
+     * @brief Move forward by delta_ms and return the new time.
+     */
+    std::int64_t advance_ms(std::int64_t delta_ms) noexcept
+    {
+      return now_.fetch_add(delta_ms, std::memory_order_acq_rel) + delta_ms;
+    }
+
+  private:
+    std::atomic<std::int64_t> now_;
+  };
+
+  /**
+   * @brief Process-wide WallClock used when no clock is configured.
+   */
+  std::shared_ptr<Clock> default_clock();
+
+} // namespace vix::sync
+
+#endif // VIX_SYNC_CLOCK_HPP
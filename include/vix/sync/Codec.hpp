@@ -0,0 +1,138 @@
+/**
+ *
+ *  @file Codec.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_CODEC_HPP
+#define VIX_SYNC_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace vix::sync
+{
+  /**
+   * @brief Identifier of a payload compression codec.
+   *
+   * Values are persisted (WAL record flags, store files) and must never be
+   * renumbered.
+   */
+  enum class CodecId : std::uint8_t
+  {
+    /**
+     * @brief Bytes are stored as-is.
+     */
+    None = 0,
+
+    /**
+     * @brief In-tree LZ77 codec, always available.
+     */
+    Lz = 1,
+
+    /**
+     * @brief LZ4 block format (requires liblz4 at build time).
+     */
+    Lz4 = 2,
+
+    /**
+     * @brief Zstandard (requires libzstd at build time).
+     */
+    Zstd = 3
+  };
+
+  /**
+   * @brief Payload compression algorithm.
+   *
+   * Codecs are stateless and thread-safe. The uncompressed size is recorded
+   * by the caller next to the compressed bytes and handed back to
+   * decompress().
+   */
+  class Codec
+  {
+  public:
+    /**
+     * @brief Virtual destructor.
+     */
+    virtual ~Codec() = default;
+
+    /**
+     * @brief Persisted identifier of the codec.
+     */
+    virtual CodecId id() const noexcept = 0;
+
+    /**
+     * @brief Short name used in JSON files ("lz", "lz4", "zstd").
+     */
+    virtual std::string_view name() const noexcept = 0;
+
+    /**
+     * @brief Compress bytes.
+     */
+    virtual std::string compress(std::string_view bytes) const = 0;
+
+    /**
+     * @brief Decompress bytes produced by compress().
+     *
+     * @param bytes Compressed bytes.
+     * @param raw_size Size of the original bytes.
+     * @throws std::runtime_error on corrupted input.
+     */
+    virtual std::string decompress(std::string_view bytes, std::size_t raw_size) const = 0;
+  };
+
+  /**
+   * @brief Codec built into this library, or null if not available.
+   */
+  std::shared_ptr<const Codec> find_codec(CodecId id) noexcept;
+
+  /**
+   * @brief Codec by name, or null if unknown or not available.
+   */
+  std::shared_ptr<const Codec> find_codec(std::string_view name) noexcept;
+
+  /**
+   * @brief When and how payloads are compressed.
+   */
+  struct Compression
+  {
+    /**
+     * @brief Codec to use. None disables compression.
+     */
+    CodecId codec{CodecId::None};
+
+    /**
+     * @brief Payloads smaller than this are never compressed.
+     */
+    std::size_t min_bytes{256};
+
+    /**
+     * @brief Keep the compressed form only below this fraction of the original.
+     */
+    double max_ratio{0.9};
+  };
+
+  /**
+   * @brief Compress bytes according to cfg when it pays off.
+   *
+   * @return Compressed bytes, or nullopt to store the bytes as-is (disabled,
+   * too small, codec unavailable, or not compressible enough).
+   */
+  std::optional<std::string> compress_payload(const Compression &cfg, std::string_view bytes);
+
+} // namespace vix::sync
+
+#endif // VIX_SYNC_CODEC_HPP
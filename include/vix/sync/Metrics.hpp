@@ -0,0 +1,566 @@
+/**
+ *
+ *  @file Metrics.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_METRICS_HPP
+#define VIX_SYNC_METRICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace vix::sync
+{
+  namespace detail
+  {
+    /**
+     * @brief Number of shards of counters and histograms (power of two).
+     */
+    inline constexpr std::size_t kMetricShards = 8;
+
+    /**
+     * @brief Shard owned by the calling thread.
+     *
+     * Threads are assigned shards round-robin on first use, so up to
+     * kMetricShards threads update metrics without sharing a cache line.
+     */
+    std::size_t metric_shard() noexcept;
+  } // namespace detail
+
+  /**
+   * @brief Monotonically increasing counter.
+   *
+   * Increments go to a per-thread shard with a relaxed atomic add; value()
+   * sums the shards.
+   *
+   * @note Thread-safe.
+   */
+  class Counter
+  {
+  public:
+    /**
+     * @brief Add n to the counter.
+     */
+    void add(std::uint64_t n = 1) noexcept
+    {
+      shards_[detail::metric_shard()].v.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Current value (sum of the shards).
+     */
+    std::uint64_t value() const noexcept;
+
+  private:
+    struct alignas(64) Shard
+    {
+      std::atomic<std::uint64_t> v{0};
+    };
+
+    Shard shards_[detail::kMetricShards];
+  };
+
+  /**
+   * @brief Value that can go up and down (queue depth, sizes).
+   *
+   * @note Thread-safe.
+   */
+  class Gauge
+  {
+  public:
+    /**
+     * @brief Set the gauge.
+     */
+    void set(std::int64_t v) noexcept { v_.store(v, std::memory_order_relaxed); }
+
+    /**
+     * @brief Add d (may be negative) to the gauge.
+     */
+    void add(std::int64_t d) noexcept { v_.fetch_add(d, std::memory_order_relaxed); }
+
+    /**
+     * @brief Current value.
+     */
+    std::int64_t value() const noexcept { return v_.load(std::memory_order_relaxed); }
+
+  private:
+    std::atomic<std::int64_t> v_{0};
+  };
+
+  /**
+   * @brief Gauge split by the value of one label (per target, per priority).
+   *
+   * The whole set of series is replaced on each update, so label values
+   * that disappear (an evicted target, a drained priority) stop being
+   * exported.
+   *
+   * @note Thread-safe.
+   */
+  class GaugeVec
+  {
+  public:
+    /**
+     * @brief Label value and gauge value of each series.
+     */
+    using Series = std::vector<std::pair<std::string, double>>;
+
+    /**
+     * @brief Replace every series.
+     */
+    void set_all(Series series);
+
+    /**
+     * @brief Copy of the current series, in the order they were set.
+     */
+    Series values() const;
+
+  private:
+    mutable std::mutex mu_;
+    Series series_;
+  };
+
+  /**
+   * @brief Point-in-time copy of a Histogram.
+   */
+  struct HistogramSnapshot
+  {
+    /**
+     * @brief Number of recorded values.
+     */
+    std::uint64_t count{0};
+
+    /**
+     * @brief Sum of recorded values.
+     */
+    std::uint64_t sum{0};
+
+    /**
+     * @brief Largest recorded value.
+     */
+    std::uint64_t max{0};
+
+    /**
+     * @brief Count per bucket, indexed like Histogram::bucket_index().
+     */
+    std::vector<std::uint64_t> buckets;
+
+    /**
+     * @brief Mean of recorded values (0 when empty).
+     */
+    double mean() const noexcept;
+
+    /**
+     * @brief Value at quantile q in [0, 1].
+     *
+     * Returns the highest value of the bucket holding the quantile, capped
+     * at max, so the result overestimates by at most one bucket width.
+     */
+    std::uint64_t percentile(double q) const noexcept;
+
+    /**
+     * @brief Number of recorded values lower than or equal to v.
+     *
+     * Exact when v + 1 is a bucket boundary (e.g. a power of two minus one).
+     */
+    std::uint64_t count_at_or_below(std::uint64_t v) const noexcept;
+  };
+
+  /**
+   * @brief Log-linear (HDR-style) histogram of non-negative integers.
+   *
+   * Values below 8 get their own bucket; above that, every power of two is
+   * split into 8 linear sub-buckets, bounding the relative error to 12.5%
+   * over the whole range with a fixed, small bucket array. Values of 2^48
+   * and above are counted in the last bucket.
+   *
+   * Latency histograms record nanoseconds (see ScopedTimer).
+   *
+   * @note Thread-safe. Recording is wait-free apart from a rare max update.
+   */
+  class Histogram
+  {
+  public:
+    /**
+     * @brief Linear sub-buckets per power of two, as a power of two.
+     */
+    static constexpr unsigned kSubBits = 3;
+
+    /**
+     * @brief Values at or above 2^kMaxBits share the last bucket.
+     */
+    static constexpr unsigned kMaxBits = 48;
+
+    /**
+     * @brief Number of buckets.
+     */
+    static constexpr std::size_t kBuckets = (kMaxBits - kSubBits + 1) << kSubBits;
+
+    /**
+     * @brief Construct an empty histogram.
+     */
+    Histogram();
+
+    Histogram(const Histogram &) = delete;
+    Histogram &operator=(const Histogram &) = delete;
+
+    /**
+     * @brief Record one value.
+     */
+    void record(std::uint64_t v) noexcept;
+
+    /**
+     * @brief Copy the current state.
+     */
+    HistogramSnapshot snapshot() const;
+
+    /**
+     * @brief Bucket holding v.
+     */
+    static std::size_t bucket_index(std::uint64_t v) noexcept;
+
+    /**
+     * @brief Smallest value of bucket i.
+     */
+    static std::uint64_t bucket_lower(std::size_t i) noexcept;
+
+    /**
+     * @brief First value past bucket i.
+     */
+    static std::uint64_t bucket_upper(std::size_t i) noexcept;
+
+  private:
+    struct alignas(64) Shard
+    {
+      std::atomic<std::uint64_t> sum{0};
+      std::atomic<std::uint64_t> max{0};
+      std::atomic<std::uint64_t> buckets[kBuckets];
+    };
+
+    std::unique_ptr<Shard[]> shards_;
+  };
+
+  /**
+   * @brief Records the time elapsed in its scope into a latency histogram.
+   *
+   * A null histogram makes the timer free: the clock is not read.
+   */
+  class ScopedTimer
+  {
+  public:
+    explicit ScopedTimer(Histogram *h) noexcept
+        : h_(h)
+    {
+      if (h_)
+        start_ = std::chrono::steady_clock::now();
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    ~ScopedTimer()
+    {
+      if (h_)
+      {
+        const auto d = std::chrono::steady_clock::now() - start_;
+        h_->record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()));
+      }
+    }
+
+  private:
+    Histogram *h_;
+    std::chrono::steady_clock::time_point start_{};
+  };
+
+  /**
+   * @brief Copy of every metric of a registry.
+   */
+  struct MetricsSnapshot
+  {
+    struct CounterValue
+    {
+      std::string name;
+      std::string help;
+      std::uint64_t value{0};
+    };
+
+    struct GaugeValue
+    {
+      std::string name;
+      std::string help;
+      std::int64_t value{0};
+    };
+
+    struct GaugeVecValue
+    {
+      std::string name;
+      std::string help;
+      std::string label;
+      GaugeVec::Series series;
+    };
+
+    struct HistogramValue
+    {
+      std::string name;
+      std::string help;
+
+      /**
+       * @brief Factor converting recorded values to exported units.
+       */
+      double scale{1.0};
+
+      HistogramSnapshot data;
+    };
+
+    /**
+     * @brief Counters, sorted by name.
+     */
+    std::vector<CounterValue> counters;
+
+    /**
+     * @brief Gauges, sorted by name.
+     */
+    std::vector<GaugeValue> gauges;
+
+    /**
+     * @brief Labeled gauges, sorted by name.
+     */
+    std::vector<GaugeVecValue> gauge_vecs;
+
+    /**
+     * @brief Histograms, sorted by name.
+     */
+    std::vector<HistogramValue> histograms;
+
+    /**
+     * @brief Value of a counter (0 if absent).
+     */
+    std::uint64_t counter(std::string_view name) const noexcept;
+
+    /**
+     * @brief Value of a gauge (0 if absent).
+     */
+    std::int64_t gauge(std::string_view name) const noexcept;
+
+    /**
+     * @brief Series of a labeled gauge (null if absent).
+     */
+    const GaugeVec::Series *gauge_vec(std::string_view name) const noexcept;
+
+    /**
+     * @brief Histogram by name (null if absent).
+     */
+    const HistogramSnapshot *histogram(std::string_view name) const noexcept;
+
+    /**
+     * @brief Render in the Prometheus text exposition format (0.0.4).
+     *
+     * Histograms are exported with a fixed cumulative bucket per power of
+     * two (le = 2^k - 1, converted with their scale), plus _sum and _count.
+     */
+    std::string to_prometheus() const;
+  };
+
+  /**
+   * @brief Named set of counters, gauges and histograms.
+   *
+   * Metrics are created on first lookup and live as long as the registry;
+   * returned references stay valid. Lookups take a mutex, so callers keep
+   * the references rather than looking metrics up on hot paths.
+   *
+   * Names must match the Prometheus syntax [a-zA-Z_:][a-zA-Z0-9_:]*.
+   *
+   * @note Thread-safe.
+   */
+  class MetricsRegistry
+  {
+  public:
+    /**
+     * @brief Get or create a counter.
+     *
+     * @throws std::invalid_argument for an invalid name, or a name already
+     * used by a metric of another type.
+     */
+    Counter &counter(const std::string &name, std::string help = {});
+
+    /**
+     * @brief Get or create a gauge.
+     *
+     * @throws std::invalid_argument as counter().
+     */
+    Gauge &gauge(const std::string &name, std::string help = {});
+
+    /**
+     * @brief Get or create a gauge with one label.
+     *
+     * @param label Label name, e.g. "target".
+     * @throws std::invalid_argument as counter(), or for an invalid label
+     * name.
+     */
+    GaugeVec &gauge_vec(const std::string &name, const std::string &label, std::string help = {});
+
+    /**
+     * @brief Get or create a histogram.
+     *
+     * @param scale Factor converting recorded values to exported units
+     * (1e-9 for nanoseconds exported as seconds).
+     * @throws std::invalid_argument as counter().
+     */
+    Histogram &histogram(const std::string &name, std::string help = {}, double scale = 1.0);
+
+    /**
+     * @brief Copy every metric.
+     */
+    MetricsSnapshot snapshot() const;
+
+    /**
+     * @brief Prometheus text exposition of a fresh snapshot.
+     */
+    std::string to_prometheus() const;
+
+    /**
+     * @brief Write the Prometheus exposition to path.
+     *
+     * The text goes to a temporary file renamed over path, so a scraper
+     * (e.g. node_exporter's textfile collector) never reads a partial file.
+     *
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void write_prometheus(const std::filesystem::path &path) const;
+
+  private:
+    enum class Type : std::uint8_t
+    {
+      Counter = 0,
+      Gauge,
+      GaugeVec,
+      Histogram
+    };
+
+    struct Entry
+    {
+      Type type{Type::Counter};
+      std::string help;
+      std::string label;
+      double scale{1.0};
+      std::unique_ptr<Counter> counter;
+      std::unique_ptr<Gauge> gauge;
+      std::unique_ptr<GaugeVec> gauge_vec;
+      std::unique_ptr<Histogram> histogram;
+    };
+
+    /**
+     * @brief Get or create the entry of name (mu_ must be held).
+     */
+    Entry &entry_(const std::string &name, Type type, std::string help);
+
+    mutable std::mutex mu_;
+    std::map<std::string, Entry, std::less<>> entries_;
+
+    /**
+     * @brief Serializes write_prometheus(), which reuses one temporary file.
+     */
+    mutable std::mutex write_mu_;
+  };
+
+  /**
+   * @brief Standard metrics of the sync pipeline.
+   *
+   * One instance is shared by the Outbox (enqueue, claim, complete, fail),
+   * the workers (send, requeue, queue depth) and optionally the store
+   * (persistence). Latencies are histograms in nanoseconds, exported in
+   * seconds. Set it in Outbox::Config::metrics and
+   * FileOutboxStore::Config::metrics.
+   */
+  class SyncMetrics
+  {
+  public:
+    /**
+     * @brief Register the sync metrics in registry (a new one if null).
+     */
+    explicit SyncMetrics(std::shared_ptr<MetricsRegistry> registry = nullptr);
+
+    SyncMetrics(const SyncMetrics &) = delete;
+    SyncMetrics &operator=(const SyncMetrics &) = delete;
+
+    /**
+     * @brief Registry holding the metrics.
+     */
+    const std::shared_ptr<MetricsRegistry> &registry() const noexcept { return registry_; }
+
+    /**
+     * @brief Copy every metric of the registry.
+     */
+    MetricsSnapshot snapshot() const { return registry_->snapshot(); }
+
+    /**
+     * @brief Prometheus text exposition of the registry.
+     */
+    std::string to_prometheus() const { return registry_->to_prometheus(); }
+
+    /**
+     * @brief Write the Prometheus exposition of the registry to path.
+     */
+    void write_prometheus(const std::filesystem::path &path) const { registry_->write_prometheus(path); }
+
+  private:
+    std::shared_ptr<MetricsRegistry> registry_;
+
+  public:
+    Counter &enqueued;
+    Counter &enqueue_duplicates;
+    Histogram &enqueue_latency;
+
+    Counter &claimed;
+    Counter &claims_lost;
+    Histogram &claim_latency;
+
+    Counter &sent;
+    Counter &send_batches;
+    Histogram &send_latency;
+
+    Counter &completed;
+    Histogram &complete_latency;
+
+    Counter &failed;
+    Counter &failed_permanent;
+    Histogram &fail_latency;
+
+    Counter &requeued;
+    Counter &expired;
+
+    Gauge &queue_depth;
+    Gauge &queue_bytes;
+    GaugeVec &queue_depth_by_priority;
+
+    GaugeVec &concurrency_limit;
+
+    Counter &store_flushes;
+    Counter &store_flush_bytes;
+    Counter &store_ops_encoded;
+    Histogram &store_flush_latency;
+  };
+
+} // namespace vix::sync
+
+#endif // VIX_SYNC_METRICS_HPP
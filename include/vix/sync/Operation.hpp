@@ -21,6 +21,8 @@
 #include <string_view>
 #include <utility>
 
+#include <vix/sync/Payload.hpp>
+
 namespace vix::sync
 {
   /**
@@ -54,7 +56,12 @@ namespace vix::sync
     /**
      * @brief Operation failed permanently and will not be retried.
      */
-    PermanentFailed
+    PermanentFailed,
+
+    /**
+     * @brief Operation missed its deadline and will not be delivered.
+     */
+    Expired
   };
 
   /**
@@ -91,8 +98,10 @@ namespace vix::sync
 
     /**
      * @brief Opaque payload associated with the operation.
+     *
+     * Shared and immutable: copies of an Operation reference the same bytes.
      */
-    std::string payload;
+    Payload payload;
 
     /**
      * @brief Idempotency key used to deduplicate retries.
@@ -129,6 +138,31 @@ namespace vix::sync
      */
     std::string last_error;
 
+    /**
+     * @brief Dispatch priority.
+     *
+     * Higher values are dispatched first. Operations with the same priority
+     * are dispatched in creation order.
+     */
+    std::int32_t priority{0};
+
+    /**
+     * @brief Key identifying operations that supersede each other.
+     *
+     * When coalescing is enabled in the Outbox, a newer operation replaces
+     * older pending ones sharing the same key. Left empty, the Outbox may
+     * derive it from kind and target.
+     */
+    std::string coalesce_key;
+
+    /**
+     * @brief Time after which the operation is worthless, in milliseconds.
+     *
+     * 0 means no deadline. Expired operations are never sent and are moved
+     * to OperationStatus::Expired by the outbox expiry sweep.
+     */
+    std::int64_t deadline_at_ms{0};
+
     /**
      * @brief Check whether the operation is completed.
      */
@@ -144,6 +178,16 @@ namespace vix::sync
      */
     bool is_failed() const noexcept { return status == OperationStatus::Failed; }
 
+    /**
+     * @brief Check whether the operation deadline has passed.
+     *
+     * @param now_ms Current time in milliseconds.
+     */
+    bool is_expired(std::int64_t now_ms) const noexcept
+    {
+      return deadline_at_ms > 0 && now_ms >= deadline_at_ms;
+    }
+
     /**
      * @brief Mark the operation as failed.
      *
@@ -0,0 +1,91 @@
+/**
+ *
+ *  @file OperationId.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_OPERATION_ID_HPP
+#define VIX_SYNC_OPERATION_ID_HPP
+
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace vix::sync
+{
+  /**
+   * @brief 128-bit time-ordered identifier (ULID layout).
+   *
+   * The first 48 bits hold a Unix timestamp in milliseconds, the remaining
+   * 80 bits are random. Identifiers generated by one thread are strictly
+   * increasing: within the same millisecond the random part is incremented
+   * instead of redrawn.
+   *
+   * The binary form is 16 big-endian bytes, so byte order, string order and
+   * creation order agree. The text form is the canonical 26-character
+   * Crockford base32 encoding.
+   *
+   * Generation is lock-free: each thread owns its generator state.
+   */
+  struct OperationId
+  {
+    /**
+     * @brief Length of the text form.
+     */
+    static constexpr std::size_t text_size = 26;
+
+    /**
+     * @brief Big-endian binary representation.
+     */
+    std::array<std::uint8_t, 16> bytes{};
+
+    /**
+     * @brief Generate a new identifier using the system clock.
+     */
+    static OperationId generate();
+
+    /**
+     * @brief Generate a new identifier for an explicit Unix time.
+     *
+     * Time going backwards on the calling thread is clamped to the last
+     * timestamp used, so monotonicity is preserved.
+     *
+     * @param unix_ms Unix time in milliseconds.
+     */
+    static OperationId generate(std::int64_t unix_ms);
+
+    /**
+     * @brief Parse the 26-character text form (case-insensitive).
+     *
+     * @return The identifier, or nullopt if text is malformed.
+     */
+    static std::optional<OperationId> parse(std::string_view text) noexcept;
+
+    /**
+     * @brief Canonical 26-character text form.
+     */
+    std::string to_string() const;
+
+    /**
+     * @brief Unix time in milliseconds embedded in the identifier.
+     */
+    std::int64_t timestamp_ms() const noexcept;
+
+    friend auto operator<=>(const OperationId &, const OperationId &) = default;
+  };
+
+} // namespace vix::sync
+
+#endif // VIX_SYNC_OPERATION_ID_HPP
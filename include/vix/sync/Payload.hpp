@@ -0,0 +1,142 @@
+/**
+ *
+ *  @file Payload.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_PAYLOAD_HPP
+#define VIX_SYNC_PAYLOAD_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace vix::sync
+{
+  /**
+   * @brief Shared, immutable byte buffer carried by an Operation.
+   *
+   * Payload bytes are written once and then shared by reference: copying a
+   * Payload (and therefore an Operation) only bumps a reference count. This
+   * keeps large payloads from being copied by the store on put/get/list and
+   * along the peek, claim and send path.
+   *
+   * A Payload is a view over memory kept alive by an opaque owner, so the
+   * bytes may live in a std::string, a memory-mapped file, or any other
+   * buffer exposed through adopt().
+   *
+   * @note Immutable and therefore safe to share between threads.
+   */
+  class Payload
+  {
+  public:
+    /**
+     * @brief Empty payload.
+     */
+    Payload() noexcept = default;
+
+    /**
+     * @brief Take ownership of a string (no copy of its bytes).
+     */
+    Payload(std::string bytes)
+    {
+      if (bytes.empty())
+        return;
+      auto owned = std::make_shared<const std::string>(std::move(bytes));
+      view_ = *owned;
+      owner_ = std::move(owned);
+    }
+
+    /**
+     * @brief Copy a null-terminated string.
+     */
+    Payload(const char *bytes) : Payload(std::string(bytes ? bytes : "")) {}
+
+    /**
+     * @brief Copy the given bytes into a new buffer.
+     */
+    static Payload copy(std::string_view bytes) { return Payload(std::string(bytes)); }
+
+    /**
+     * @brief Wrap bytes kept alive by owner, without copying them.
+     *
+     * @param owner Object keeping the memory behind bytes valid.
+     * @param bytes View into memory owned by owner.
+     */
+    static Payload adopt(std::shared_ptr<const void> owner, std::string_view bytes) noexcept
+    {
+      Payload p;
+      p.owner_ = std::move(owner);
+      p.view_ = bytes;
+      return p;
+    }
+
+    /**
+     * @brief Read-only view of the bytes.
+     */
+    std::string_view view() const noexcept { return view_; }
+
+    /**
+     * @brief Implicit conversion to a read-only view.
+     */
+    operator std::string_view() const noexcept { return view_; }
+
+    /**
+     * @brief Pointer to the first byte.
+     */
+    const char *data() const noexcept { return view_.data(); }
+
+    /**
+     * @brief Number of bytes.
+     */
+    std::size_t size() const noexcept { return view_.size(); }
+
+    /**
+     * @brief Whether the payload holds no byte.
+     */
+    bool empty() const noexcept { return view_.empty(); }
+
+    /**
+     * @brief Copy of the bytes as a string.
+     */
+    std::string str() const { return std::string(view_); }
+
+    /**
+     * @brief Whether both payloads share the same underlying buffer.
+     */
+    bool shares_buffer_with(const Payload &other) const noexcept
+    {
+      return owner_ && owner_ == other.owner_;
+    }
+
+    friend bool operator==(const Payload &a, const Payload &b) noexcept { return a.view_ == b.view_; }
+    friend bool operator==(const Payload &a, std::string_view b) noexcept { return a.view_ == b; }
+    friend bool operator==(const Payload &a, const std::string &b) noexcept { return a.view_ == b; }
+    friend bool operator==(const Payload &a, const char *b) noexcept { return a.view_ == std::string_view(b ? b : ""); }
+
+  private:
+    /**
+     * @brief Keeps the memory behind view_ alive.
+     */
+    std::shared_ptr<const void> owner_;
+
+    /**
+     * @brief The payload bytes.
+     */
+    std::string_view view_;
+  };
+
+} // namespace vix::sync
+
+#endif // VIX_SYNC_PAYLOAD_HPP
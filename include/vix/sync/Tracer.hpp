@@ -0,0 +1,360 @@
+/**
+ *
+ *  @file Tracer.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_TRACER_HPP
+#define VIX_SYNC_TRACER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <vix/sync/Metrics.hpp>
+
+namespace vix::sync
+{
+  /**
+   * @brief Step of an operation's life recorded by a Tracer.
+   */
+  enum class TraceEvent : std::uint8_t
+  {
+    /**
+     * @brief Persisted by Outbox::enqueue().
+     */
+    Enqueue = 0,
+
+    /**
+     * @brief Seen ready by a worker, once per attempt.
+     */
+    Ready,
+
+    /**
+     * @brief Claimed by a worker.
+     */
+    Claim,
+
+    /**
+     * @brief Handed to the transport.
+     */
+    SendStart,
+
+    /**
+     * @brief Transport returned.
+     */
+    SendEnd,
+
+    /**
+     * @brief Marked done.
+     */
+    Complete,
+
+    /**
+     * @brief Failed, will be retried.
+     */
+    Fail,
+
+    /**
+     * @brief Failed permanently.
+     */
+    PermanentFail
+  };
+
+  /**
+   * @brief Stage between two lifecycle events.
+   */
+  enum class TraceStage : std::uint8_t
+  {
+    /**
+     * @brief Enqueue to first seen ready: time spent waiting in the queue.
+     */
+    Queue = 0,
+
+    /**
+     * @brief Failed attempt to seen ready again: retry backoff.
+     */
+    RetryWait,
+
+    /**
+     * @brief Seen ready to claimed: limiters, breakers and claim contention.
+     */
+    ClaimWait,
+
+    /**
+     * @brief Claimed to handed to the transport (batching).
+     */
+    Dispatch,
+
+    /**
+     * @brief Transport call.
+     */
+    Send,
+
+    /**
+     * @brief Transport returned to outcome persisted.
+     */
+    Settle,
+
+    /**
+     * @brief Enqueue to completion or permanent failure.
+     */
+    EndToEnd
+  };
+
+  /**
+   * @brief Number of TraceStage values.
+   */
+  inline constexpr std::size_t kTraceStages = 7;
+
+  /**
+   * @brief Name of a stage ("queue", "retry_wait", ...).
+   */
+  std::string_view to_string(TraceStage s) noexcept;
+
+  /**
+   * @brief Per-operation lifecycle tracer.
+   *
+   * Hooks in Outbox and SyncWorker report lifecycle events per operation id.
+   * The tracer turns consecutive events into stage durations, aggregated in
+   * log-linear histograms, so slow operations can be broken down into queue
+   * wait, retry backoff, claim wait, transport time and settling.
+   *
+   * Timestamps are steady-clock nanoseconds unless given explicitly. With
+   * keep_spans, every stage span is also kept (up to max_spans) for export in
+   * Chrome trace-event JSON (chrome://tracing, Perfetto).
+   *
+   * Set it in Outbox::Config::tracer; workers pick it up from the outbox.
+   *
+   * @note Thread-safe. Events go through a mutex: tracing is meant for
+   * investigations, metrics (SyncMetrics) for always-on monitoring.
+   */
+  class Tracer
+  {
+  public:
+    /**
+     * @brief Tracer configuration.
+     */
+    struct Config
+    {
+      /**
+       * @brief Maximum number of operations tracked at once.
+       *
+       * Operations that never finish (expired, pruned) are forgotten oldest
+       * first beyond this bound.
+       */
+      std::size_t max_tracked_ops{100'000};
+
+      /**
+       * @brief Keep individual spans for to_chrome_trace().
+       */
+      bool keep_spans{false};
+
+      /**
+       * @brief Maximum number of kept spans; later spans are dropped.
+       */
+      std::size_t max_spans{1'000'000};
+    };
+
+    /**
+     * @brief One stage of one operation.
+     */
+    struct Span
+    {
+      std::string op_id;
+      TraceStage stage{TraceStage::Queue};
+
+      /**
+       * @brief Attempt number (1-based) the span belongs to.
+       */
+      std::uint32_t attempt{1};
+      std::int64_t start_ns{0};
+      std::int64_t end_ns{0};
+    };
+
+    /**
+     * @brief Aggregated distributions.
+     */
+    struct Stats
+    {
+      /**
+       * @brief Stage durations in nanoseconds, indexed by TraceStage.
+       */
+      HistogramSnapshot stages[kTraceStages];
+
+      /**
+       * @brief Attempts per finished operation.
+       */
+      HistogramSnapshot attempts;
+
+      /**
+       * @brief Operations currently tracked.
+       */
+      std::size_t tracked{0};
+
+      /**
+       * @brief Operations forgotten because max_tracked_ops was reached.
+       */
+      std::uint64_t evicted{0};
+
+      /**
+       * @brief Spans not kept because max_spans was reached.
+       */
+      std::uint64_t dropped_spans{0};
+
+      /**
+       * @brief Distribution of a stage.
+       */
+      const HistogramSnapshot &stage(TraceStage s) const noexcept
+      {
+        return stages[static_cast<std::size_t>(s)];
+      }
+    };
+
+    /**
+     * @brief Construct a tracer with the default configuration.
+     */
+    Tracer();
+
+    /**
+     * @brief Construct a tracer.
+     */
+    explicit Tracer(Config cfg);
+
+    /**
+     * @brief Record an event for op_id now.
+     */
+    void record(std::string_view op_id, TraceEvent ev);
+
+    /**
+     * @brief Record an event for op_id at ts_ns (steady-clock nanoseconds).
+     */
+    void record(std::string_view op_id, TraceEvent ev, std::int64_t ts_ns);
+
+    /**
+     * @brief Snapshot of the stage distributions.
+     */
+    Stats stats() const;
+
+    /**
+     * @brief Copy of the kept spans.
+     */
+    std::vector<Span> spans() const;
+
+    /**
+     * @brief Kept spans as Chrome trace-event JSON.
+     *
+     * Each operation is an async track (id = op id) holding its stages.
+     */
+    std::string to_chrome_trace() const;
+
+    /**
+     * @brief Write to_chrome_trace() to path.
+     *
+     * The trace goes to a temporary file renamed over path, so a viewer
+     * never loads a truncated trace and a failed write keeps the previous
+     * one.
+     *
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void write_chrome_trace(const std::filesystem::path &path) const;
+
+    /**
+     * @brief Forget tracked operations, distributions and spans.
+     */
+    void reset();
+
+    /**
+     * @brief Access the tracer configuration.
+     */
+    const Config &config() const noexcept { return cfg_; }
+
+  private:
+    /**
+     * @brief Timestamps of one tracked operation.
+     */
+    struct OpState
+    {
+      std::int64_t enqueued_ns{-1};
+      std::int64_t ready_ns{-1};
+      std::int64_t claimed_ns{-1};
+      std::int64_t send_start_ns{-1};
+      std::int64_t send_end_ns{-1};
+      std::int64_t failed_ns{-1};
+      std::uint32_t attempt{0};
+    };
+
+    /**
+     * @brief Start tracking op_id, evicting the oldest ops if needed (mu_ held).
+     */
+    std::unordered_map<std::string, OpState>::iterator track_(std::string_view op_id);
+
+    /**
+     * @brief Record a stage duration and keep its span (mu_ held).
+     */
+    void stage_(const std::string &op_id, const OpState &s, TraceStage stage,
+                std::int64_t start_ns, std::int64_t end_ns);
+
+    /**
+     * @brief Record the end of an operation and forget it (mu_ held).
+     */
+    void finish_(std::unordered_map<std::string, OpState>::iterator it, std::int64_t ts_ns);
+
+  private:
+    Config cfg_;
+
+    mutable std::mutex mu_;
+
+    /**
+     * @brief Serializes write_chrome_trace(), which reuses one temporary file.
+     */
+    mutable std::mutex write_mu_;
+
+    /**
+     * @brief Tracked operations by id.
+     */
+    std::unordered_map<std::string, OpState> ops_;
+
+    /**
+     * @brief Ids in the order they started being tracked, for eviction.
+     */
+    std::deque<std::string> order_;
+
+    /**
+     * @brief Stage durations, indexed by TraceStage.
+     */
+    std::unique_ptr<Histogram> stages_[kTraceStages];
+
+    /**
+     * @brief Attempts per finished operation.
+     */
+    std::unique_ptr<Histogram> attempts_;
+
+    /**
+     * @brief Kept spans (keep_spans).
+     */
+
+    std::vector<Span> spans_;
+    std::uint64_t evicted_{0};
+    std::uint64_t dropped_spans_{0};
+  };
+
+} // namespace vix::sync
+
+#endif // VIX_SYNC_TRACER_HPP
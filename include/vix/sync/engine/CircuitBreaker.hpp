@@ -0,0 +1,193 @@
+/**
+ *
+ *  @file CircuitBreaker.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_CIRCUIT_BREAKER_HPP
+#define VIX_SYNC_CIRCUIT_BREAKER_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace vix::sync::engine
+{
+  /**
+   * @brief Per-target circuit breaker used by sync workers.
+   *
+   * CircuitBreaker tracks delivery health for each Operation::target and
+   * decides whether the worker may claim another operation for that target:
+   * - Closed: operations flow normally, consecutive failures are counted
+   * - Open: the target is considered down, operations are left Pending
+   *   without being claimed (no network call, no store write)
+   * - HalfOpen: after open_duration_ms, a limited number of probe operations
+   *   are let through; a successful probe closes the circuit, a failed one
+   *   opens it again
+   *
+   * Only retryable failures count against a target. A non-retryable failure
+   * means the remote side answered, so it is treated as a healthy response.
+   *
+   * @note Thread-safe. A single instance may be shared by several workers.
+   */
+  class CircuitBreaker
+  {
+  public:
+    /**
+     * @brief Circuit state for a target.
+     */
+    enum class State : std::uint8_t
+    {
+      Closed = 0,
+      Open,
+      HalfOpen
+    };
+
+    /**
+     * @brief Configuration values controlling breaker thresholds.
+     *
+     * All time values are expressed in milliseconds.
+     */
+    struct Config
+    {
+      /**
+       * @brief Enable the breaker. When false, allow() always returns true.
+       */
+      bool enabled{false};
+
+      /**
+       * @brief Consecutive retryable failures that open the circuit.
+       */
+      std::uint32_t failure_threshold{5};
+
+      /**
+       * @brief Time the circuit stays open before probing again.
+       */
+      std::int64_t open_duration_ms{30'000};
+
+      /**
+       * @brief Maximum concurrent probe operations while half-open.
+       */
+      std::uint32_t half_open_max_probes{1};
+
+      /**
+       * @brief Successful probes required to close the circuit again.
+       */
+      std::uint32_t success_threshold{1};
+    };
+
+    /**
+     * @brief Construct a breaker with the given thresholds.
+     *
+     * @param cfg Breaker configuration.
+     */
+    explicit CircuitBreaker(Config cfg);
+
+    /**
+     * @brief Decide whether one operation for target may be dispatched.
+     *
+     * In HalfOpen state, a successful call reserves one probe slot. The
+     * caller must settle it with on_success(), on_failure() or release().
+     *
+     * @param target Operation target.
+     * @param now_ms Current time in milliseconds.
+     * @return true if the operation may be claimed and sent.
+     */
+    bool allow(const std::string &target, std::int64_t now_ms);
+
+    /**
+     * @brief Give back a slot obtained from allow() that was not used.
+     *
+     * Typically called when the claim of the operation was lost.
+     *
+     * @param target Operation target.
+     */
+    void release(const std::string &target);
+
+    /**
+     * @brief Record a healthy response for target.
+     *
+     * @param target Operation target.
+     * @param now_ms Current time in milliseconds.
+     */
+    void on_success(const std::string &target, std::int64_t now_ms);
+
+    /**
+     * @brief Record a retryable delivery failure for target.
+     *
+     * @param target Operation target.
+     * @param now_ms Current time in milliseconds.
+     */
+    void on_failure(const std::string &target, std::int64_t now_ms);
+
+    /**
+     * @brief Current state for target.
+     *
+     * An open circuit whose open_duration_ms has elapsed is reported as
+     * HalfOpen.
+     *
+     * @param target Operation target.
+     * @param now_ms Current time in milliseconds.
+     */
+    State state(const std::string &target, std::int64_t now_ms) const;
+
+    /**
+     * @brief Number of targets whose circuit is currently not closed.
+     */
+    std::size_t open_count() const;
+
+    /**
+     * @brief Access the breaker configuration.
+     */
+    const Config &config() const noexcept { return cfg_; }
+
+  private:
+    /**
+     * @brief Tracked state for one target.
+     *
+     * Targets without an entry are Closed with no recorded failure.
+     */
+    struct Entry
+    {
+      State state{State::Closed};
+      std::uint32_t consecutive_failures{0};
+      std::uint32_t probes_inflight{0};
+      std::uint32_t probe_successes{0};
+      std::int64_t opened_at_ms{0};
+    };
+
+    /**
+     * @brief Open the circuit described by e.
+     */
+    void trip_(Entry &e, std::int64_t now_ms) noexcept;
+
+  private:
+    /**
+     * @brief Breaker configuration.
+     */
+    Config cfg_;
+
+    /**
+     * @brief Mutex protecting entries_.
+     */
+    mutable std::mutex mu_;
+
+    /**
+     * @brief Per-target state (only unhealthy targets are tracked).
+     */
+    std::unordered_map<std::string, Entry> entries_;
+  };
+
+} // namespace vix::sync::engine
+
+#endif // VIX_SYNC_CIRCUIT_BREAKER_HPP
@@ -0,0 +1,253 @@
+/**
+ *
+ *  @file ConcurrencyLimiter.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_CONCURRENCY_LIMITER_HPP
+#define VIX_SYNC_CONCURRENCY_LIMITER_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vix::sync::engine
+{
+  /**
+   * @brief Adaptive per-target in-flight limit for sync workers.
+   *
+   * ConcurrencyLimiter replaces a static per-tick budget with a limit that
+   * follows the observed health of each Operation::target:
+   * - Aimd: additive increase while sends succeed under the latency
+   *   threshold, multiplicative decrease on retryable errors or slow sends
+   * - Gradient: the limit is scaled by baseline_latency / current_latency
+   *   (Vegas/gradient style), plus a small queue allowance
+   *
+   * Transport calls are synchronous, so an operation holds its permit from
+   * claim until the end of the worker tick that sent it. The limit therefore
+   * bounds how many operations a target receives per tick window.
+   *
+   * @note Thread-safe. A single instance may be shared by several workers.
+   */
+  class ConcurrencyLimiter
+  {
+  public:
+    /**
+     * @brief Limit adjustment algorithm.
+     */
+    enum class Mode : std::uint8_t
+    {
+      Aimd = 0,
+      Gradient
+    };
+
+    /**
+     * @brief Configuration values controlling the limiter.
+     *
+     * All time values are expressed in milliseconds.
+     */
+    struct Config
+    {
+      /**
+       * @brief Enable the limiter. When false, try_acquire() always succeeds.
+       */
+      bool enabled{false};
+
+      /**
+       * @brief Adjustment algorithm.
+       */
+      Mode mode{Mode::Aimd};
+
+      /**
+       * @brief Limit given to a target seen for the first time.
+       */
+      double initial_limit{4.0};
+
+      /**
+       * @brief Lower bound of the limit (never below 1).
+       */
+      double min_limit{1.0};
+
+      /**
+       * @brief Upper bound of the limit.
+       */
+      double max_limit{256.0};
+
+      /**
+       * @brief Aimd: limit increase per fully successful window.
+       */
+      double additive_increase{1.0};
+
+      /**
+       * @brief Aimd: factor applied to the limit on congestion.
+       */
+      double backoff_ratio{0.5};
+
+      /**
+       * @brief Aimd: latency above which a send counts as congestion.
+       *
+       * A value of 0 disables latency-based decrease.
+       */
+      double latency_threshold_ms{0.0};
+
+      /**
+       * @brief Minimum time between two multiplicative decreases.
+       *
+       * Prevents one failed batch from collapsing the limit several times.
+       */
+      std::int64_t decrease_interval_ms{100};
+
+      /**
+       * @brief Smoothing factor of the latency and error-rate averages.
+       */
+      double smoothing{0.2};
+
+      /**
+       * @brief Idle time after which a target back at initial_limit is forgotten.
+       *
+       * Bounds memory when targets are many and short-lived (URLs carrying
+       * ids). A forgotten target starts over at initial_limit.
+       */
+      std::int64_t idle_eviction_ms{60'000};
+    };
+
+    /**
+     * @brief Observable state for one target, exposed as metrics.
+     */
+    struct TargetStats
+    {
+      std::string target;
+      double limit{0.0};
+      std::size_t inflight{0};
+      double latency_ms{0.0};
+      double baseline_latency_ms{0.0};
+      double error_rate{0.0};
+      std::uint64_t samples{0};
+    };
+
+    /**
+     * @brief Construct a limiter.
+     *
+     * @param cfg Limiter configuration.
+     */
+    explicit ConcurrencyLimiter(Config cfg);
+
+    /**
+     * @brief Try to take one in-flight permit for target.
+     *
+     * @param target Operation target.
+     * @return true if the permit was granted.
+     */
+    bool try_acquire(const std::string &target);
+
+    /**
+     * @brief Return a permit without recording a sample.
+     *
+     * @param target Operation target.
+     */
+    void release(const std::string &target);
+
+    /**
+     * @brief Record the outcome of one transport call and adapt the limit.
+     *
+     * A batched send is one sample, not one per operation. Permits
+     * themselves are returned with release().
+     *
+     * @param target Operation target.
+     * @param latency_ms Measured transport latency.
+     * @param congested True if the call had a retryable failure.
+     * @param now_ms Current time in milliseconds.
+     */
+    void on_sample(
+        const std::string &target,
+        double latency_ms,
+        bool congested,
+        std::int64_t now_ms);
+
+    /**
+     * @brief Current limit for target.
+     */
+    double limit(const std::string &target) const;
+
+    /**
+     * @brief Snapshot of all tracked targets.
+     */
+    std::vector<TargetStats> snapshot() const;
+
+    /**
+     * @brief Access the limiter configuration.
+     */
+    const Config &config() const noexcept { return cfg_; }
+
+  private:
+    /**
+     * @brief Tracked state for one target.
+     */
+    struct Entry
+    {
+      double limit{0.0};
+      std::size_t inflight{0};
+      double latency_ms{0.0};
+      double baseline_ms{0.0};
+      double error_rate{0.0};
+      std::uint64_t samples{0};
+      std::int64_t last_decrease_ms{0};
+      bool decreased{false};
+
+      /**
+       * @brief Time of the last sample.
+       */
+      std::int64_t last_sample_ms{0};
+    };
+
+    /**
+     * @brief Get or create the entry for target (mu_ must be held).
+     */
+    Entry &entry_(const std::string &target);
+
+    /**
+     * @brief Clamp a limit to [min_limit, max_limit].
+     */
+    double clamp_(double limit) const noexcept;
+
+    /**
+     * @brief Forget idle targets back at initial_limit (mu_ must be held).
+     */
+    void evict_idle_(std::int64_t now_ms);
+
+  private:
+    /**
+     * @brief Limiter configuration.
+     */
+    Config cfg_;
+
+    /**
+     * @brief Mutex protecting entries_.
+     */
+    mutable std::mutex mu_;
+
+    /**
+     * @brief Per-target state.
+     */
+    std::unordered_map<std::string, Entry> entries_;
+
+    /**
+     * @brief Time of the last evict_idle_() sweep.
+     */
+    std::int64_t last_sweep_ms_{0};
+  };
+
+} // namespace vix::sync::engine
+
+#endif // VIX_SYNC_CONCURRENCY_LIMITER_HPP
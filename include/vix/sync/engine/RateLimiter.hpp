@@ -0,0 +1,243 @@
+/**
+ *
+ *  @file RateLimiter.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_RATE_LIMITER_HPP
+#define VIX_SYNC_RATE_LIMITER_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <vix/sync/Operation.hpp>
+
+namespace vix::sync::engine
+{
+  /**
+   * @brief Token-bucket rate limiting keyed by operation kind and target.
+   *
+   * RateLimiter is consulted by workers before claiming an operation. When
+   * a matching bucket is empty, the operation is left Pending: it is not
+   * claimed, no attempt is consumed, and the worker reports when the next
+   * token becomes available so the engine can sleep exactly until then.
+   *
+   * Each Rule selects operations (empty kind/target match anything) and
+   * decides how buckets are keyed: one bucket for the whole rule, or one
+   * bucket per kind, per target, or per (kind, target) pair.
+   *
+   * An operation must obtain a token from every matching rule; tokens are
+   * taken all-or-nothing. Buckets idle for longer than their refill period
+   * are dropped, so keys with a high cardinality do not accumulate.
+   *
+   * @note Thread-safe. A single instance may be shared by several workers.
+   */
+  class RateLimiter
+  {
+  public:
+    /**
+     * @brief How buckets of a rule are keyed.
+     */
+    enum class KeyBy : std::uint8_t
+    {
+      /**
+       * @brief One bucket shared by every operation matching the rule.
+       */
+      Rule = 0,
+
+      /**
+       * @brief One bucket per Operation::kind.
+       */
+      Kind,
+
+      /**
+       * @brief One bucket per Operation::target.
+       */
+      Target,
+
+      /**
+       * @brief One bucket per (kind, target) pair.
+       */
+      KindAndTarget
+    };
+
+    /**
+     * @brief A rate limit applied to matching operations.
+     */
+    struct Rule
+    {
+      /**
+       * @brief Operation kind to match (empty matches any kind).
+       */
+      std::string kind;
+
+      /**
+       * @brief Operation target to match (empty matches any target).
+       */
+      std::string target;
+
+      /**
+       * @brief Bucket keying for matching operations.
+       */
+      KeyBy key_by{KeyBy::Rule};
+
+      /**
+       * @brief Sustained rate in operations per second.
+       */
+      double rate_per_sec{10.0};
+
+      /**
+       * @brief Bucket capacity (maximum burst).
+       */
+      double burst{10.0};
+    };
+
+    /**
+     * @brief Limiter configuration.
+     */
+    struct Config
+    {
+      /**
+       * @brief Rules to enforce. No rule means no limiting.
+       */
+      std::vector<Rule> rules;
+    };
+
+    /**
+     * @brief Outcome of try_acquire().
+     */
+    struct Decision
+    {
+      /**
+       * @brief True if tokens were taken and the operation may be sent.
+       */
+      bool allowed{true};
+
+      /**
+       * @brief When denied, time at which a token will be available.
+       */
+      std::int64_t retry_at_ms{0};
+    };
+
+    /**
+     * @brief Construct a limiter.
+     *
+     * @param cfg Limiter configuration.
+     */
+    explicit RateLimiter(Config cfg);
+
+    /**
+     * @brief Take one token from every bucket matching op.
+     *
+     * @param op Operation about to be claimed.
+     * @param now_ms Current time in milliseconds.
+     * @return Decision telling whether the operation may proceed.
+     */
+    Decision try_acquire(const vix::sync::Operation &op, std::int64_t now_ms);
+
+    /**
+     * @brief Give back the tokens taken for op (e.g. claim was lost).
+     *
+     * @param op Operation passed to a successful try_acquire().
+     */
+    void refund(const vix::sync::Operation &op);
+
+    /**
+     * @brief Number of buckets currently tracked.
+     */
+    std::size_t bucket_count() const;
+
+    /**
+     * @brief Whether any rule is configured.
+     */
+    bool enabled() const noexcept { return !cfg_.rules.empty(); }
+
+    /**
+     * @brief Access the limiter configuration.
+     */
+    const Config &config() const noexcept { return cfg_; }
+
+  private:
+    /**
+     * @brief State of a single token bucket.
+     */
+    struct Bucket
+    {
+      double tokens{0.0};
+      std::int64_t updated_at_ms{0};
+      bool initialized{false};
+
+      /**
+       * @brief Index of the rule the bucket belongs to.
+       */
+      std::size_t rule{0};
+    };
+
+    /**
+     * @brief Compute the bucket key of rule for op.
+     */
+    static std::string key_(std::size_t rule_index, const Rule &rule, const vix::sync::Operation &op);
+
+    /**
+     * @brief Whether rule applies to op.
+     */
+    static bool matches_(const Rule &rule, const vix::sync::Operation &op) noexcept;
+
+    /**
+     * @brief Time for a bucket of rule to refill from empty, in milliseconds.
+     *
+     * -1 when the rule never refills.
+     */
+    static std::int64_t refill_ms_(const Rule &rule) noexcept;
+
+    /**
+     * @brief Drop buckets idle for longer than their refill period (mu_ must be held).
+     *
+     * Such a bucket is full again, exactly like one never used.
+     */
+    void evict_idle_(std::int64_t now_ms);
+
+  private:
+    /**
+     * @brief Limiter configuration.
+     */
+    Config cfg_;
+
+    /**
+     * @brief Mutex protecting buckets_.
+     */
+    mutable std::mutex mu_;
+
+    /**
+     * @brief Buckets by key (rule index + selected fields).
+     */
+    std::unordered_map<std::string, Bucket> buckets_;
+
+    /**
+     * @brief Longest refill period of the rules (-1 when none refills).
+     *
+     * evict_idle_() runs at most once per period.
+     */
+    std::int64_t sweep_interval_ms_{-1};
+
+    /**
+     * @brief Time of the last evict_idle_() sweep.
+     */
+    std::int64_t last_sweep_ms_{0};
+  };
+
+} // namespace vix::sync::engine
+
+#endif // VIX_SYNC_RATE_LIMITER_HPP
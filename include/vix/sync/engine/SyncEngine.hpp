@@ -19,10 +19,12 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
 #include <vix/net/NetworkProbe.hpp>
+#include <vix/sync/Clock.hpp>
 #include <vix/sync/engine/SyncWorker.hpp>
 #include <vix/sync/outbox/Outbox.hpp>
 
@@ -81,6 +83,42 @@ namespace vix::sync::engine
        * for retry depending on worker logic.
        */
       std::int64_t inflight_timeout_ms{10'000};
+
+      /**
+       * @brief Maximum number of operations per ISyncTransport::send_batch() call.
+       *
+       * See SyncWorker::Config::send_batch_max_ops.
+       */
+      std::size_t send_batch_max_ops{1};
+
+      /**
+       * @brief Maximum cumulated payload bytes per send_batch() call.
+       *
+       * See SyncWorker::Config::send_batch_max_bytes.
+       */
+      std::size_t send_batch_max_bytes{256 * 1024};
+
+      /**
+       * @brief Per-target circuit breaker shared by all workers.
+       */
+      CircuitBreaker::Config circuit_breaker{};
+
+      /**
+       * @brief Adaptive per-target in-flight limits shared by all workers.
+       */
+      ConcurrencyLimiter::Config concurrency{};
+
+      /**
+       * @brief Token-bucket rate limits shared by all workers.
+       */
+      RateLimiter::Config rate_limits{};
+
+      /**
+       * @brief Time source of the background loop and of tick().
+       *
+       * Null uses the outbox clock.
+       */
+      std::shared_ptr<vix::sync::Clock> clock{};
     };
 
     /**
@@ -114,10 +152,41 @@ namespace vix::sync::engine
      * - Manual driving (integration into an existing loop)
      * - Unit testing deterministic behavior by controlling time
      *
-     * @param now_ms Current monotonic time in milliseconds.
+     * @param now_ms Current time in milliseconds, from the engine clock.
      * @return std::size_t Number of operations processed (best-effort metric).
      */
-    std::size_t tick(std::int64_t now_ms);
+    std::size_t tick(std::int64_t now_ms) { return tick_with_stats(now_ms).processed; }
+
+    /**
+     * @brief Execute one engine iteration and report where the time went.
+     *
+     * The stats of every worker are summed (ticks counts worker ticks) and
+     * recorded for last_tick_stats() and tick_stats().
+     *
+     * @param now_ms Current time in milliseconds, from the engine clock.
+     * @return TickStats summed over the workers.
+     */
+    TickStats tick_with_stats(std::int64_t now_ms);
+
+    /**
+     * @brief Execute one engine iteration at the current time of the clock.
+     */
+    std::size_t tick() { return tick(clock_->now_ms()); }
+
+    /**
+     * @brief Clock of the engine.
+     */
+    std::shared_ptr<vix::sync::Clock> clock() const noexcept { return clock_; }
+
+    /**
+     * @brief Metrics of the outbox driven by the engine (may be null).
+     */
+    std::shared_ptr<vix::sync::SyncMetrics> metrics() const noexcept { return outbox_ ? outbox_->metrics() : nullptr; }
+
+    /**
+     * @brief Lifecycle tracer of the outbox driven by the engine (may be null).
+     */
+    std::shared_ptr<vix::sync::Tracer> tracer() const noexcept { return outbox_ ? outbox_->tracer() : nullptr; }
 
     /**
      * @brief Start the internal background loop.
@@ -140,11 +209,55 @@ namespace vix::sync::engine
      */
     bool running() const noexcept { return running_.load(); }
 
+    /**
+     * @brief Access the circuit breaker shared by the workers.
+     */
+    std::shared_ptr<CircuitBreaker> circuit_breaker() const noexcept { return breaker_; }
+
+    /**
+     * @brief Access the concurrency limiter shared by the workers.
+     */
+    std::shared_ptr<ConcurrencyLimiter> concurrency_limiter() const noexcept { return limiter_; }
+
+    /**
+     * @brief Current adaptive limit, latency and error rate per target.
+     */
+    std::vector<ConcurrencyLimiter::TargetStats> concurrency_limits() const;
+
+    /**
+     * @brief Access the rate limiter shared by the workers.
+     */
+    std::shared_ptr<RateLimiter> rate_limiter() const noexcept { return rate_limiter_; }
+
+    /**
+     * @brief Earliest time a rate-limited operation becomes sendable.
+     *
+     * Based on the last tick of every worker. Returns 0 when nothing is
+     * waiting on a token.
+     */
+    std::int64_t next_wake_at_ms() const noexcept;
+
+    /**
+     * @brief Stats of the last engine tick, summed over the workers.
+     */
+    TickStats last_tick_stats() const;
+
+    /**
+     * @brief Stats accumulated over every tick since construction or reset.
+     */
+    TickStats tick_stats() const;
+
+    /**
+     * @brief Clear the accumulated tick stats.
+     */
+    void reset_tick_stats();
+
   private:
     /**
      * @brief Internal background thread loop.
      *
-     * Repeatedly calls tick(), then sleeps depending on idle/offline state.
+     * Repeatedly calls tick(), then sleeps depending on idle/offline state
+     * and on the next rate-limit token refill.
      */
     void run_loop_();
 
@@ -169,11 +282,46 @@ namespace vix::sync::engine
      */
     std::shared_ptr<ISyncTransport> transport_;
 
+    /**
+     * @brief Time source (engine config, else outbox clock).
+     */
+    std::shared_ptr<vix::sync::Clock> clock_;
+
+    /**
+     * @brief Circuit breaker shared by all workers.
+     */
+    std::shared_ptr<CircuitBreaker> breaker_;
+
+    /**
+     * @brief Concurrency limiter shared by all workers.
+     */
+    std::shared_ptr<ConcurrencyLimiter> limiter_;
+
+    /**
+     * @brief Rate limiter shared by all workers.
+     */
+    std::shared_ptr<RateLimiter> rate_limiter_;
+
     /**
      * @brief Owned workers responsible for processing outbox batches.
      */
     std::vector<std::unique_ptr<SyncWorker>> workers_;
 
+    /**
+     * @brief Mutex protecting last_tick_ and total_ticks_.
+     */
+    mutable std::mutex stats_mu_;
+
+    /**
+     * @brief Stats of the last tick, summed over the workers.
+     */
+    TickStats last_tick_;
+
+    /**
+     * @brief Stats accumulated since construction or reset_tick_stats().
+     */
+    TickStats total_ticks_;
+
     /**
      * @brief Running flag for the background loop.
      */
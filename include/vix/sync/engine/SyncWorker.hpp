@@ -19,10 +19,16 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
 #include <vix/net/NetworkProbe.hpp>
 #include <vix/sync/Operation.hpp>
+#include <vix/sync/engine/CircuitBreaker.hpp>
+#include <vix/sync/engine/ConcurrencyLimiter.hpp>
+#include <vix/sync/engine/RateLimiter.hpp>
 #include <vix/sync/outbox/Outbox.hpp>
 
 namespace vix::sync::engine
@@ -78,6 +84,137 @@ namespace vix::sync::engine
      * @return SendResult describing success/failure and retryability.
      */
     virtual SendResult send(const vix::sync::Operation &op) = 0;
+
+    /**
+     * @brief Send a group of operations in a single exchange.
+     *
+     * The worker only batches operations sharing the same kind and target,
+     * so implementations can map a batch onto one bulk request.
+     *
+     * The returned vector must contain exactly one SendResult per input
+     * operation, in the same order. Missing results are treated by the
+     * worker as retryable failures.
+     *
+     * The default implementation falls back to one send() per operation.
+     *
+     * @param ops Operations to deliver (same kind and target).
+     * @return Per-operation results, index-aligned with ops.
+     */
+    virtual std::vector<SendResult> send_batch(std::span<const vix::sync::Operation> ops)
+    {
+      std::vector<SendResult> out;
+      out.reserve(ops.size());
+      for (const auto &op : ops)
+        out.push_back(send(op));
+      return out;
+    }
+  };
+
+  /**
+   * @brief Where the time of one or more worker ticks went.
+   *
+   * Phase durations are steady-clock nanoseconds. When summed over several
+   * ticks (operator+=), every field accumulates, including ticks.
+   */
+  struct TickStats
+  {
+    /**
+     * @brief Number of ticks aggregated.
+     */
+    std::uint64_t ticks{0};
+
+    /**
+     * @brief Operations sent and settled (the value returned by tick()).
+     */
+    std::size_t processed{0};
+
+    /**
+     * @brief Ready operations returned by peek_ready().
+     */
+    std::size_t scanned{0};
+
+    /**
+     * @brief Operations claimed.
+     */
+    std::size_t claimed{0};
+
+    /**
+     * @brief Claims lost to another worker.
+     */
+    std::size_t claims_lost{0};
+
+    /**
+     * @brief Scanned operations left Pending (expired, or refused by a limiter or breaker).
+     */
+    std::size_t skipped{0};
+
+    /**
+     * @brief In-flight operations requeued after inflight_timeout_ms.
+     */
+    std::size_t requeued{0};
+
+    /**
+     * @brief Operations moved to Expired by the sweep.
+     */
+    std::size_t expired{0};
+
+    /**
+     * @brief Bytes written by the store while the tick ran.
+     *
+     * From OutboxStore::bytes_written(); writes by other threads during the
+     * tick are included.
+     */
+    std::uint64_t bytes_persisted{0};
+
+    /**
+     * @brief Ticks that skipped dispatch because the network was offline.
+     */
+    std::uint64_t offline_ticks{0};
+
+    /**
+     * @brief Time in requeue_inflight_older_than().
+     */
+    std::int64_t requeue_ns{0};
+
+    /**
+     * @brief Time in the expiry sweep.
+     */
+    std::int64_t expire_ns{0};
+
+    /**
+     * @brief Time in the network probe.
+     */
+    std::int64_t probe_ns{0};
+
+    /**
+     * @brief Time in peek_ready() and batch grouping.
+     */
+    std::int64_t peek_ns{0};
+
+    /**
+     * @brief Time in admission checks and claims.
+     */
+    std::int64_t claim_ns{0};
+
+    /**
+     * @brief Time in transport calls.
+     */
+    std::int64_t send_ns{0};
+
+    /**
+     * @brief Time recording outcomes (complete/fail, breaker, limiter).
+     */
+    std::int64_t settle_ns{0};
+
+    /**
+     * @brief Wall time of the whole tick.
+     */
+    std::int64_t total_ns{0};
+
+    /**
+     * @brief Accumulate another sample.
+     */
+    TickStats &operator+=(const TickStats &o) noexcept;
   };
 
   /**
@@ -88,6 +225,7 @@ namespace vix::sync::engine
    * - Pulls a batch of ready operations from the Outbox
    * - Sends operations through ISyncTransport
    * - Applies retry/backoff decisions by updating Outbox state (implementation-defined)
+   * - Sweeps operations past their deadline to Expired before dispatching
    *
    * Workers are typically owned and orchestrated by SyncEngine.
    *
@@ -106,6 +244,9 @@ namespace vix::sync::engine
     {
       /**
        * @brief Maximum number of operations to process per tick.
+       *
+       * Counts claimed operations; candidates refused by a limiter or
+       * breaker do not use up the budget.
        */
       std::size_t batch_limit{25};
 
@@ -130,6 +271,46 @@ namespace vix::sync::engine
        * and eligible for retry according to outbox policy.
        */
       std::int64_t inflight_timeout_ms{10'000};
+
+      /**
+       * @brief Maximum number of operations grouped into one send_batch() call.
+       *
+       * Ready operations are grouped by (kind, target). A value of 1 keeps
+       * one transport call per operation.
+       */
+      std::size_t send_batch_max_ops{1};
+
+      /**
+       * @brief Maximum cumulated payload size of one send_batch() call.
+       *
+       * An operation larger than this limit is still sent, alone in its batch.
+       * A value of 0 disables the byte limit.
+       */
+      std::size_t send_batch_max_bytes{256 * 1024};
+
+      /**
+       * @brief Per-target circuit breaker thresholds.
+       *
+       * Used to build the worker's own breaker. SyncEngine replaces it with
+       * a breaker shared by all its workers.
+       */
+      CircuitBreaker::Config circuit_breaker{};
+
+      /**
+       * @brief Adaptive per-target in-flight limits.
+       *
+       * Used to build the worker's own limiter. SyncEngine replaces it with
+       * a limiter shared by all its workers.
+       */
+      ConcurrencyLimiter::Config concurrency{};
+
+      /**
+       * @brief Token-bucket rate limits by kind and target.
+       *
+       * Used to build the worker's own limiter. SyncEngine replaces it with
+       * a limiter shared by all its workers.
+       */
+      RateLimiter::Config rate_limits{};
     };
 
     /**
@@ -155,9 +336,87 @@ namespace vix::sync::engine
      * @param now_ms Current monotonic time in milliseconds.
      * @return std::size_t Number of operations processed (best-effort metric).
      */
-    std::size_t tick(std::int64_t now_ms);
+    std::size_t tick(std::int64_t now_ms) { return tick_with_stats(now_ms).processed; }
+
+    /**
+     * @brief Process a batch of operations and report where the time went.
+     *
+     * Same work as tick(), returning per-phase timings and counters.
+     *
+     * @param now_ms Current monotonic time in milliseconds.
+     * @return TickStats of this tick (ticks == 1).
+     */
+    TickStats tick_with_stats(std::int64_t now_ms);
+
+    /**
+     * @brief Replace the circuit breaker used by this worker.
+     *
+     * Allows several workers to share one breaker so that a target tripped
+     * by one worker is skipped by all of them.
+     *
+     * @param breaker Breaker to use (ignored if null).
+     */
+    void set_circuit_breaker(std::shared_ptr<CircuitBreaker> breaker);
+
+    /**
+     * @brief Access the circuit breaker used by this worker.
+     */
+    std::shared_ptr<CircuitBreaker> circuit_breaker() const noexcept { return breaker_; }
+
+    /**
+     * @brief Replace the concurrency limiter used by this worker.
+     *
+     * @param limiter Limiter to use (ignored if null).
+     */
+    void set_concurrency_limiter(std::shared_ptr<ConcurrencyLimiter> limiter);
+
+    /**
+     * @brief Access the concurrency limiter used by this worker.
+     */
+    std::shared_ptr<ConcurrencyLimiter> concurrency_limiter() const noexcept { return limiter_; }
+
+    /**
+     * @brief Replace the rate limiter used by this worker.
+     *
+     * @param limiter Limiter to use (ignored if null).
+     */
+    void set_rate_limiter(std::shared_ptr<RateLimiter> limiter);
+
+    /**
+     * @brief Access the rate limiter used by this worker.
+     */
+    std::shared_ptr<RateLimiter> rate_limiter() const noexcept { return rate_limiter_; }
+
+    /**
+     * @brief Earliest time a rate-limited operation may be retried.
+     *
+     * Computed during the last tick. Returns 0 when no operation was held
+     * back by a rate limit.
+     */
+    std::int64_t next_wake_at_ms() const noexcept { return next_wake_at_ms_; }
 
   private:
+    /**
+     * @brief Outcome of admit_().
+     */
+    enum class Admission : std::uint8_t
+    {
+      /**
+       * @brief The operation may be claimed.
+       */
+      Admitted = 0,
+
+      /**
+       * @brief Refused for its target (no permit left, or circuit open).
+       */
+      TargetBlocked,
+
+      /**
+       * @brief Refused by a rate limit; same kind and target are refused too.
+       */
+      RateLimited
+    };
+
     /**
      * @brief Decide whether the worker should attempt sending right now.
      *
@@ -171,13 +430,50 @@ namespace vix::sync::engine
     /**
      * @brief Process operations that are ready to be sent.
      *
-     * Pulls a batch from the Outbox and attempts to deliver each operation via
-     * the transport. Updates Outbox state according to send outcomes.
+     * Pulls ready operations from the Outbox and attempts to deliver each
+     * one via the transport, until batch_limit operations have been claimed
+     * or no candidate is left. Operations refused by a limiter or breaker do
+     * not count: the Outbox is read past them. Updates Outbox state
+     * according to send outcomes.
      *
      * @param now_ms Current monotonic time in milliseconds.
+     * @param st Stats of the current tick.
      * @return std::size_t Number of operations processed.
      */
-    std::size_t process_ready_(std::int64_t now_ms);
+    std::size_t process_ready_(std::int64_t now_ms, TickStats &st);
+
+    /**
+     * @brief Claim, send and settle one group of operations.
+     *
+     * All operations must share the same kind and target. Operations not
+     * admitted by admit_(), or that cannot be claimed, are skipped; the
+     * remaining ones are delivered with a single send_batch() call and
+     * completed or failed individually.
+     *
+     * @param batch Candidate operations (consumed).
+     * @param now_ms Current monotonic time in milliseconds.
+     * @param st Stats of the current tick.
+     * @return std::size_t Number of operations processed.
+     */
+    std::size_t send_batch_(std::vector<vix::sync::Operation> batch, std::int64_t now_ms, TickStats &st);
+
+    /**
+     * @brief Check the dispatch policies before claiming op.
+     *
+     * Consults, in order, the concurrency limiter, the circuit breaker and
+     * the rate limiter. A refused operation stays Pending, untouched.
+     *
+     * @param op Candidate operation.
+     * @param now_ms Current monotonic time in milliseconds.
+     * @return Admission::Admitted if op may be claimed; undo with revoke_()
+     * if the claim fails.
+     */
+    Admission admit_(const vix::sync::Operation &op, std::int64_t now_ms);
+
+    /**
+     * @brief Undo a successful admit_() whose claim was lost.
+     */
+    void revoke_(const vix::sync::Operation &op);
 
   private:
     /**
@@ -199,6 +495,48 @@ namespace vix::sync::engine
      * @brief Transport used to send operations.
      */
     std::shared_ptr<ISyncTransport> transport_;
+
+    /**
+     * @brief Per-target circuit breaker consulted before claiming.
+     */
+    std::shared_ptr<CircuitBreaker> breaker_;
+
+    /**
+     * @brief Adaptive per-target in-flight limiter consulted before claiming.
+     */
+    std::shared_ptr<ConcurrencyLimiter> limiter_;
+
+    /**
+     * @brief Targets of the permits taken during the current tick.
+     *
+     * Released together at the end of process_ready_().
+     */
+    std::vector<std::string> permits_;
+
+    /**
+     * @brief Operations already considered during the current tick.
+     */
+    std::unordered_set<std::string> seen_;
+
+    /**
+     * @brief Targets refused by the limiter or breaker during the current tick.
+     */
+    std::unordered_set<std::string> blocked_targets_;
+
+    /**
+     * @brief (kind, target) groups refused by a rate limit during the current tick.
+     */
+    std::unordered_set<std::string> blocked_groups_;
+
+    /**
+     * @brief Token-bucket rate limiter consulted before claiming.
+     */
+    std::shared_ptr<RateLimiter> rate_limiter_;
+
+    /**
+     * @brief Earliest token refill time seen during the last tick (0 = none).
+     */
+    std::int64_t next_wake_at_ms_{0};
   };
 
 } // namespace vix::sync::engine
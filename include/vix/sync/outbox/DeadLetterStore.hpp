@@ -0,0 +1,111 @@
+/**
+ *
+ *  @file DeadLetterStore.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_DEAD_LETTER_STORE_HPP
+#define VIX_DEAD_LETTER_STORE_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <vix/sync/Operation.hpp>
+
+namespace vix::sync::outbox
+{
+  /**
+   * @brief Options controlling dead-letter queries.
+   */
+  struct DeadLetterQuery
+  {
+    /**
+     * @brief Maximum number of operations to return.
+     */
+    std::size_t limit{50};
+
+    /**
+     * @brief Number of matching operations to skip (pagination).
+     */
+    std::size_t offset{0};
+
+    /**
+     * @brief Only return operations of this kind (empty = any).
+     */
+    std::string kind;
+
+    /**
+     * @brief Only return operations for this target (empty = any).
+     */
+    std::string target;
+  };
+
+  /**
+   * @brief Persistence interface for permanently failed operations.
+   *
+   * When an Outbox is configured with a DeadLetterStore, operations that
+   * fail permanently are moved out of the hot OutboxStore into this store.
+   * The outbox then only contains live work, while dead letters remain
+   * available for inspection and redrive.
+   *
+   * @note Thread-safety guarantees are implementation-defined.
+   */
+  class DeadLetterStore
+  {
+  public:
+    /**
+     * @brief Virtual destructor.
+     */
+    virtual ~DeadLetterStore() = default;
+
+    /**
+     * @brief Insert or replace a dead-lettered operation.
+     *
+     * @param op Operation to persist (keeps its id and last_error).
+     */
+    virtual void put(const vix::sync::Operation &op) = 0;
+
+    /**
+     * @brief Retrieve a dead-lettered operation by its identifier.
+     *
+     * @param id Operation identifier.
+     * @return Optional operation if found.
+     */
+    virtual std::optional<vix::sync::Operation> get(const std::string &id) = 0;
+
+    /**
+     * @brief List dead-lettered operations, oldest failure first.
+     *
+     * @param q Query options.
+     * @return Vector of matching operations.
+     */
+    virtual std::vector<vix::sync::Operation> list(const DeadLetterQuery &q) = 0;
+
+    /**
+     * @brief Remove a dead-lettered operation.
+     *
+     * @param id Operation identifier.
+     * @return true if the operation was found and removed.
+     */
+    virtual bool remove(const std::string &id) = 0;
+
+    /**
+     * @brief Number of dead-lettered operations.
+     */
+    virtual std::size_t count() = 0;
+  };
+
+} // namespace vix::sync::outbox
+
+#endif // VIX_DEAD_LETTER_STORE_HPP
@@ -0,0 +1,132 @@
+/**
+ *
+ *  @file FileDeadLetterStore.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_FILE_DEAD_LETTER_STORE_HPP
+#define VIX_FILE_DEAD_LETTER_STORE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <vix/sync/Operation.hpp>
+#include <vix/sync/outbox/DeadLetterStore.hpp>
+
+namespace vix::sync::outbox
+{
+  /**
+   * @brief File-backed implementation of the DeadLetterStore interface.
+   *
+   * Dead letters are persisted in their own JSON file, separate from the
+   * outbox file, using the same operation layout. Like FileOutboxStore, the
+   * file is loaded lazily and rewritten on each mutation; dead letters are
+   * rare, so this keeps the store simple.
+   */
+  class FileDeadLetterStore final : public DeadLetterStore
+  {
+  public:
+    /**
+     * @brief Configuration for FileDeadLetterStore.
+     */
+    struct Config
+    {
+      /**
+       * @brief Path to the JSON file used for persistence.
+       */
+      std::filesystem::path file_path{"./.vix/deadletter.json"};
+
+      /**
+       * @brief Whether to pretty-print the JSON output.
+       */
+      bool pretty_json{false};
+    };
+
+    /**
+     * @brief Construct a file-based dead-letter store.
+     *
+     * @param cfg Store configuration.
+     */
+    explicit FileDeadLetterStore(Config cfg);
+
+    /**
+     * @brief Insert or replace a dead-lettered operation.
+     */
+    void put(const vix::sync::Operation &op) override;
+
+    /**
+     * @brief Retrieve a dead-lettered operation by its identifier.
+     */
+    std::optional<vix::sync::Operation> get(const std::string &id) override;
+
+    /**
+     * @brief List dead-lettered operations, oldest failure first.
+     */
+    std::vector<vix::sync::Operation> list(const DeadLetterQuery &q) override;
+
+    /**
+     * @brief Remove a dead-lettered operation.
+     */
+    bool remove(const std::string &id) override;
+
+    /**
+     * @brief Number of dead-lettered operations.
+     */
+    std::size_t count() override;
+
+  private:
+    /**
+     * @brief Load the JSON file into memory if not already loaded.
+     */
+    void load_if_needed_();
+
+    /**
+     * @brief Flush the in-memory state back to disk.
+     */
+    void flush_();
+
+  private:
+    /**
+     * @brief Store configuration.
+     */
+    Config cfg_;
+
+    /**
+     * @brief Mutex protecting all internal state.
+     */
+    std::mutex mu_;
+
+    /**
+     * @brief Whether the store has been loaded from disk.
+     */
+    bool loaded_{false};
+
+    /**
+     * @brief Map of operation id to operation data.
+     */
+    std::unordered_map<std::string, vix::sync::Operation> ops_;
+
+    /**
+     * @brief Operations ordered by failure time, as (updated_at_ms, id).
+     */
+    std::set<std::pair<std::int64_t, std::string>> order_;
+  };
+
+} // namespace vix::sync::outbox
+
+#endif // VIX_FILE_DEAD_LETTER_STORE_HPP
@@ -16,14 +16,24 @@
 #ifndef VIX_FILE_OUTBOX_STORE_HPP
 #define VIX_FILE_OUTBOX_STORE_HPP
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include <vix/sync/Codec.hpp>
+#include <vix/sync/Metrics.hpp>
 #include <vix/sync/Operation.hpp>
 #include <vix/sync/outbox/OutboxStore.hpp>
 
@@ -42,6 +52,13 @@ namespace vix::sync::outbox
    * representation protected by a mutex. Mutations are flushed back to disk
    * according to the configured persistence policy.
    *
+   * The file is replaced atomically (temporary file renamed over it), so a
+   * crash never leaves a truncated outbox. Each operation's JSON is cached
+   * between writes and only re-encoded after the operation changed, so a
+   * write costs encoding the changed operations plus copying the others.
+   * With flush_interval_ms, mutations only mark the store dirty and a
+   * background thread writes the file, off the callers' threads.
+   *
    * @note This store favors correctness and simplicity over high throughput.
    * For large-scale or high-concurrency scenarios, a database-backed store
    * may be more appropriate.
@@ -56,6 +73,10 @@ namespace vix::sync::outbox
     {
       /**
        * @brief Path to the JSON file used for persistence.
+       *
+       * An empty path keeps the store in memory only: nothing is loaded or
+       * written, and payloads are never moved to a blob file. Useful for
+       * tests and simulations.
        */
       std::filesystem::path file_path{"./.vix/outbox.json"};
 
@@ -67,12 +88,80 @@ namespace vix::sync::outbox
       bool pretty_json{false};
 
       /**
-       * @brief Whether to fsync() the file after each write.
+       * @brief Whether to fsync() each write before it is considered done.
        *
-       * When enabled, provides stronger durability guarantees at the
-       * cost of performance.
+       * The temporary file is fdatasync()ed before being renamed over the
+       * outbox file, the directory is fsync()ed after the rename, and the
+       * blob file is synced first. Provides durability across power loss
+       * at the cost of performance.
        */
       bool fsync_on_write{false};
+
+      /**
+       * @brief Delay between a mutation and its write to disk.
+       *
+       * 0 writes the file on every mutation, on the caller's thread. A
+       * positive value makes mutations only mark the store dirty: a
+       * background thread writes the file at most once per interval, so
+       * bursts of mutations share one write (and one fsync). Mutations of
+       * the last interval are lost on a crash; flush() forces a write.
+       */
+      std::int64_t flush_interval_ms{0};
+
+      /**
+       * @brief How long a terminal operation keeps its idempotency key.
+       *
+       * During this window, enqueuing another operation with the same key
+       * returns the existing id, even if the operation was pruned.
+       */
+      std::int64_t idempotency_retention_ms{24 * 60 * 60 * 1000};
+
+      /**
+       * @brief Payload size from which bytes are stored out of line.
+       *
+       * Larger payloads are appended to a blob file next to the JSON file,
+       * which then only records their location. They are memory-mapped
+       * when read, so they do not stay resident. 0 keeps every payload
+       * inline.
+       */
+      std::size_t blob_threshold_bytes{0};
+
+      /**
+       * @brief Fraction of dropped bytes that triggers blob compaction.
+       */
+      double blob_compact_ratio{0.5};
+
+      /**
+       * @brief Dropped bytes below which the blob file is never compacted.
+       */
+      std::uint64_t blob_compact_min_bytes{1 << 20};
+
+      /**
+       * @brief Store identical payloads once.
+       *
+       * Payloads are indexed by a 64-bit content hash (bytes are compared
+       * on a hash match) and reference counted, so fan-out of one payload
+       * to many targets keeps a single copy in memory, in the JSON file or
+       * in the blob file.
+       */
+      bool dedupe_payloads{false};
+
+      /**
+       * @brief Payload compression.
+       *
+       * Payloads above the size threshold are kept compressed in memory,
+       * in the JSON file (base64) and in the blob file, and decompressed
+       * when read. The blob threshold applies to the original size.
+       */
+      vix::sync::Compression compression{};
+
+      /**
+       * @brief Metrics receiving file rewrite counts, bytes and durations.
+       *
+       * Usually the instance given to Outbox::Config::metrics. Null
+       * disables metrics.
+       */
+      std::shared_ptr<vix::sync::SyncMetrics> metrics{};
     };
 
     /**
@@ -85,6 +174,28 @@ namespace vix::sync::outbox
      */
     explicit FileOutboxStore(Config cfg);
 
+    /**
+     * @brief Destructor.
+     *
+     * Stops the background flusher and writes pending mutations.
+     */
+    ~FileOutboxStore() override;
+
+    /**
+     * @brief Write pending mutations to disk now.
+     *
+     * Only needed with flush_interval_ms; otherwise every mutation is
+     * already written when it returns.
+     *
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void flush();
+
+    /**
+     * @brief Whether mutations are waiting for the background flusher.
+     */
+    bool dirty() const noexcept { return dirty_.load(std::memory_order_relaxed); }
+
     /**
      * @brief Insert or update an operation in the outbox.
      *
@@ -103,6 +214,9 @@ namespace vix::sync::outbox
     /**
      * @brief List operations matching the given options.
      *
+     * Operations are returned by descending priority, then creation order,
+     * with optional aging (see ListOptions::priority_aging_ms).
+     *
      * @param opt Filtering and ordering options.
      * @return Vector of matching operations.
      */
@@ -148,7 +262,7 @@ namespace vix::sync::outbox
         std::int64_t next_retry_at_ms) override;
 
     /**
-     * @brief Remove completed operations older than a given threshold.
+     * @brief Remove completed and expired operations older than a given threshold.
      *
      * @param older_than_ms Cutoff time in milliseconds.
      * @return Number of pruned operations.
@@ -184,6 +298,99 @@ namespace vix::sync::outbox
         std::int64_t now_ms,
         std::int64_t timeout_ms) override;
 
+    /**
+     * @brief Number of live operations per priority.
+     *
+     * Maintained incrementally, no scan involved.
+     */
+    std::map<std::int32_t, std::size_t> depth_by_priority() override;
+
+    /**
+     * @brief Drop operations superseded by a newer one with the same key.
+     *
+     * @param coalesce_key Operation::coalesce_key to coalesce.
+     * @param now_ms Current time in milliseconds.
+     * @return Identifiers of the removed operations.
+     */
+    std::vector<std::string> coalesce(
+        const std::string &coalesce_key,
+        std::int64_t now_ms) override;
+
+    /**
+     * @brief Move operations whose deadline has passed to Expired.
+     *
+     * Walks a deadline-ordered index, so the cost is proportional to the
+     * number of due operations, not to the outbox size.
+     *
+     * @param now_ms Current time in milliseconds.
+     * @return Number of operations expired.
+     */
+    std::size_t expire_due(std::int64_t now_ms) override;
+
+    /**
+     * @brief Current live depth (maintained incrementally).
+     */
+    OutboxDepth depth() override;
+
+    /**
+     * @brief Bytes written by file rewrites since construction.
+     */
+    std::uint64_t bytes_written() const noexcept override
+    {
+      return bytes_written_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Drop lowest-priority, oldest live operations until under limits.
+     *
+     * @param max_ops Live operation count to get under (inclusive).
+     * @param max_bytes Live byte footprint to get under (inclusive, 0 = ignore).
+     * @param max_priority Highest priority that may be dropped.
+     * @return Number of dropped operations.
+     */
+    std::size_t shed(
+        std::size_t max_ops,
+        std::size_t max_bytes,
+        std::int32_t max_priority) override;
+
+    /**
+     * @brief Remove an operation from the store and its indexes.
+     *
+     * @param id Operation identifier.
+     * @return The removed operation, if it was found.
+     */
+    std::optional<vix::sync::Operation> remove(const std::string &id) override;
+
+    /**
+     * @brief Find the operation owning an idempotency key, in O(1).
+     *
+     * @param idempotency_key Operation::idempotency_key to look up.
+     * @param now_ms Current time in milliseconds.
+     * @return Identifier of the owning operation, if any.
+     */
+    std::optional<std::string> find_by_idempotency_key(
+        const std::string &idempotency_key,
+        std::int64_t now_ms) override;
+
+    /**
+     * @brief Atomically insert op unless its idempotency key is owned.
+     *
+     * @param op Operation to persist.
+     * @param now_ms Current time in milliseconds.
+     * @return op.id if inserted, otherwise the id of the existing operation.
+     */
+    std::string put_idempotent(const vix::sync::Operation &op, std::int64_t now_ms) override;
+
+    /**
+     * @brief Copy live out-of-line payloads into a fresh blob file.
+     *
+     * Runs automatically once dropped blobs exceed blob_compact_ratio of
+     * the file. Payloads already handed out remain valid.
+     *
+     * @return Number of bytes reclaimed.
+     */
+    std::uint64_t compact_blobs();
+
   private:
     /**
      * @brief Load the JSON file into memory if not already loaded.
@@ -193,12 +400,178 @@ namespace vix::sync::outbox
     void load_if_needed_();
 
     /**
-     * @brief Flush the in-memory state back to disk.
+     * @brief Persist a mutation (mu_ held).
      *
-     * Writes the JSON file and applies fsync() if configured.
+     * Writes the file now, or marks the store dirty for the background
+     * flusher when flush_interval_ms is set.
      */
     void flush_();
 
+    /**
+     * @brief Store serialized for writing.
+     */
+    struct Rendered
+    {
+      /**
+       * @brief JSON text of the file.
+       */
+      std::string text;
+
+      /**
+       * @brief Number of operations in text.
+       */
+      std::size_t ops{0};
+
+      /**
+       * @brief Operations encoded for this text (the others were cached).
+       */
+      std::size_t encoded{0};
+
+      /**
+       * @brief Blob file referenced by text, synced first with fsync_on_write.
+       */
+      std::filesystem::path blob_file;
+
+      /**
+       * @brief Blob file replaced by a compaction, removed once text is written.
+       */
+      std::filesystem::path retired;
+    };
+
+    /**
+     * @brief Serialize the store (mu_ held).
+     *
+     * Compacts the blob file first if it holds too many dropped bytes, and
+     * takes over the retired blob file.
+     */
+    Rendered render_();
+
+    /**
+     * @brief Encode op as an "id":{...} member of the "ops" object.
+     */
+    std::string encode_op_(const vix::sync::Operation &op) const;
+
+    /**
+     * @brief Drop the cached JSON of an operation that changed or left.
+     */
+    void touch_(const std::string &id) { op_json_.erase(id); }
+
+    /**
+     * @brief Write a rendered store to the file, atomically.
+     *
+     * Touches no state guarded by mu_, so it runs without it.
+     */
+    void write_(const Rendered &r);
+
+    /**
+     * @brief Hand the retired blob file back after a failed write (mu_ held).
+     */
+    void unretire_(const Rendered &r);
+
+    /**
+     * @brief Render and write the store if dirty (write_mu_ held).
+     *
+     * Releases lk, holding mu_, during the write.
+     */
+    void write_dirty_(std::unique_lock<std::mutex> &lk);
+
+    /**
+     * @brief Background flusher loop.
+     */
+    void flusher_loop_();
+
+    /**
+     * @brief Add op to the live index if its status is not terminal.
+     */
+    void index_add_(const vix::sync::Operation &op);
+
+    /**
+     * @brief Remove op from the live index.
+     */
+    void index_remove_(const vix::sync::Operation &op);
+
+    /**
+     * @brief Insert or replace op (mu_ held, store loaded).
+     */
+    void upsert_(const vix::sync::Operation &op);
+
+    /**
+     * @brief Byte footprint of a stored operation, blob included.
+     */
+    std::size_t footprint_(const vix::sync::Operation &op) const;
+
+    /**
+     * @brief Copy of a stored operation with its blob payload attached.
+     */
+    vix::sync::Operation with_payload_(const vix::sync::Operation &op) const;
+
+    /**
+     * @brief Forget a blob, keyed by operation id or content id.
+     */
+    void blob_release_(const std::string &key, bool content);
+
+    /**
+     * @brief Append bytes to the blob file, keyed by operation id or content id.
+     */
+    void blob_store_(const std::string &key, std::string_view bytes, bool content);
+
+    /**
+     * @brief Release the payload of an operation leaving the store.
+     *
+     * Drops its blob, or one reference to its shared content.
+     */
+    void payload_release_(const std::string &id);
+
+    /**
+     * @brief Find or create the shared content holding bytes.
+     *
+     * @return Content id, with one more reference taken.
+     */
+    std::string content_acquire_(const vix::sync::Payload &bytes);
+
+    /**
+     * @brief Bytes of a shared content.
+     */
+    vix::sync::Payload content_bytes_(const std::string &cid) const;
+
+    /**
+     * @brief Store the payload of op out of the operation itself.
+     *
+     * Compresses and/or moves bytes to the blob file as configured.
+     *
+     * @return Bytes to keep inline in the stored operation.
+     */
+    vix::sync::Payload payload_store_(const vix::sync::Operation &op);
+
+    /**
+     * @brief Rewrite the blob file keeping live blobs only (mu_ held).
+     */
+    std::uint64_t compact_blobs_();
+
+    /**
+     * @brief Record the owner of op's idempotency key.
+     *
+     * @param op Operation owning the key.
+     * @param live Whether op is live (the key never expires).
+     * @param done_at_ms Terminal time, start of the retention window.
+     */
+    void idempotency_track_(const vix::sync::Operation &op, bool live, std::int64_t done_at_ms);
+
+    /**
+     * @brief Release op's idempotency key (op dropped before completion).
+     */
+    void idempotency_forget_(const vix::sync::Operation &op);
+
+    /**
+     * @brief Drop terminal keys whose retention window has elapsed.
+     */
+    void idempotency_purge_(std::int64_t now_ms);
+
+    /**
+     * @brief Owner of an idempotency key (mu_ held, store loaded).
+     */
+    std::optional<std::string> find_idempotent_(const std::string &key, std::int64_t now_ms);
+
   private:
     /**
      * @brief Store configuration.
@@ -210,6 +583,33 @@ namespace vix::sync::outbox
      */
     std::mutex mu_;
 
+    /**
+     * @brief Serializes background writes, so files are renamed in order.
+     *
+     * Taken before mu_.
+     */
+    std::mutex write_mu_;
+
+    /**
+     * @brief Mutations not yet written (flush_interval_ms only).
+     */
+    std::atomic<bool> dirty_{false};
+
+    /**
+     * @brief Set to stop the background flusher.
+     */
+    bool stop_{false};
+
+    /**
+     * @brief Wakes the flusher on the first mutation and on stop (with mu_).
+     */
+    std::condition_variable flush_cv_;
+
+    /**
+     * @brief Background flusher (flush_interval_ms only).
+     */
+    std::thread flusher_;
+
     /**
      * @brief Whether the store has been loaded from disk.
      */
@@ -220,10 +620,142 @@ namespace vix::sync::outbox
      */
     std::unordered_map<std::string, vix::sync::Operation> ops_;
 
+    /**
+     * @brief Cached encode_op_() output by operation id.
+     *
+     * An absent entry means the operation changed since it was last
+     * written. Costs about the size of the "ops" object in memory.
+     */
+    std::unordered_map<std::string, std::string> op_json_;
+
     /**
      * @brief Map of operation id to current owner (in-flight).
      */
     std::unordered_map<std::string, std::string> owner_;
+
+    /**
+     * @brief Live operations ordered for dispatch.
+     *
+     * Keyed by priority (highest first), each class holding
+     * (created_at_ms, id) pairs in FIFO order.
+     */
+    std::map<std::int32_t, std::set<std::pair<std::int64_t, std::string>>, std::greater<>> live_;
+
+    /**
+     * @brief Live operations by coalesce key, as (created_at_ms, id) pairs.
+     */
+    std::unordered_map<std::string, std::set<std::pair<std::int64_t, std::string>>> by_coalesce_key_;
+
+    /**
+     * @brief Live operations with a deadline, as (deadline_at_ms, id) pairs.
+     */
+    std::set<std::pair<std::int64_t, std::string>> deadlines_;
+
+    /**
+     * @brief Live operation count and byte footprint.
+     */
+    OutboxDepth depth_;
+
+    /**
+     * @brief Bytes written by flush_() (readable without mu_).
+     */
+    std::atomic<std::uint64_t> bytes_written_{0};
+
+    /**
+     * @brief Owner of an idempotency key.
+     */
+    struct IdempotencyEntry
+    {
+      std::string id;
+      bool live{true};
+      std::int64_t done_at_ms{0};
+    };
+
+    /**
+     * @brief Idempotency key to owning operation.
+     *
+     * Terminal entries outlive pruned operations until their retention
+     * window elapses.
+     */
+    std::unordered_map<std::string, IdempotencyEntry> idempotency_;
+
+    /**
+     * @brief Terminal idempotency entries, as (done_at_ms, key) pairs.
+     */
+    std::set<std::pair<std::int64_t, std::string>> idempotency_expiry_;
+
+    /**
+     * @brief How a compressed payload was stored.
+     */
+    struct Packing
+    {
+      /**
+       * @brief Codec of the stored bytes.
+       */
+      vix::sync::CodecId codec{vix::sync::CodecId::None};
+
+      /**
+       * @brief Size of the original bytes.
+       */
+      std::size_t raw_size{0};
+    };
+
+    /**
+     * @brief Operation id to packing, for compressed non-shared payloads.
+     */
+    std::unordered_map<std::string, Packing> packing_;
+
+    /**
+     * @brief Payload shared by several operations.
+     */
+    struct Content
+    {
+      /**
+       * @brief Inline stored bytes (empty when stored in the blob file).
+       */
+      vix::sync::Payload payload;
+
+      /**
+       * @brief Size of the original bytes, wherever they are stored.
+       */
+      std::size_t size{0};
+
+      /**
+       * @brief Codec of the stored bytes.
+       */
+      vix::sync::CodecId codec{vix::sync::CodecId::None};
+
+      /**
+       * @brief Number of operations referencing the content.
+       */
+      std::size_t refs{0};
+
+      /**
+       * @brief Content hash.
+       */
+      std::uint64_t hash{0};
+    };
+
+    /**
+     * @brief Shared payloads by content id (hash, plus a suffix on collision).
+     */
+    std::unordered_map<std::string, Content> contents_;
+
+    /**
+     * @brief Content ids by hash.
+     */
+    std::unordered_multimap<std::uint64_t, std::string> content_by_hash_;
+
+    /**
+     * @brief Operation id to content id, for deduplicated payloads.
+     */
+    std::unordered_map<std::string, std::string> op_content_;
+
+    /**
+     * @brief Out-of-line payload storage, created on first use.
+     */
+    struct BlobState;
+    std::unique_ptr<BlobState> blobs_;
   };
 
 } // namespace vix::sync::outbox
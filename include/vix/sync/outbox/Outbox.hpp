@@ -16,17 +16,37 @@
 #ifndef VIX_OUTBOX_HPP
 #define VIX_OUTBOX_HPP
 
+#include <condition_variable>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+#include <vix/sync/Clock.hpp>
+#include <vix/sync/Metrics.hpp>
 #include <vix/sync/Operation.hpp>
 #include <vix/sync/RetryPolicy.hpp>
+#include <vix/sync/Tracer.hpp>
+#include <vix/sync/outbox/DeadLetterStore.hpp>
 #include <vix/sync/outbox/OutboxStore.hpp>
 
 namespace vix::sync::outbox
 {
+  /**
+   * @brief Error thrown by Outbox::enqueue() when the outbox is full.
+   *
+   * Raised by the Reject policy, by Block after its timeout, and by
+   * DropOldest when no operation of lower or equal priority can be dropped.
+   */
+  class OutboxFullError : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
   /**
    * @brief Durable outbox coordinating retry, idempotency and ownership.
    *
@@ -45,6 +65,94 @@ namespace vix::sync::outbox
   class Outbox
   {
   public:
+    /**
+     * @brief When superseded operations are coalesced.
+     */
+    enum class CoalesceMode : std::uint8_t
+    {
+      /**
+       * @brief Every operation is delivered.
+       */
+      Disabled = 0,
+
+      /**
+       * @brief enqueue() removes older pending operations with the same key.
+       */
+      OnEnqueue,
+
+      /**
+       * @brief peek_ready() drops candidates superseded by a newer operation.
+       *
+       * The outbox still records every operation, but only the latest one
+       * per key is sent.
+       */
+      OnClaim
+    };
+
+    /**
+     * @brief What enqueue() does when the outbox is full.
+     */
+    enum class OverflowPolicy : std::uint8_t
+    {
+      /**
+       * @brief Wait until the outbox drains, up to block_timeout_ms.
+       */
+      Block = 0,
+
+      /**
+       * @brief Throw OutboxFullError immediately.
+       */
+      Reject,
+
+      /**
+       * @brief Drop the oldest operations of the lowest priority to make room.
+       *
+       * Only operations with a priority lower than or equal to the incoming
+       * one are dropped; in-flight operations are never dropped.
+       */
+      DropOldest
+    };
+
+    /**
+     * @brief Bounds on the live outbox size.
+     *
+     * A limit of 0 is unbounded. Once a high watermark is reached the outbox
+     * is considered full until the depth falls back to the low watermarks
+     * (a low watermark of 0 means the high one). Depth checks are O(1).
+     */
+    struct Backpressure
+    {
+      /**
+       * @brief Live operation count at which the outbox becomes full.
+       */
+      std::size_t high_water_ops{0};
+
+      /**
+       * @brief Live operation count at which a full outbox accepts work again.
+       */
+      std::size_t low_water_ops{0};
+
+      /**
+       * @brief Live byte footprint at which the outbox becomes full.
+       */
+      std::size_t high_water_bytes{0};
+
+      /**
+       * @brief Live byte footprint at which a full outbox accepts work again.
+       */
+      std::size_t low_water_bytes{0};
+
+      /**
+       * @brief Behavior of enqueue() on a full outbox.
+       */
+      OverflowPolicy policy{OverflowPolicy::Reject};
+
+      /**
+       * @brief Maximum wait of the Block policy in milliseconds.
+       */
+      std::int64_t block_timeout_ms{1'000};
+    };
+
     /**
      * @brief Configuration for the Outbox.
      */
@@ -71,6 +179,79 @@ namespace vix::sync::outbox
        * @brief Automatically generate an idempotency key if missing.
        */
       bool auto_generate_idempotency_key{true};
+
+      /**
+       * @brief Detect duplicate enqueues by idempotency key.
+       *
+       * When true, enqueuing an operation whose caller-supplied idempotency
+       * key is already owned (live, or terminal within the store's retention
+       * window) persists nothing and returns the existing id.
+       */
+      bool dedupe_idempotency_keys{true};
+
+      /**
+       * @brief Priority aging window used by peek_ready().
+       *
+       * See ListOptions::priority_aging_ms. 0 disables aging.
+       */
+      std::int64_t priority_aging_ms{0};
+
+      /**
+       * @brief Coalescing of operations sharing a coalesce key.
+       */
+      CoalesceMode coalesce{CoalesceMode::Disabled};
+
+      /**
+       * @brief Derive a missing coalesce key from kind and target.
+       *
+       * When false, only operations with an explicit coalesce key are
+       * coalesced.
+       */
+      bool coalesce_by_kind_target{true};
+
+      /**
+       * @brief Default time-to-live applied by enqueue() in milliseconds.
+       *
+       * Sets Operation::deadline_at_ms when the operation has none.
+       * 0 means operations never expire unless they carry a deadline.
+       */
+      std::int64_t default_ttl_ms{0};
+
+      /**
+       * @brief Live size bounds and overflow behavior of enqueue().
+       */
+      Backpressure backpressure{};
+
+      /**
+       * @brief Destination of permanently failed operations.
+       *
+       * When set, operations that fail permanently are moved out of the
+       * outbox store into this store. When null, they stay in the outbox
+       * as PermanentFailed.
+       */
+      std::shared_ptr<DeadLetterStore> dead_letter{};
+
+      /**
+       * @brief Time source for calls that do not pass a time explicitly.
+       *
+       * Null selects vix::sync::default_clock(). Timestamps passed to the
+       * other methods should come from the same clock.
+       */
+      std::shared_ptr<vix::sync::Clock> clock{};
+
+      /**
+       * @brief Metrics updated by the outbox and the workers using it.
+       *
+       * Null disables metrics.
+       */
+      std::shared_ptr<vix::sync::SyncMetrics> metrics{};
+
+      /**
+       * @brief Lifecycle tracer fed by the outbox and its workers.
+       *
+       * Null disables tracing.
+       */
+      std::shared_ptr<vix::sync::Tracer> tracer{};
     };
 
     /**
@@ -86,26 +267,44 @@ namespace vix::sync::outbox
      *
      * This persists the operation before it becomes eligible for sending.
      * Missing identifiers may be generated according to configuration.
+     * With CoalesceMode::OnEnqueue, older pending operations sharing the
+     * coalesce key are removed.
+     *
+     * When backpressure limits are configured and the outbox is full, the
+     * overflow policy applies (wait, reject, or drop older operations).
+     *
+     * With dedupe_idempotency_keys, a duplicate of an already enqueued
+     * operation (same idempotency key) is not persisted again.
      *
      * @param op Operation to enqueue.
      * @param now_ms Current time in milliseconds.
-     * @return Operation identifier.
+     * @return Operation identifier, or the existing one for a duplicate.
+     * @throws OutboxFullError if the operation cannot be accepted.
      */
     std::string enqueue(vix::sync::Operation op, std::int64_t now_ms);
 
+    /**
+     * @brief Enqueue a new operation at the current time of the clock.
+     */
+    std::string enqueue(vix::sync::Operation op) { return enqueue(std::move(op), now_ms()); }
+
     /**
      * @brief Inspect operations ready to be processed.
      *
      * This does not claim the operations; it only returns candidates that
-     * satisfy retry timing and state conditions.
+     * satisfy retry timing and state conditions, highest priority first.
+     * With CoalesceMode::OnClaim, superseded candidates are removed from the
+     * store and not returned.
      *
      * @param now_ms Current time in milliseconds.
      * @param limit Maximum number of operations to return.
+     * @param skip Candidates to pass over (see ListOptions::skip).
      * @return Vector of ready operations.
      */
     std::vector<vix::sync::Operation> peek_ready(
         std::int64_t now_ms,
-        std::size_t limit = 50);
+        std::size_t limit = 50,
+        std::function<bool(const vix::sync::Operation &)> skip = {});
 
     /**
      * @brief Claim an operation for processing.
@@ -129,7 +328,8 @@ namespace vix::sync::outbox
      * @brief Mark an operation as failed.
      *
      * Depending on retryable and RetryPolicy, the operation may be scheduled
-     * for retry or marked as permanently failed.
+     * for retry or marked as permanently failed. Permanently failed
+     * operations are moved to the dead-letter store when one is configured.
      *
      * @param id Operation identifier.
      * @param error Error message for diagnostics.
@@ -143,6 +343,74 @@ namespace vix::sync::outbox
         std::int64_t now_ms,
         bool retryable = true);
 
+    /**
+     * @brief Move operations past their deadline to Expired.
+     *
+     * @param now_ms Current time in milliseconds.
+     * @return Number of operations expired.
+     */
+    std::size_t expire(std::int64_t now_ms);
+
+    /**
+     * @brief Move a dead-lettered operation back into the outbox.
+     *
+     * The operation is reset to Pending with a fresh attempt counter and
+     * becomes ready immediately. It keeps its id and idempotency key.
+     *
+     * @param id Operation identifier.
+     * @param now_ms Current time in milliseconds.
+     * @return true if the operation was found in the dead-letter store.
+     * @throws OutboxFullError if the outbox is full.
+     */
+    bool redrive(const std::string &id, std::int64_t now_ms);
+
+    /**
+     * @brief Redrive every dead-lettered operation matching q.
+     *
+     * q.limit bounds how many operations are redriven; q.offset is ignored.
+     *
+     * @param q Selection of operations to redrive.
+     * @param now_ms Current time in milliseconds.
+     * @return Number of redriven operations.
+     * @throws OutboxFullError if the outbox fills up while redriving.
+     */
+    std::size_t redrive_all(const DeadLetterQuery &q, std::int64_t now_ms);
+
+    /**
+     * @brief Access the dead-letter store (may be null).
+     */
+    std::shared_ptr<DeadLetterStore> dead_letters() const noexcept { return cfg_.dead_letter; }
+
+    /**
+     * @brief Clock of the outbox.
+     */
+    std::shared_ptr<vix::sync::Clock> clock() const noexcept { return cfg_.clock; }
+
+    /**
+     * @brief Current time of the outbox clock.
+     */
+    std::int64_t now_ms() const noexcept { return cfg_.clock->now_ms(); }
+
+    /**
+     * @brief Metrics of the outbox (may be null).
+     */
+    std::shared_ptr<vix::sync::SyncMetrics> metrics() const noexcept { return cfg_.metrics; }
+
+    /**
+     * @brief Lifecycle tracer of the outbox (may be null).
+     */
+    std::shared_ptr<vix::sync::Tracer> tracer() const noexcept { return cfg_.tracer; }
+
+    /**
+     * @brief Current live depth of the outbox.
+     */
+    OutboxDepth depth() { return store_->depth(); }
+
+    /**
+     * @brief Number of live operations per priority.
+     */
+    std::map<std::int32_t, std::size_t> depth_by_priority() { return store_->depth_by_priority(); }
+
     /**
      * @brief Access the underlying store.
      */
@@ -154,8 +422,16 @@ namespace vix::sync::outbox
     const Config &config() const noexcept { return cfg_; }
 
   private:
+    /**
+     * @brief enqueue() with explicit control of idempotency dedup.
+     */
+    std::string enqueue_(vix::sync::Operation op, std::int64_t now_ms, bool dedupe);
+
     /**
      * @brief Generate a unique operation identifier.
+     *
+     * Identifiers are "op_" followed by an OperationId, so ids generated by
+     * one thread sort in enqueue order.
      */
     static std::string make_id();
 
@@ -164,6 +440,31 @@ namespace vix::sync::outbox
      */
     static std::string make_idempotency_key();
 
+    /**
+     * @brief Whether backpressure limits are configured.
+     */
+    bool bounded_() const noexcept;
+
+    /**
+     * @brief Apply the overflow policy before accepting op.
+     *
+     * lk must own bp_mu_; it stays locked on return so that the caller can
+     * persist op before another producer checks the depth.
+     *
+     * @throws OutboxFullError if the operation cannot be accepted.
+     */
+    void reserve_room_(const vix::sync::Operation &op, std::unique_lock<std::mutex> &lk);
+
+    /**
+     * @brief Check the watermarks, updating the full flag (bp_mu_ held).
+     */
+    bool is_full_locked_(std::size_t incoming_bytes);
+
+    /**
+     * @brief Wake up producers blocked on a full outbox.
+     */
+    void notify_drained_();
+
   private:
     /**
      * @brief Stored configuration.
@@ -174,6 +475,21 @@ namespace vix::sync::outbox
      * @brief Persistent store backing the outbox.
      */
     std::shared_ptr<OutboxStore> store_;
+
+    /**
+     * @brief Mutex protecting the backpressure state.
+     */
+    std::mutex bp_mu_;
+
+    /**
+     * @brief Signaled when operations leave the live outbox.
+     */
+    std::condition_variable bp_cv_;
+
+    /**
+     * @brief True between reaching a high watermark and draining to the low one.
+     */
+    bool full_{false};
   };
 
 } // namespace vix::sync::outbox
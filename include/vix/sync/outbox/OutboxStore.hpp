@@ -17,6 +17,8 @@
 #define VIX_OUTBOX_STORE_HPP
 
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <optional>
 #include <string>
 #include <vector>
@@ -49,6 +51,7 @@ namespace vix::sync::outbox
      * @brief Only return operations that are ready to be processed.
      *
      * When true, operations that are waiting for retry are excluded.
+     * Operations whose deadline has passed are never returned.
      */
     bool only_ready{true};
 
@@ -56,6 +59,44 @@ namespace vix::sync::outbox
      * @brief Include operations currently marked as in-flight.
      */
     bool include_inflight{false};
+
+    /**
+     * @brief Priority aging window in milliseconds.
+     *
+     * Operations are returned by descending priority, then creation order.
+     * When non-zero, every aging window an operation has waited counts as
+     * one extra priority level, so low-priority work cannot starve.
+     */
+    std::int64_t priority_aging_ms{0};
+
+    /**
+     * @brief Candidates to pass over.
+     *
+     * When set, operations for which skip returns true are left out and do
+     * not count toward limit, so the listing reads further into the queue.
+     * Called with the store lock held: it must not call back into the store.
+     */
+    std::function<bool(const vix::sync::Operation &)> skip;
+  };
+
+  /**
+   * @brief Size of the live part of an outbox.
+   *
+   * Live operations are those not yet Done, PermanentFailed or Expired.
+   */
+  struct OutboxDepth
+  {
+    /**
+     * @brief Number of live operations.
+     */
+    std::size_t ops{0};
+
+    /**
+     * @brief Approximate memory/disk footprint of live operations in bytes.
+     *
+     * Counts payload, identifiers, kind, target and keys.
+     */
+    std::size_t bytes{0};
   };
 
   /**
@@ -147,7 +188,7 @@ namespace vix::sync::outbox
         std::int64_t next_retry_at_ms) = 0;
 
     /**
-     * @brief Remove completed operations older than a given threshold.
+     * @brief Remove completed and expired operations older than a given threshold.
      *
      * @param older_than_ms Cutoff time in milliseconds.
      * @return Number of pruned operations.
@@ -181,6 +222,150 @@ namespace vix::sync::outbox
     virtual std::size_t requeue_inflight_older_than(
         std::int64_t now_ms,
         std::int64_t timeout_ms) = 0;
+
+    /**
+     * @brief Number of live operations per priority.
+     *
+     * Live operations are those not yet Done, PermanentFailed or Expired,
+     * the same ones depth() counts. The default implementation reports
+     * nothing.
+     *
+     * @return Queue depth keyed by Operation::priority.
+     */
+    virtual std::map<std::int32_t, std::size_t> depth_by_priority() { return {}; }
+
+    /**
+     * @brief Move operations whose deadline has passed to Expired.
+     *
+     * In-flight operations are left alone; they are expired by a later sweep
+     * once they fail.
+     *
+     * The default implementation does nothing.
+     *
+     * @param now_ms Current time in milliseconds.
+     * @return Number of operations expired.
+     */
+    virtual std::size_t expire_due(std::int64_t now_ms)
+    {
+      (void)now_ms;
+      return 0;
+    }
+
+    /**
+     * @brief Current live depth of the store.
+     *
+     * Implementations are expected to answer in O(1). Outbox backpressure
+     * and the queue depth metrics rely on it, so there is no default.
+     */
+    virtual OutboxDepth depth() = 0;
+
+    /**
+     * @brief Total number of bytes written to persistent storage so far.
+     *
+     * A monotonically increasing counter, sampled before and after a unit of
+     * work to measure its write volume. The default implementation reports 0.
+     */
+    virtual std::uint64_t bytes_written() const noexcept { return 0; }
+
+    /**
+     * @brief Drop live operations until the depth fits within limits.
+     *
+     * Victims are taken from the lowest priority first, oldest first within
+     * a priority, never above max_priority and never in-flight.
+     *
+     * The default implementation drops nothing.
+     *
+     * @param max_ops Live operation count to get under (inclusive).
+     * @param max_bytes Live byte footprint to get under (inclusive, 0 = ignore).
+     * @param max_priority Highest priority that may be dropped.
+     * @return Number of dropped operations.
+     */
+    virtual std::size_t shed(
+        std::size_t max_ops,
+        std::size_t max_bytes,
+        std::int32_t max_priority)
+    {
+      (void)max_ops;
+      (void)max_bytes;
+      (void)max_priority;
+      return 0;
+    }
+
+    /**
+     * @brief Drop operations superseded by a newer one with the same key.
+     *
+     * Keeps the most recently created live operation carrying coalesce_key
+     * and removes the older ones, except those currently in-flight.
+     *
+     * The default implementation does nothing.
+     *
+     * @param coalesce_key Operation::coalesce_key to coalesce.
+     * @param now_ms Current time in milliseconds.
+     * @return Identifiers of the removed operations.
+     */
+    virtual std::vector<std::string> coalesce(
+        const std::string &coalesce_key,
+        std::int64_t now_ms)
+    {
+      (void)coalesce_key;
+      (void)now_ms;
+      return {};
+    }
+
+    /**
+     * @brief Remove an operation from the store, whatever its status.
+     *
+     * Used to move terminal operations out of the outbox (e.g. into a
+     * DeadLetterStore). The outbox relies on it to not keep a second
+     * copy of dead-lettered operations, so there is no default.
+     *
+     * @param id Operation identifier.
+     * @return The removed operation, if it was found.
+     */
+    virtual std::optional<vix::sync::Operation> remove(const std::string &id) = 0;
+
+    /**
+     * @brief Find the operation owning an idempotency key.
+     *
+     * Live operations always own their key. Once an operation reaches a
+     * terminal status, implementations may keep the key for a bounded
+     * retention window, even after the operation itself is pruned.
+     *
+     * The default implementation finds nothing.
+     *
+     * @param idempotency_key Operation::idempotency_key to look up.
+     * @param now_ms Current time in milliseconds.
+     * @return Identifier of the owning operation, if any.
+     */
+    virtual std::optional<std::string> find_by_idempotency_key(
+        const std::string &idempotency_key,
+        std::int64_t now_ms)
+    {
+      (void)idempotency_key;
+      (void)now_ms;
+      return std::nullopt;
+    }
+
+    /**
+     * @brief Insert op unless its idempotency key is already owned.
+     *
+     * Implementations should make the check and the insert atomic. The
+     * default implementation combines find_by_idempotency_key() and put().
+     *
+     * @param op Operation to persist.
+     * @param now_ms Current time in milliseconds.
+     * @return op.id if inserted, otherwise the id of the existing operation.
+     */
+    virtual std::string put_idempotent(const vix::sync::Operation &op, std::int64_t now_ms)
+    {
+      if (!op.idempotency_key.empty())
+      {
+        if (auto existing = find_by_idempotency_key(op.idempotency_key, now_ms))
+          return *existing;
+      }
+      put(op);
+      return op.id;
+    }
   };
 
 } // namespace vix::sync::outbox
@@ -20,6 +20,7 @@
 #include <filesystem>
 #include <functional>
 
+#include <vix/sync/Codec.hpp>
 #include <vix/sync/wal/WalRecord.hpp>
 
 namespace vix::sync::wal
@@ -58,6 +59,13 @@ namespace vix::sync::wal
        * of write performance.
        */
       bool fsync_on_write{false};
+
+      /**
+       * @brief Payload compression applied by append().
+       *
+       * Replay decompresses transparently regardless of this setting.
+       */
+      vix::sync::Compression compression{};
     };
 
     /**
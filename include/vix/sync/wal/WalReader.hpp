@@ -59,7 +59,11 @@ namespace vix::sync::wal
     /**
      * @brief Read the next record from the WAL.
      *
+     * Compressed payloads are returned decompressed.
+     *
      * @return Optional WalRecord if available, or std::nullopt on EOF.
+     * @throws std::runtime_error if the payload codec is not built in or
+     * the compressed bytes are corrupted.
      */
     std::optional<WalRecord> next();
 
@@ -20,6 +20,7 @@
 #include <filesystem>
 #include <fstream>
 
+#include <vix/sync/Codec.hpp>
 #include <vix/sync/wal/WalRecord.hpp>
 
 namespace vix::sync::wal
@@ -53,6 +54,15 @@ namespace vix::sync::wal
        * cost of write performance.
        */
       bool fsync_on_write{false};
+
+      /**
+       * @brief Payload compression.
+       *
+       * A compressed record sets the codec id in the low bits of the header
+       * flags byte; its payload body is the raw length (u32) followed by the
+       * compressed bytes. Records with flags 0 keep the original layout.
+       */
+      vix::sync::Compression compression{};
     };
 
     /**
@@ -84,7 +94,7 @@ namespace vix::sync::wal
     /**
      * @brief Flush buffered data to disk.
      *
-     * If fsync_on_write is enabled, this may also force data to be
+     * If fsync_on_write is enabled, this also forces data to be
      * persisted to stable storage.
      */
     void flush();
@@ -110,6 +120,11 @@ namespace vix::sync::wal
      * @brief Output file stream used for writing.
      */
     std::ofstream out_;
+
+    /**
+     * @brief Descriptor used to fsync the file (-1 when fsync is disabled).
+     */
+    int sync_fd_{-1};
   };
 
 } // namespace vix::sync::wal
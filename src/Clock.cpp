@@ -0,0 +1,54 @@
+/**
+ *
+ *  @file Clock.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/sync/Clock.hpp>
+
+#include <chrono>
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+namespace vix::sync
+{
+
+  std::int64_t MonotonicClock::now_ms() const noexcept
+  {
+#if defined(__linux__) && defined(CLOCK_MONOTONIC_COARSE)
+    timespec ts{};
+    if (::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == 0)
+      return static_cast<std::int64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1'000'000;
+#endif
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+  }
+
+  WallClock::WallClock()
+  {
+    using namespace std::chrono;
+    wall_anchor_ms_ = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+    mono_anchor_ms_ = mono_.now_ms();
+  }
+
+  std::int64_t WallClock::now_ms() const noexcept
+  {
+    return wall_anchor_ms_ + (mono_.now_ms() - mono_anchor_ms_);
+  }
+
+  std::shared_ptr<Clock> default_clock()
+  {
+    static const auto clock = std::make_shared<WallClock>();
+    return clock;
+  }
+
+} // namespace vix::sync
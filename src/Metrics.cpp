@@ -0,0 +1,476 @@
+/**
+ *
+ *  @file Metrics.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/sync/Metrics.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include "outbox/AtomicFile.hpp"
+
+namespace vix::sync
+{
+  namespace detail
+  {
+    std::size_t metric_shard() noexcept
+    {
+      static std::atomic<std::size_t> next{0};
+      thread_local const std::size_t shard =
+          next.fetch_add(1, std::memory_order_relaxed) & (kMetricShards - 1);
+      return shard;
+    }
+
+    static bool valid_metric_name(std::string_view name) noexcept
+    {
+      if (name.empty())
+        return false;
+      for (std::size_t i = 0; i < name.size(); ++i)
+      {
+        const char c = name[i];
+        const bool alpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':';
+        const bool digit = c >= '0' && c <= '9';
+        if (!alpha && !(digit && i > 0))
+          return false;
+      }
+      return true;
+    }
+
+    static std::string escape_help(std::string_view s)
+    {
+      std::string out;
+      out.reserve(s.size());
+      for (const char c : s)
+      {
+        if (c == '\\')
+          out += "\\\\";
+        else if (c == '\n')
+          out += "\\n";
+        else
+          out.push_back(c);
+      }
+      return out;
+    }
+
+    static std::string escape_label_value(std::string_view s)
+    {
+      std::string out;
+      out.reserve(s.size());
+      for (const char c : s)
+      {
+        if (c == '\\')
+          out += "\\\\";
+        else if (c == '"')
+          out += "\\\"";
+        else if (c == '\n')
+          out += "\\n";
+        else
+          out.push_back(c);
+      }
+      return out;
+    }
+
+    static std::string format_double(double v)
+    {
+      std::ostringstream os;
+      os.precision(17);
+      os << v;
+      return os.str();
+    }
+  } // namespace detail
+
+  std::uint64_t Counter::value() const noexcept
+  {
+    std::uint64_t n = 0;
+    for (const auto &s : shards_)
+      n += s.v.load(std::memory_order_relaxed);
+    return n;
+  }
+
+  void GaugeVec::set_all(Series series)
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    series_ = std::move(series);
+  }
+
+  GaugeVec::Series GaugeVec::values() const
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    return series_;
+  }
+
+  // ---------------------------------------------------------------------------
+  // Histogram
+  // ---------------------------------------------------------------------------
+
+  Histogram::Histogram()
+      : shards_(new Shard[detail::kMetricShards]())
+  {
+  }
+
+  std::size_t Histogram::bucket_index(std::uint64_t v) noexcept
+  {
+    constexpr std::uint64_t sub = std::uint64_t{1} << kSubBits;
+    constexpr std::uint64_t top = (std::uint64_t{1} << kMaxBits) - 1;
+
+    if (v < sub)
+      return static_cast<std::size_t>(v);
+    v = std::min(v, top);
+
+    const unsigned e = static_cast<unsigned>(std::bit_width(v)) - 1;
+    return static_cast<std::size_t>(((e - kSubBits + 1) << kSubBits) + ((v >> (e - kSubBits)) - sub));
+  }
+
+  std::uint64_t Histogram::bucket_lower(std::size_t i) noexcept
+  {
+    constexpr std::size_t sub = std::size_t{1} << kSubBits;
+    if (i < sub)
+      return i;
+
+    const unsigned e = static_cast<unsigned>(i >> kSubBits) + kSubBits - 1;
+    return static_cast<std::uint64_t>(sub + (i & (sub - 1))) << (e - kSubBits);
+  }
+
+  std::uint64_t Histogram::bucket_upper(std::size_t i) noexcept
+  {
+    constexpr std::size_t sub = std::size_t{1} << kSubBits;
+    if (i < sub)
+      return i + 1;
+
+    const unsigned e = static_cast<unsigned>(i >> kSubBits) + kSubBits - 1;
+    return static_cast<std::uint64_t>(sub + (i & (sub - 1)) + 1) << (e - kSubBits);
+  }
+
+  void Histogram::record(std::uint64_t v) noexcept
+  {
+    auto &s = shards_[detail::metric_shard()];
+    s.buckets[bucket_index(v)].fetch_add(1, std::memory_order_relaxed);
+    s.sum.fetch_add(v, std::memory_order_relaxed);
+
+    auto cur = s.max.load(std::memory_order_relaxed);
+    while (v > cur && !s.max.compare_exchange_weak(cur, v, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  HistogramSnapshot Histogram::snapshot() const
+  {
+    HistogramSnapshot out;
+    out.buckets.assign(kBuckets, 0);
+
+    for (std::size_t k = 0; k < detail::kMetricShards; ++k)
+    {
+      const auto &s = shards_[k];
+      out.sum += s.sum.load(std::memory_order_relaxed);
+      out.max = std::max(out.max, s.max.load(std::memory_order_relaxed));
+      for (std::size_t i = 0; i < kBuckets; ++i)
+      {
+        const auto n = s.buckets[i].load(std::memory_order_relaxed);
+        out.buckets[i] += n;
+        out.count += n;
+      }
+    }
+    return out;
+  }
+
+  double HistogramSnapshot::mean() const noexcept
+  {
+    return count == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(count);
+  }
+
+  std::uint64_t HistogramSnapshot::percentile(double q) const noexcept
+  {
+    if (count == 0)
+      return 0;
+
+    q = std::clamp(q, 0.0, 1.0);
+    const auto rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count))));
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+    {
+      seen += buckets[i];
+      if (seen >= rank)
+        return std::min(Histogram::bucket_upper(i) - 1, max);
+    }
+    return max;
+  }
+
+  std::uint64_t HistogramSnapshot::count_at_or_below(std::uint64_t v) const noexcept
+  {
+    std::uint64_t n = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+    {
+      if (Histogram::bucket_lower(i) > v)
+        break;
+      n += buckets[i];
+    }
+    return n;
+  }
+
+  // ---------------------------------------------------------------------------
+  // Snapshot
+  // ---------------------------------------------------------------------------
+
+  std::uint64_t MetricsSnapshot::counter(std::string_view name) const noexcept
+  {
+    for (const auto &c : counters)
+    {
+      if (c.name == name)
+        return c.value;
+    }
+    return 0;
+  }
+
+  std::int64_t MetricsSnapshot::gauge(std::string_view name) const noexcept
+  {
+    for (const auto &g : gauges)
+    {
+      if (g.name == name)
+        return g.value;
+    }
+    return 0;
+  }
+
+  const GaugeVec::Series *MetricsSnapshot::gauge_vec(std::string_view name) const noexcept
+  {
+    for (const auto &g : gauge_vecs)
+    {
+      if (g.name == name)
+        return &g.series;
+    }
+    return nullptr;
+  }
+
+  const HistogramSnapshot *MetricsSnapshot::histogram(std::string_view name) const noexcept
+  {
+    for (const auto &h : histograms)
+    {
+      if (h.name == name)
+        return &h.data;
+    }
+    return nullptr;
+  }
+
+  std::string MetricsSnapshot::to_prometheus() const
+  {
+    std::string out;
+
+    auto header = [&](const std::string &name, const std::string &help, const char *type)
+    {
+      if (!help.empty())
+        out += "# HELP " + name + " " + detail::escape_help(help) + "\n";
+      out += "# TYPE " + name + " " + type + "\n";
+    };
+
+    for (const auto &c : counters)
+    {
+      header(c.name, c.help, "counter");
+      out += c.name + " " + std::to_string(c.value) + "\n";
+    }
+
+    for (const auto &g : gauges)
+    {
+      header(g.name, g.help, "gauge");
+      out += g.name + " " + std::to_string(g.value) + "\n";
+    }
+
+    for (const auto &g : gauge_vecs)
+    {
+      header(g.name, g.help, "gauge");
+      for (const auto &[value, v] : g.series)
+      {
+        out += g.name + "{" + g.label + "=\"" + detail::escape_label_value(value) + "\"} " +
+               detail::format_double(v) + "\n";
+      }
+    }
+
+    for (const auto &h : histograms)
+    {
+      header(h.name, h.help, "histogram");
+
+      // Cumulative counts at every power of two: a fixed set of buckets, so
+      // series stay stable from one scrape to the next.
+      const auto &d = h.data;
+      for (unsigned k = 0; k <= Histogram::kMaxBits; ++k)
+      {
+        const std::uint64_t bound = (std::uint64_t{1} << k) - 1;
+        const double le = static_cast<double>(bound) * h.scale;
+        out += h.name + "_bucket{le=\"" + detail::format_double(le) + "\"} " +
+               std::to_string(d.count_at_or_below(bound)) + "\n";
+      }
+      out += h.name + "_bucket{le=\"+Inf\"} " + std::to_string(d.count) + "\n";
+      out += h.name + "_sum " + detail::format_double(static_cast<double>(d.sum) * h.scale) + "\n";
+      out += h.name + "_count " + std::to_string(d.count) + "\n";
+    }
+
+    return out;
+  }
+
+  // ---------------------------------------------------------------------------
+  // Registry
+  // ---------------------------------------------------------------------------
+
+  MetricsRegistry::Entry &MetricsRegistry::entry_(const std::string &name, Type type, std::string help)
+  {
+    auto it = entries_.find(name);
+    if (it != entries_.end())
+    {
+      if (it->second.type != type)
+        throw std::invalid_argument("MetricsRegistry: '" + name + "' already registered with another type");
+      return it->second;
+    }
+
+    if (!detail::valid_metric_name(name))
+      throw std::invalid_argument("MetricsRegistry: invalid metric name '" + name + "'");
+
+    Entry e;
+    e.type = type;
+    e.help = std::move(help);
+    return entries_.emplace(name, std::move(e)).first->second;
+  }
+
+  Counter &MetricsRegistry::counter(const std::string &name, std::string help)
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+
+    auto &e = entry_(name, Type::Counter, std::move(help));
+    if (!e.counter)
+      e.counter = std::make_unique<Counter>();
+    return *e.counter;
+  }
+
+  Gauge &MetricsRegistry::gauge(const std::string &name, std::string help)
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+
+    auto &e = entry_(name, Type::Gauge, std::move(help));
+    if (!e.gauge)
+      e.gauge = std::make_unique<Gauge>();
+    return *e.gauge;
+  }
+
+  GaugeVec &MetricsRegistry::gauge_vec(const std::string &name, const std::string &label, std::string help)
+  {
+    // Label names follow the metric name syntax, minus ':'.
+    if (!detail::valid_metric_name(label) || label.find(':') != std::string::npos)
+      throw std::invalid_argument("MetricsRegistry: invalid label name '" + label + "'");
+
+    std::lock_guard<std::mutex> lk(mu_);
+
+    auto &e = entry_(name, Type::GaugeVec, std::move(help));
+    if (!e.gauge_vec)
+    {
+      e.gauge_vec = std::make_unique<GaugeVec>();
+      e.label = label;
+    }
+    return *e.gauge_vec;
+  }
+
+  Histogram &MetricsRegistry::histogram(const std::string &name, std::string help, double scale)
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+
+    auto &e = entry_(name, Type::Histogram, std::move(help));
+    if (!e.histogram)
+    {
+      e.histogram = std::make_unique<Histogram>();
+      e.scale = scale;
+    }
+    return *e.histogram;
+  }
+
+  MetricsSnapshot MetricsRegistry::snapshot() const
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+
+    MetricsSnapshot out;
+    for (const auto &[name, e] : entries_)
+    {
+      switch (e.type)
+      {
+      case Type::Counter:
+        out.counters.push_back({name, e.help, e.counter->value()});
+        break;
+      case Type::Gauge:
+        out.gauges.push_back({name, e.help, e.gauge->value()});
+        break;
+      case Type::GaugeVec:
+        out.gauge_vecs.push_back({name, e.help, e.label, e.gauge_vec->values()});
+        break;
+      case Type::Histogram:
+        out.histograms.push_back({name, e.help, e.scale, e.histogram->snapshot()});
+        break;
+      }
+    }
+    return out;
+  }
+
+  std::string MetricsRegistry::to_prometheus() const
+  {
+    return snapshot().to_prometheus();
+  }
+
+  void MetricsRegistry::write_prometheus(const std::filesystem::path &path) const
+  {
+    const auto text = to_prometheus();
+
+    if (path.has_parent_path())
+      std::filesystem::create_directories(path.parent_path());
+
+    std::lock_guard<std::mutex> lk(write_mu_);
+    outbox::detail::write_file_atomic(path, text, /*sync*/ false);
+  }
+
+  // ---------------------------------------------------------------------------
+  // SyncMetrics
+  // ---------------------------------------------------------------------------
+
+  static std::shared_ptr<MetricsRegistry> or_new(std::shared_ptr<MetricsRegistry> r)
+  {
+    return r ? std::move(r) : std::make_shared<MetricsRegistry>();
+  }
+
+  SyncMetrics::SyncMetrics(std::shared_ptr<MetricsRegistry> registry)
+      : registry_(or_new(std::move(registry))),
+        enqueued(registry_->counter("vix_sync_enqueued_total", "Operations persisted by Outbox::enqueue")),
+        enqueue_duplicates(registry_->counter("vix_sync_enqueue_duplicates_total", "Enqueues answered by idempotency-key dedup")),
+        enqueue_latency(registry_->histogram("vix_sync_enqueue_seconds", "Duration of Outbox::enqueue", 1e-9)),
+        claimed(registry_->counter("vix_sync_claimed_total", "Operations claimed for sending")),
+        claims_lost(registry_->counter("vix_sync_claims_lost_total", "Claims lost to another worker")),
+        claim_latency(registry_->histogram("vix_sync_claim_seconds", "Duration of Outbox::claim", 1e-9)),
+        sent(registry_->counter("vix_sync_sent_total", "Operations handed to the transport")),
+        send_batches(registry_->counter("vix_sync_send_batches_total", "Transport send_batch calls")),
+        send_latency(registry_->histogram("vix_sync_send_seconds", "Duration of one transport send_batch call", 1e-9)),
+        completed(registry_->counter("vix_sync_completed_total", "Operations completed")),
+        complete_latency(registry_->histogram("vix_sync_complete_seconds", "Duration of Outbox::complete", 1e-9)),
+        failed(registry_->counter("vix_sync_failed_total", "Retryable send failures")),
+        failed_permanent(registry_->counter("vix_sync_failed_permanent_total", "Permanent send failures")),
+        fail_latency(registry_->histogram("vix_sync_fail_seconds", "Duration of Outbox::fail", 1e-9)),
+        requeued(registry_->counter("vix_sync_requeued_total", "In-flight operations requeued after a timeout")),
+        expired(registry_->counter("vix_sync_expired_total", "Operations expired past their deadline")),
+        queue_depth(registry_->gauge("vix_sync_queue_depth", "Live operations in the outbox")),
+        queue_bytes(registry_->gauge("vix_sync_queue_bytes", "Live byte footprint of the outbox")),
+        queue_depth_by_priority(registry_->gauge_vec("vix_sync_queue_depth_by_priority", "priority", "Live operations in the outbox per priority")),
+        concurrency_limit(registry_->gauge_vec("vix_sync_concurrency_limit", "target", "Adaptive in-flight limit per target")),
+        store_flushes(registry_->counter("vix_sync_store_flushes_total", "Store file rewrites")),
+        store_flush_bytes(registry_->counter("vix_sync_store_flush_bytes_total", "Bytes written by store file rewrites")),
+        store_ops_encoded(registry_->counter("vix_sync_store_ops_encoded_total", "Operations re-encoded by store file rewrites")),
+        store_flush_latency(registry_->histogram("vix_sync_store_flush_seconds", "Duration of one store file rewrite", 1e-9))
+  {
+  }
+
+} // namespace vix::sync
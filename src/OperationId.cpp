@@ -0,0 +1,185 @@
+/**
+ *
+ *  @file OperationId.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/sync/OperationId.hpp>
+
+#include <chrono>
+#include <functional>
+#include <random>
+#include <thread>
+
+namespace vix::sync
+{
+  namespace
+  {
+    constexpr char kAlphabet[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
+    std::int8_t decode_char(char c) noexcept
+    {
+      if (c >= 'a' && c <= 'z')
+        c = static_cast<char>(c - 'a' + 'A');
+
+      switch (c)
+      {
+      case 'O':
+        return 0;
+      case 'I':
+      case 'L':
+        return 1;
+      default:
+        break;
+      }
+
+      for (std::int8_t i = 0; i < 32; ++i)
+      {
+        if (kAlphabet[i] == c)
+          return i;
+      }
+      return -1;
+    }
+
+    /**
+     * Per-thread generator: last timestamp and the 80-bit random part,
+     * split as 16 high bits and 64 low bits.
+     */
+    struct Generator
+    {
+      std::mt19937_64 rng;
+      std::int64_t last_ms{-1};
+      std::uint16_t rand_hi{0};
+      std::uint64_t rand_lo{0};
+
+      Generator()
+      {
+        std::random_device rd;
+        std::seed_seq seq{
+            rd(), rd(), rd(), rd(),
+            static_cast<std::uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())),
+            static_cast<std::uint32_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count())};
+        rng.seed(seq);
+      }
+
+      void next(std::int64_t unix_ms)
+      {
+        if (unix_ms < last_ms)
+          unix_ms = last_ms;
+
+        if (unix_ms != last_ms)
+        {
+          last_ms = unix_ms;
+          // Keep the top bit clear so that a long run of increments within
+          // one millisecond cannot overflow the random part.
+          rand_hi = static_cast<std::uint16_t>(rng() & 0x7fff);
+          rand_lo = rng();
+          return;
+        }
+
+        if (++rand_lo == 0 && ++rand_hi == 0)
+        {
+          // 2^79 ids in one millisecond: borrow the next one.
+          ++last_ms;
+          rand_hi = static_cast<std::uint16_t>(rng() & 0x7fff);
+          rand_lo = rng();
+        }
+      }
+    };
+
+    Generator &generator()
+    {
+      thread_local Generator g;
+      return g;
+    }
+  } // namespace
+
+  OperationId OperationId::generate()
+  {
+    using namespace std::chrono;
+    return generate(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
+  }
+
+  OperationId OperationId::generate(std::int64_t unix_ms)
+  {
+    auto &g = generator();
+    g.next(unix_ms < 0 ? 0 : unix_ms);
+
+    OperationId id;
+    const auto ts = static_cast<std::uint64_t>(g.last_ms);
+    for (std::size_t i = 0; i < 6; ++i)
+      id.bytes[i] = static_cast<std::uint8_t>(ts >> (8 * (5 - i)));
+
+    id.bytes[6] = static_cast<std::uint8_t>(g.rand_hi >> 8);
+    id.bytes[7] = static_cast<std::uint8_t>(g.rand_hi);
+    for (std::size_t i = 0; i < 8; ++i)
+      id.bytes[8 + i] = static_cast<std::uint8_t>(g.rand_lo >> (8 * (7 - i)));
+
+    return id;
+  }
+
+  std::string OperationId::to_string() const
+  {
+    // 128 bits as 26 base32 digits: the first digit carries 3 bits (2 bits
+    // of padding), every following digit 5 bits.
+    std::string out(text_size, '0');
+
+    std::uint64_t hi = 0;
+    std::uint64_t lo = 0;
+    for (std::size_t i = 0; i < 8; ++i)
+      hi = (hi << 8) | bytes[i];
+    for (std::size_t i = 8; i < 16; ++i)
+      lo = (lo << 8) | bytes[i];
+
+    for (std::size_t i = text_size; i-- > 0;)
+    {
+      out[i] = kAlphabet[lo & 0x1f];
+      lo = (lo >> 5) | (hi << 59);
+      hi >>= 5;
+    }
+    return out;
+  }
+
+  std::optional<OperationId> OperationId::parse(std::string_view text) noexcept
+  {
+    if (text.size() != text_size)
+      return std::nullopt;
+
+    std::uint64_t hi = 0;
+    std::uint64_t lo = 0;
+
+    for (std::size_t i = 0; i < text_size; ++i)
+    {
+      const auto v = decode_char(text[i]);
+      if (v < 0 || (i == 0 && v > 7))
+        return std::nullopt;
+
+      hi = (hi << 5) | (lo >> 59);
+      lo = (lo << 5) | static_cast<std::uint64_t>(v);
+    }
+
+    OperationId id;
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      id.bytes[i] = static_cast<std::uint8_t>(hi >> (8 * (7 - i)));
+      id.bytes[8 + i] = static_cast<std::uint8_t>(lo >> (8 * (7 - i)));
+    }
+    return id;
+  }
+
+  std::int64_t OperationId::timestamp_ms() const noexcept
+  {
+    std::uint64_t ts = 0;
+    for (std::size_t i = 0; i < 6; ++i)
+      ts = (ts << 8) | bytes[i];
+    return static_cast<std::int64_t>(ts);
+  }
+
+} // namespace vix::sync
@@ -0,0 +1,88 @@
+/**
+ *
+ *  @file Probes.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_PROBES_HPP
+#define VIX_SYNC_PROBES_HPP
+
+/**
+ * @brief USDT static tracepoints of the sync module (provider "vix_sync").
+ *
+ * Built when the build defines VIX_SYNC_HAVE_USDT and <sys/sdt.h> is
+ * available (systemtap-sdt-dev). A probe is a single nop in the code until a
+ * tracer attaches to it; without sdt.h the macros expand to nothing and
+ * their arguments are not evaluated.
+ *
+ * Durations are measured by the tracer from *__start / *__done pairs, so no
+ * clock is read on behalf of probes. Strings are NUL-terminated C strings.
+ *
+ * | probe                 | arguments                                   |
+ * |-----------------------|---------------------------------------------|
+ * | enqueue__start        | kind, target, payload_bytes                 |
+ * | enqueue__done         | op_id, payload_bytes                        |
+ * | enqueue__duplicate    | op_id                                       |
+ * | claim                 | op_id, target, won (0/1)                    |
+ * | send__start           | target, ops, payload_bytes                  |
+ * | send__done            | target, ops, latency_us                     |
+ * | complete              | op_id, attempt                              |
+ * | fail                  | op_id, retryable (0/1), attempt             |
+ * | store__flush__start   | ops                                         |
+ * | store__flush__done    | ops, bytes                                  |
+ * | wal__append__start    | op_id, type, payload_bytes                  |
+ * | wal__append__done     | op_id, offset, record_bytes                 |
+ * | wal__next__start      | offset                                      |
+ * | wal__next__done       | op_id, type, payload_bytes                  |
+ *
+ * Example (flush latency histogram):
+ *
+ *   bpftrace -e '
+ *     usdt:./app:vix_sync:store__flush__start { @t[tid] = nsecs; }
+ *     usdt:./app:vix_sync:store__flush__done /@t[tid]/ {
+ *       @flush_us = hist((nsecs - @t[tid]) / 1000); delete(@t[tid]); }'
+ */
+
+#if defined(VIX_SYNC_HAVE_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define VIX_SYNC_USDT_ENABLED 1
+#endif
+#endif
+
+#if defined(VIX_SYNC_USDT_ENABLED)
+
+#define VIX_SYNC_PROBE1(name, a1) \
+  DTRACE_PROBE1(vix_sync, name, a1)
+#define VIX_SYNC_PROBE2(name, a1, a2) \
+  DTRACE_PROBE2(vix_sync, name, a1, a2)
+#define VIX_SYNC_PROBE3(name, a1, a2, a3) \
+  DTRACE_PROBE3(vix_sync, name, a1, a2, a3)
+
+#else
+
+#define VIX_SYNC_PROBE1(name, a1) \
+  do                              \
+  {                               \
+  } while (0)
+#define VIX_SYNC_PROBE2(name, a1, a2) \
+  do                                  \
+  {                                   \
+  } while (0)
+#define VIX_SYNC_PROBE3(name, a1, a2, a3) \
+  do                                      \
+  {                                       \
+  } while (0)
+
+#endif
+
+#endif // VIX_SYNC_PROBES_HPP
@@ -0,0 +1,296 @@
+/**
+ *
+ *  @file Tracer.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/sync/Tracer.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+#include <vix/json/json.hpp>
+
+#include "outbox/AtomicFile.hpp"
+
+namespace vix::sync
+{
+  using json = nlohmann::json;
+
+  std::string_view to_string(TraceStage s) noexcept
+  {
+    switch (s)
+    {
+    case TraceStage::Queue:
+      return "queue";
+    case TraceStage::RetryWait:
+      return "retry_wait";
+    case TraceStage::ClaimWait:
+      return "claim_wait";
+    case TraceStage::Dispatch:
+      return "dispatch";
+    case TraceStage::Send:
+      return "send";
+    case TraceStage::Settle:
+      return "settle";
+    case TraceStage::EndToEnd:
+      return "end_to_end";
+    }
+    return "unknown";
+  }
+
+  static std::int64_t steady_now_ns() noexcept
+  {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+  }
+
+  Tracer::Tracer() : Tracer(Config{}) {}
+
+  Tracer::Tracer(Config cfg) : cfg_(cfg)
+  {
+    cfg_.max_tracked_ops = std::max<std::size_t>(cfg_.max_tracked_ops, 1);
+    for (auto &h : stages_)
+      h = std::make_unique<Histogram>();
+    attempts_ = std::make_unique<Histogram>();
+  }
+
+  void Tracer::record(std::string_view op_id, TraceEvent ev)
+  {
+    record(op_id, ev, steady_now_ns());
+  }
+
+  std::unordered_map<std::string, Tracer::OpState>::iterator Tracer::track_(std::string_view op_id)
+  {
+    auto [it, inserted] = ops_.try_emplace(std::string(op_id));
+    if (!inserted)
+      return it;
+
+    order_.push_back(it->first);
+
+    while (ops_.size() > cfg_.max_tracked_ops && !order_.empty())
+    {
+      const auto victim = std::move(order_.front());
+      order_.pop_front();
+      if (victim != it->first && ops_.erase(victim) > 0)
+        ++evicted_;
+    }
+
+    // Finished ids stay in order_ until they reach the front; drop them in
+    // bulk once they dominate.
+    if (order_.size() > 2 * std::max<std::size_t>(ops_.size(), 1024))
+    {
+      std::erase_if(order_, [this](const std::string &id)
+                    { return ops_.count(id) == 0; });
+    }
+
+    return it;
+  }
+
+  void Tracer::stage_(const std::string &op_id, const OpState &s, TraceStage stage,
+                      std::int64_t start_ns, std::int64_t end_ns)
+  {
+    const auto d = std::max<std::int64_t>(end_ns - start_ns, 0);
+    stages_[static_cast<std::size_t>(stage)]->record(static_cast<std::uint64_t>(d));
+
+    if (!cfg_.keep_spans)
+      return;
+    if (spans_.size() >= cfg_.max_spans)
+    {
+      ++dropped_spans_;
+      return;
+    }
+    spans_.push_back(Span{op_id, stage, std::max<std::uint32_t>(s.attempt, 1), start_ns, start_ns + d});
+  }
+
+  void Tracer::finish_(std::unordered_map<std::string, OpState>::iterator it, std::int64_t ts_ns)
+  {
+    const auto &s = it->second;
+    if (s.send_end_ns >= 0)
+      stage_(it->first, s, TraceStage::Settle, s.send_end_ns, ts_ns);
+    if (s.enqueued_ns >= 0)
+      stage_(it->first, s, TraceStage::EndToEnd, s.enqueued_ns, ts_ns);
+    attempts_->record(s.attempt);
+    ops_.erase(it);
+  }
+
+  void Tracer::record(std::string_view op_id, TraceEvent ev, std::int64_t ts_ns)
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+
+    if (ev == TraceEvent::Enqueue)
+    {
+      auto &s = track_(op_id)->second;
+      s = OpState{};
+      s.enqueued_ns = ts_ns;
+      return;
+    }
+
+    if (ev == TraceEvent::Ready)
+    {
+      // Ops loaded from disk are traced from the first time they are seen.
+      auto it = track_(op_id);
+      auto &s = it->second;
+      if (s.ready_ns >= 0)
+        return;
+
+      s.ready_ns = ts_ns;
+      const auto &id = it->first;
+      if (s.failed_ns >= 0)
+        stage_(id, s, TraceStage::RetryWait, s.failed_ns, ts_ns);
+      else if (s.attempt == 0 && s.enqueued_ns >= 0)
+        stage_(id, s, TraceStage::Queue, s.enqueued_ns, ts_ns);
+      return;
+    }
+
+    auto it = ops_.find(std::string(op_id));
+    if (it == ops_.end())
+      return;
+
+    auto &s = it->second;
+    switch (ev)
+    {
+    case TraceEvent::Claim:
+      s.attempt += 1;
+      if (s.ready_ns >= 0)
+        stage_(it->first, s, TraceStage::ClaimWait, s.ready_ns, ts_ns);
+      s.claimed_ns = ts_ns;
+      s.ready_ns = -1;
+      s.send_start_ns = -1;
+      s.send_end_ns = -1;
+      break;
+
+    case TraceEvent::SendStart:
+      if (s.claimed_ns >= 0)
+        stage_(it->first, s, TraceStage::Dispatch, s.claimed_ns, ts_ns);
+      s.send_start_ns = ts_ns;
+      break;
+
+    case TraceEvent::SendEnd:
+      if (s.send_start_ns >= 0)
+        stage_(it->first, s, TraceStage::Send, s.send_start_ns, ts_ns);
+      s.send_end_ns = ts_ns;
+      break;
+
+    case TraceEvent::Fail:
+      if (s.send_end_ns >= 0)
+        stage_(it->first, s, TraceStage::Settle, s.send_end_ns, ts_ns);
+      s.failed_ns = ts_ns;
+      s.ready_ns = -1;
+      s.claimed_ns = -1;
+      s.send_start_ns = -1;
+      s.send_end_ns = -1;
+      break;
+
+    case TraceEvent::Complete:
+    case TraceEvent::PermanentFail:
+      finish_(it, ts_ns);
+      break;
+
+    case TraceEvent::Enqueue:
+    case TraceEvent::Ready:
+      break;
+    }
+  }
+
+  Tracer::Stats Tracer::stats() const
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+
+    Stats out;
+    for (std::size_t i = 0; i < kTraceStages; ++i)
+      out.stages[i] = stages_[i]->snapshot();
+    out.attempts = attempts_->snapshot();
+    out.tracked = ops_.size();
+    out.evicted = evicted_;
+    out.dropped_spans = dropped_spans_;
+    return out;
+  }
+
+  std::vector<Tracer::Span> Tracer::spans() const
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    return spans_;
+  }
+
+  std::string Tracer::to_chrome_trace() const
+  {
+    const auto spans = this->spans();
+
+    std::int64_t origin = 0;
+    if (!spans.empty())
+    {
+      origin = std::min_element(spans.begin(), spans.end(), [](const Span &l, const Span &r)
+                                { return l.start_ns < r.start_ns; })
+                   ->start_ns;
+    }
+
+    json events = json::array();
+    for (const auto &sp : spans)
+    {
+      const auto name = std::string(to_string(sp.stage));
+      const double begin_us = static_cast<double>(sp.start_ns - origin) / 1000.0;
+      const double end_us = static_cast<double>(sp.end_ns - origin) / 1000.0;
+
+      json b = json::object();
+      b["name"] = name;
+      b["cat"] = "vix.sync";
+      b["ph"] = "b";
+      b["id"] = sp.op_id;
+      b["ts"] = begin_us;
+      b["pid"] = 1;
+      b["tid"] = 1;
+      b["args"] = json{{"attempt", sp.attempt}};
+
+      json e = json::object();
+      e["name"] = name;
+      e["cat"] = "vix.sync";
+      e["ph"] = "e";
+      e["id"] = sp.op_id;
+      e["ts"] = end_us;
+      e["pid"] = 1;
+      e["tid"] = 1;
+
+      events.push_back(std::move(b));
+      events.push_back(std::move(e));
+    }
+
+    json root = json::object();
+    root["traceEvents"] = std::move(events);
+    root["displayTimeUnit"] = "ms";
+    return root.dump();
+  }
+
+  void Tracer::write_chrome_trace(const std::filesystem::path &path) const
+  {
+    const auto text = to_chrome_trace();
+
+    if (path.has_parent_path())
+      std::filesystem::create_directories(path.parent_path());
+
+    std::lock_guard<std::mutex> lk(write_mu_);
+    outbox::detail::write_file_atomic(path, text, /*sync*/ false);
+  }
+
+  void Tracer::reset()
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+
+    ops_.clear();
+    order_.clear();
+    for (auto &h : stages_)
+      h = std::make_unique<Histogram>();
+    attempts_ = std::make_unique<Histogram>();
+    spans_.clear();
+    evicted_ = 0;
+    dropped_spans_ = 0;
+  }
+
+} // namespace vix::sync
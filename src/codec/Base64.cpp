@@ -0,0 +1,108 @@
+/**
+ *
+ *  @file Base64.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include "Base64.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+
+namespace vix::sync::detail
+{
+  namespace
+  {
+    constexpr char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    constexpr std::array<std::int8_t, 256> make_reverse()
+    {
+      std::array<std::int8_t, 256> t{};
+      for (auto &v : t)
+        v = -1;
+      for (int i = 0; i < 64; ++i)
+        t[static_cast<unsigned char>(kAlphabet[i])] = static_cast<std::int8_t>(i);
+      return t;
+    }
+
+    constexpr auto kReverse = make_reverse();
+  } // namespace
+
+  std::string base64_encode(std::string_view bytes)
+  {
+    std::string out;
+    out.reserve((bytes.size() + 2) / 3 * 4);
+
+    const auto *p = reinterpret_cast<const unsigned char *>(bytes.data());
+    std::size_t i = 0;
+    for (; i + 3 <= bytes.size(); i += 3)
+    {
+      const std::uint32_t v = (std::uint32_t{p[i]} << 16) | (std::uint32_t{p[i + 1]} << 8) | p[i + 2];
+      out.push_back(kAlphabet[(v >> 18) & 63]);
+      out.push_back(kAlphabet[(v >> 12) & 63]);
+      out.push_back(kAlphabet[(v >> 6) & 63]);
+      out.push_back(kAlphabet[v & 63]);
+    }
+
+    const auto rest = bytes.size() - i;
+    if (rest > 0)
+    {
+      std::uint32_t v = std::uint32_t{p[i]} << 16;
+      if (rest == 2)
+        v |= std::uint32_t{p[i + 1]} << 8;
+      out.push_back(kAlphabet[(v >> 18) & 63]);
+      out.push_back(kAlphabet[(v >> 12) & 63]);
+      out.push_back(rest == 2 ? kAlphabet[(v >> 6) & 63] : '=');
+      out.push_back('=');
+    }
+    return out;
+  }
+
+  std::string base64_decode(std::string_view text)
+  {
+    if (text.size() % 4 != 0)
+      throw std::runtime_error("base64: invalid length");
+
+    std::size_t pad = 0;
+    if (!text.empty() && text.back() == '=')
+      pad = text.size() >= 2 && text[text.size() - 2] == '=' ? 2 : 1;
+
+    std::string out;
+    out.reserve(text.size() / 4 * 3);
+
+    for (std::size_t i = 0; i < text.size(); i += 4)
+    {
+      const bool last = i + 4 == text.size();
+      std::uint32_t v = 0;
+      for (std::size_t k = 0; k < 4; ++k)
+      {
+        const char c = text[i + k];
+        if (last && c == '=' && k >= 4 - pad)
+        {
+          v <<= 6;
+          continue;
+        }
+        const auto d = kReverse[static_cast<unsigned char>(c)];
+        if (d < 0)
+          throw std::runtime_error("base64: invalid character");
+        v = (v << 6) | static_cast<std::uint32_t>(d);
+      }
+
+      out.push_back(static_cast<char>((v >> 16) & 0xff));
+      if (!last || pad < 2)
+        out.push_back(static_cast<char>((v >> 8) & 0xff));
+      if (!last || pad < 1)
+        out.push_back(static_cast<char>(v & 0xff));
+    }
+    return out;
+  }
+
+} // namespace vix::sync::detail
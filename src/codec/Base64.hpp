@@ -0,0 +1,38 @@
+/**
+ *
+ *  @file Base64.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_BASE64_HPP
+#define VIX_SYNC_BASE64_HPP
+
+#include <string>
+#include <string_view>
+
+namespace vix::sync::detail
+{
+  /**
+   * @brief Standard base64 with padding, for binary bytes in JSON files.
+   */
+  std::string base64_encode(std::string_view bytes);
+
+  /**
+   * @brief Decode base64 produced by base64_encode().
+   *
+   * @throws std::runtime_error on malformed input.
+   */
+  std::string base64_decode(std::string_view text);
+
+} // namespace vix::sync::detail
+
+#endif // VIX_SYNC_BASE64_HPP
@@ -0,0 +1,75 @@
+/**
+ *
+ *  @file Codec.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/sync/Codec.hpp>
+
+#include "Codecs.hpp"
+
+namespace vix::sync
+{
+
+  std::shared_ptr<const Codec> find_codec(CodecId id) noexcept
+  {
+    switch (id)
+    {
+    case CodecId::Lz:
+    {
+      static const auto lz = detail::make_lz_codec();
+      return lz;
+    }
+#if defined(VIX_SYNC_HAVE_LZ4)
+    case CodecId::Lz4:
+    {
+      static const auto lz4 = detail::make_lz4_codec();
+      return lz4;
+    }
+#endif
+#if defined(VIX_SYNC_HAVE_ZSTD)
+    case CodecId::Zstd:
+    {
+      static const auto zstd = detail::make_zstd_codec();
+      return zstd;
+    }
+#endif
+    default:
+      return nullptr;
+    }
+  }
+
+  std::shared_ptr<const Codec> find_codec(std::string_view name) noexcept
+  {
+    for (auto id : {CodecId::Lz, CodecId::Lz4, CodecId::Zstd})
+    {
+      auto codec = find_codec(id);
+      if (codec && codec->name() == name)
+        return codec;
+    }
+    return nullptr;
+  }
+
+  std::optional<std::string> compress_payload(const Compression &cfg, std::string_view bytes)
+  {
+    if (cfg.codec == CodecId::None || bytes.size() < cfg.min_bytes || bytes.empty())
+      return std::nullopt;
+
+    auto codec = find_codec(cfg.codec);
+    if (!codec)
+      return std::nullopt;
+
+    auto packed = codec->compress(bytes);
+    if (static_cast<double>(packed.size()) > cfg.max_ratio * static_cast<double>(bytes.size()))
+      return std::nullopt;
+    return packed;
+  }
+
+} // namespace vix::sync
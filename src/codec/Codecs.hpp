@@ -0,0 +1,46 @@
+/**
+ *
+ *  @file Codecs.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_CODECS_HPP
+#define VIX_SYNC_CODECS_HPP
+
+#include <memory>
+
+#include <vix/sync/Codec.hpp>
+
+namespace vix::sync::detail
+{
+  /**
+   * @brief In-tree LZ77 codec (LZ4-style sequences, 64 KiB window).
+   */
+  std::shared_ptr<const Codec> make_lz_codec();
+
+#if defined(VIX_SYNC_HAVE_LZ4)
+  /**
+   * @brief liblz4 block codec.
+   */
+  std::shared_ptr<const Codec> make_lz4_codec();
+#endif
+
+#if defined(VIX_SYNC_HAVE_ZSTD)
+  /**
+   * @brief libzstd codec.
+   */
+  std::shared_ptr<const Codec> make_zstd_codec();
+#endif
+
+} // namespace vix::sync::detail
+
+#endif // VIX_SYNC_CODECS_HPP
@@ -0,0 +1,71 @@
+/**
+ *
+ *  @file Lz4Codec.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#if defined(VIX_SYNC_HAVE_LZ4)
+
+#include "Codecs.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+#include <lz4.h>
+
+namespace vix::sync::detail
+{
+  namespace
+  {
+    class Lz4Codec final : public Codec
+    {
+    public:
+      CodecId id() const noexcept override { return CodecId::Lz4; }
+      std::string_view name() const noexcept override { return "lz4"; }
+
+      std::string compress(std::string_view bytes) const override
+      {
+        if (bytes.size() > static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE))
+          throw std::runtime_error("Lz4Codec: input too large");
+
+        const int src_size = static_cast<int>(bytes.size());
+        std::string out(static_cast<std::size_t>(LZ4_compressBound(src_size)), '\0');
+
+        const int n = LZ4_compress_default(bytes.data(), out.data(), src_size, static_cast<int>(out.size()));
+        if (n <= 0)
+          throw std::runtime_error("Lz4Codec: compression failed");
+        out.resize(static_cast<std::size_t>(n));
+        return out;
+      }
+
+      std::string decompress(std::string_view bytes, std::size_t raw_size) const override
+      {
+        if (raw_size > static_cast<std::size_t>(std::numeric_limits<int>::max()) ||
+            bytes.size() > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+          throw std::runtime_error("Lz4Codec: input too large");
+
+        std::string out(raw_size, '\0');
+        const int n = LZ4_decompress_safe(
+            bytes.data(), out.data(), static_cast<int>(bytes.size()), static_cast<int>(raw_size));
+        if (n < 0 || static_cast<std::size_t>(n) != raw_size)
+          throw std::runtime_error("Lz4Codec: corrupted input");
+        return out;
+      }
+    };
+  } // namespace
+
+  std::shared_ptr<const Codec> make_lz4_codec()
+  {
+    return std::make_shared<const Lz4Codec>();
+  }
+
+} // namespace vix::sync::detail
+
+#endif // VIX_SYNC_HAVE_LZ4
@@ -0,0 +1,242 @@
+/**
+ *
+ *  @file LzCodec.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include "Codecs.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace vix::sync::detail
+{
+  namespace
+  {
+    // Block layout: a sequence of
+    //   token (4 bits literal length, 4 bits match length - 4)
+    //   [literal length extension] literals
+    //   offset (2 bytes, little endian) [match length extension]
+    // The last sequence only carries literals. Lengths of 15 are extended
+    // by bytes summed until one is not 255.
+
+    constexpr std::size_t kMinMatch = 4;
+    constexpr std::size_t kHashLog = 14;
+    constexpr std::size_t kMaxOffset = 65535;
+    constexpr std::size_t kLastLiterals = 5; // matches never reach the end
+    constexpr std::size_t kMinInput = 13;
+
+    inline std::uint32_t read32(const char *p) noexcept
+    {
+      std::uint32_t v;
+      std::memcpy(&v, p, sizeof(v));
+      return v;
+    }
+
+    inline std::uint32_t hash32(std::uint32_t v) noexcept
+    {
+      return (v * 2654435761u) >> (32 - kHashLog);
+    }
+
+    void put_length(std::string &out, std::size_t len)
+    {
+      while (len >= 255)
+      {
+        out.push_back(static_cast<char>(255));
+        len -= 255;
+      }
+      out.push_back(static_cast<char>(len));
+    }
+
+    void put_sequence(
+        std::string &out,
+        const char *literals,
+        std::size_t lit_len,
+        std::size_t offset,
+        std::size_t match_len)
+    {
+      const std::size_t ml = match_len - kMinMatch;
+      const auto token = static_cast<std::uint8_t>(
+          ((lit_len < 15 ? lit_len : 15) << 4) | (ml < 15 ? ml : 15));
+      out.push_back(static_cast<char>(token));
+
+      if (lit_len >= 15)
+        put_length(out, lit_len - 15);
+      out.append(literals, lit_len);
+
+      out.push_back(static_cast<char>(offset & 0xff));
+      out.push_back(static_cast<char>(offset >> 8));
+
+      if (ml >= 15)
+        put_length(out, ml - 15);
+    }
+
+    void put_last_literals(std::string &out, const char *literals, std::size_t lit_len)
+    {
+      const auto token = static_cast<std::uint8_t>((lit_len < 15 ? lit_len : 15) << 4);
+      out.push_back(static_cast<char>(token));
+      if (lit_len >= 15)
+        put_length(out, lit_len - 15);
+      out.append(literals, lit_len);
+    }
+
+    class LzCodec final : public Codec
+    {
+    public:
+      CodecId id() const noexcept override { return CodecId::Lz; }
+      std::string_view name() const noexcept override { return "lz"; }
+
+      std::string compress(std::string_view bytes) const override
+      {
+        const char *src = bytes.data();
+        const std::size_t n = bytes.size();
+
+        std::string out;
+        out.reserve(n + n / 255 + 16);
+
+        if (n < kMinInput)
+        {
+          put_last_literals(out, src, n);
+          return out;
+        }
+
+        // Positions + 1, so that 0 means "empty".
+        std::vector<std::uint32_t> table(std::size_t{1} << kHashLog, 0);
+
+        const std::size_t match_limit = n - kLastLiterals;
+        const std::size_t search_limit = n - kMinInput + 1;
+
+        std::size_t anchor = 0;
+        std::size_t ip = 0;
+
+        while (ip < search_limit)
+        {
+          const auto seq = read32(src + ip);
+          auto &slot = table[hash32(seq)];
+          const std::size_t ref = slot;
+          slot = static_cast<std::uint32_t>(ip + 1);
+
+          if (ref == 0 || ip - (ref - 1) > kMaxOffset || read32(src + ref - 1) != seq)
+          {
+            // Skip faster through incompressible data.
+            ip += 1 + ((ip - anchor) >> 6);
+            continue;
+          }
+
+          std::size_t match = ref - 1;
+          std::size_t len = kMinMatch;
+          while (ip + len < match_limit && src[match + len] == src[ip + len])
+            ++len;
+
+          // Extend backwards over literals.
+          while (ip > anchor && match > 0 && src[ip - 1] == src[match - 1])
+          {
+            --ip;
+            --match;
+            ++len;
+          }
+
+          put_sequence(out, src + anchor, ip - anchor, ip - match, len);
+          ip += len;
+          anchor = ip;
+
+          if (ip >= 2 && ip - 2 < search_limit)
+            table[hash32(read32(src + ip - 2))] = static_cast<std::uint32_t>(ip - 1);
+        }
+
+        put_last_literals(out, src + anchor, n - anchor);
+        return out;
+      }
+
+      std::string decompress(std::string_view bytes, std::size_t raw_size) const override
+      {
+        const auto *in = reinterpret_cast<const std::uint8_t *>(bytes.data());
+        const std::size_t n = bytes.size();
+
+        std::string out(raw_size, '\0');
+        char *dst = out.data();
+
+        std::size_t ip = 0;
+        std::size_t op = 0;
+
+        auto corrupt = []
+        { throw std::runtime_error("LzCodec: corrupted input"); };
+
+        auto read_length = [&](std::size_t len) -> std::size_t
+        {
+          std::uint8_t b = 255;
+          while (b == 255)
+          {
+            if (ip >= n)
+              corrupt();
+            b = in[ip++];
+            len += b;
+          }
+          return len;
+        };
+
+        while (ip < n)
+        {
+          const std::uint8_t token = in[ip++];
+
+          std::size_t lit = token >> 4;
+          if (lit == 15)
+            lit = read_length(lit);
+          if (lit > n - ip || lit > raw_size - op)
+            corrupt();
+
+          std::memcpy(dst + op, in + ip, lit);
+          ip += lit;
+          op += lit;
+
+          if (ip == n)
+            break;
+
+          if (n - ip < 2)
+            corrupt();
+          const std::size_t offset = in[ip] | (static_cast<std::size_t>(in[ip + 1]) << 8);
+          ip += 2;
+          if (offset == 0 || offset > op)
+            corrupt();
+
+          std::size_t len = (token & 0x0f);
+          if (len == 15)
+            len = read_length(len);
+          len += kMinMatch;
+          if (len > raw_size - op)
+            corrupt();
+
+          const char *match = dst + op - offset;
+          if (offset >= len)
+          {
+            std::memcpy(dst + op, match, len);
+          }
+          else
+          {
+            for (std::size_t i = 0; i < len; ++i)
+              dst[op + i] = match[i];
+          }
+          op += len;
+        }
+
+        if (op != raw_size)
+          corrupt();
+        return out;
+      }
+    };
+  } // namespace
+
+  std::shared_ptr<const Codec> make_lz_codec()
+  {
+    return std::make_shared<const LzCodec>();
+  }
+
+} // namespace vix::sync::detail
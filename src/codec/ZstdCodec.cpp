@@ -0,0 +1,63 @@
+/**
+ *
+ *  @file ZstdCodec.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#if defined(VIX_SYNC_HAVE_ZSTD)
+
+#include "Codecs.hpp"
+
+#include <stdexcept>
+
+#include <zstd.h>
+
+namespace vix::sync::detail
+{
+  namespace
+  {
+    // Favors speed: payload compression sits on the enqueue path.
+    constexpr int kLevel = 1;
+
+    class ZstdCodec final : public Codec
+    {
+    public:
+      CodecId id() const noexcept override { return CodecId::Zstd; }
+      std::string_view name() const noexcept override { return "zstd"; }
+
+      std::string compress(std::string_view bytes) const override
+      {
+        std::string out(ZSTD_compressBound(bytes.size()), '\0');
+        const auto n = ZSTD_compress(out.data(), out.size(), bytes.data(), bytes.size(), kLevel);
+        if (ZSTD_isError(n))
+          throw std::runtime_error("ZstdCodec: compression failed");
+        out.resize(n);
+        return out;
+      }
+
+      std::string decompress(std::string_view bytes, std::size_t raw_size) const override
+      {
+        std::string out(raw_size, '\0');
+        const auto n = ZSTD_decompress(out.data(), out.size(), bytes.data(), bytes.size());
+        if (ZSTD_isError(n) || n != raw_size)
+          throw std::runtime_error("ZstdCodec: corrupted input");
+        return out;
+      }
+    };
+  } // namespace
+
+  std::shared_ptr<const Codec> make_zstd_codec()
+  {
+    return std::make_shared<const ZstdCodec>();
+  }
+
+} // namespace vix::sync::detail
+
+#endif // VIX_SYNC_HAVE_ZSTD
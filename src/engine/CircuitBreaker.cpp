@@ -0,0 +1,160 @@
+/**
+ *
+ *  @file CircuitBreaker.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/sync/engine/CircuitBreaker.hpp>
+
+namespace vix::sync::engine
+{
+
+  CircuitBreaker::CircuitBreaker(Config cfg) : cfg_(cfg) {}
+
+  void CircuitBreaker::trip_(Entry &e, std::int64_t now_ms) noexcept
+  {
+    e.state = State::Open;
+    e.opened_at_ms = now_ms;
+    e.probes_inflight = 0;
+    e.probe_successes = 0;
+  }
+
+  bool CircuitBreaker::allow(const std::string &target, std::int64_t now_ms)
+  {
+    if (!cfg_.enabled)
+      return true;
+
+    std::lock_guard<std::mutex> lk(mu_);
+
+    auto it = entries_.find(target);
+    if (it == entries_.end())
+      return true;
+
+    auto &e = it->second;
+
+    if (e.state == State::Open)
+    {
+      if (now_ms - e.opened_at_ms < cfg_.open_duration_ms)
+        return false;
+
+      e.state = State::HalfOpen;
+      e.probes_inflight = 0;
+      e.probe_successes = 0;
+    }
+
+    if (e.state == State::HalfOpen)
+    {
+      if (e.probes_inflight >= cfg_.half_open_max_probes)
+        return false;
+      ++e.probes_inflight;
+    }
+
+    return true;
+  }
+
+  void CircuitBreaker::release(const std::string &target)
+  {
+    if (!cfg_.enabled)
+      return;
+
+    std::lock_guard<std::mutex> lk(mu_);
+
+    auto it = entries_.find(target);
+    if (it == entries_.end())
+      return;
+
+    auto &e = it->second;
+    if (e.state == State::HalfOpen && e.probes_inflight > 0)
+      --e.probes_inflight;
+  }
+
+  void CircuitBreaker::on_success(const std::string &target, std::int64_t /*now_ms*/)
+  {
+    if (!cfg_.enabled)
+      return;
+
+    std::lock_guard<std::mutex> lk(mu_);
+
+    auto it = entries_.find(target);
+    if (it == entries_.end())
+      return;
+
+    auto &e = it->second;
+    switch (e.state)
+    {
+    case State::Closed:
+      entries_.erase(it);
+      break;
+
+    case State::HalfOpen:
+      if (e.probes_inflight > 0)
+        --e.probes_inflight;
+      if (++e.probe_successes >= cfg_.success_threshold)
+        entries_.erase(it);
+      break;
+
+    case State::Open:
+      // Late answer for an operation sent before the circuit opened.
+      break;
+    }
+  }
+
+  void CircuitBreaker::on_failure(const std::string &target, std::int64_t now_ms)
+  {
+    if (!cfg_.enabled)
+      return;
+
+    std::lock_guard<std::mutex> lk(mu_);
+
+    auto &e = entries_[target];
+    switch (e.state)
+    {
+    case State::Closed:
+      if (++e.consecutive_failures >= cfg_.failure_threshold)
+        trip_(e, now_ms);
+      break;
+
+    case State::HalfOpen:
+      trip_(e, now_ms);
+      break;
+
+    case State::Open:
+      break;
+    }
+  }
+
+  CircuitBreaker::State CircuitBreaker::state(const std::string &target, std::int64_t now_ms) const
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+
+    auto it = entries_.find(target);
+    if (it == entries_.end())
+      return State::Closed;
+
+    const auto &e = it->second;
+    if (e.state == State::Open && now_ms - e.opened_at_ms >= cfg_.open_duration_ms)
+      return State::HalfOpen;
+    return e.state;
+  }
+
+  std::size_t CircuitBreaker::open_count() const
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+
+    std::size_t n = 0;
+    for (const auto &[target, e] : entries_)
+    {
+      if (e.state != State::Closed)
+        ++n;
+    }
+    return n;
+  }
+
+} // namespace vix::sync::engine
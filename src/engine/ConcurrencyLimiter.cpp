@@ -0,0 +1,195 @@
+/**
+ *
+ *  @file ConcurrencyLimiter.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/sync/engine/ConcurrencyLimiter.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace vix::sync::engine
+{
+
+  ConcurrencyLimiter::ConcurrencyLimiter(Config cfg) : cfg_(cfg)
+  {
+    cfg_.min_limit = std::max(cfg_.min_limit, 1.0);
+    cfg_.max_limit = std::max(cfg_.max_limit, cfg_.min_limit);
+  }
+
+  double ConcurrencyLimiter::clamp_(double limit) const noexcept
+  {
+    return std::clamp(limit, cfg_.min_limit, cfg_.max_limit);
+  }
+
+  ConcurrencyLimiter::Entry &ConcurrencyLimiter::entry_(const std::string &target)
+  {
+    auto [it, inserted] = entries_.try_emplace(target);
+    if (inserted)
+      it->second.limit = clamp_(cfg_.initial_limit);
+    return it->second;
+  }
+
+  void ConcurrencyLimiter::evict_idle_(std::int64_t now_ms)
+  {
+    // Same number of permits as a new entry: nothing worth remembering.
+    const double initial = std::floor(clamp_(cfg_.initial_limit));
+    std::erase_if(entries_, [&](const auto &kv)
+                  {
+                    const auto &e = kv.second;
+                    return e.inflight == 0 &&
+                           now_ms - e.last_sample_ms >= cfg_.idle_eviction_ms &&
+                           std::floor(e.limit) == initial; });
+    last_sweep_ms_ = now_ms;
+  }
+
+  bool ConcurrencyLimiter::try_acquire(const std::string &target)
+  {
+    if (!cfg_.enabled)
+      return true;
+
+    std::lock_guard<std::mutex> lk(mu_);
+
+    auto &e = entry_(target);
+    if (static_cast<double>(e.inflight) + 1.0 > std::floor(e.limit))
+      return false;
+
+    ++e.inflight;
+    return true;
+  }
+
+  void ConcurrencyLimiter::release(const std::string &target)
+  {
+    if (!cfg_.enabled)
+      return;
+
+    std::lock_guard<std::mutex> lk(mu_);
+
+    auto it = entries_.find(target);
+    if (it != entries_.end() && it->second.inflight > 0)
+      --it->second.inflight;
+  }
+
+  void ConcurrencyLimiter::on_sample(
+      const std::string &target,
+      double latency_ms,
+      bool congested,
+      std::int64_t now_ms)
+  {
+    if (!cfg_.enabled)
+      return;
+
+    std::lock_guard<std::mutex> lk(mu_);
+
+    // At most one sweep per idle window.
+    if (now_ms - last_sweep_ms_ >= cfg_.idle_eviction_ms)
+      evict_idle_(now_ms);
+
+    auto &e = entry_(target);
+    const double a = std::clamp(cfg_.smoothing, 0.0, 1.0);
+
+    if (e.samples == 0)
+    {
+      e.latency_ms = latency_ms;
+      e.baseline_ms = latency_ms;
+    }
+    else
+    {
+      e.latency_ms += a * (latency_ms - e.latency_ms);
+      // Baseline follows new minimums immediately and drifts up slowly, so
+      // a permanently slower path is eventually accepted as the new normal.
+      e.baseline_ms = std::min(latency_ms, e.baseline_ms + 0.01 * (e.latency_ms - e.baseline_ms));
+    }
+    e.error_rate += a * ((congested ? 1.0 : 0.0) - e.error_rate);
+    ++e.samples;
+    e.last_sample_ms = now_ms;
+
+    const bool can_decrease = !e.decreased || now_ms - e.last_decrease_ms >= cfg_.decrease_interval_ms;
+
+    if (cfg_.mode == Mode::Aimd)
+    {
+      const bool slow = cfg_.latency_threshold_ms > 0.0 && latency_ms > cfg_.latency_threshold_ms;
+
+      if (congested || slow)
+      {
+        if (can_decrease)
+        {
+          e.limit = clamp_(e.limit * cfg_.backoff_ratio);
+          e.last_decrease_ms = now_ms;
+          e.decreased = true;
+        }
+      }
+      else
+      {
+        // +additive_increase once a full window of sends has succeeded.
+        e.limit = clamp_(e.limit + cfg_.additive_increase / std::max(e.limit, 1.0));
+      }
+      return;
+    }
+
+    // Gradient
+    if (congested)
+    {
+      if (can_decrease)
+      {
+        e.limit = clamp_(e.limit * cfg_.backoff_ratio);
+        e.last_decrease_ms = now_ms;
+        e.decreased = true;
+      }
+      return;
+    }
+
+    const double gradient = e.latency_ms > 0.0
+                                ? std::clamp(e.baseline_ms / e.latency_ms, 0.5, 1.0)
+                                : 1.0;
+    const double queue_allowance = std::sqrt(e.limit);
+    const double target_limit = e.limit * gradient + queue_allowance;
+
+    // Move smoothly toward the new estimate.
+    e.limit = clamp_(e.limit + a * (target_limit - e.limit));
+  }
+
+  double ConcurrencyLimiter::limit(const std::string &target) const
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+
+    auto it = entries_.find(target);
+    if (it == entries_.end())
+      return clamp_(cfg_.initial_limit);
+    return it->second.limit;
+  }
+
+  std::vector<ConcurrencyLimiter::TargetStats> ConcurrencyLimiter::snapshot() const
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+
+    std::vector<TargetStats> out;
+    out.reserve(entries_.size());
+
+    for (const auto &[target, e] : entries_)
+    {
+      TargetStats s;
+      s.target = target;
+      s.limit = e.limit;
+      s.inflight = e.inflight;
+      s.latency_ms = e.latency_ms;
+      s.baseline_latency_ms = e.baseline_ms;
+      s.error_rate = e.error_rate;
+      s.samples = e.samples;
+      out.push_back(std::move(s));
+    }
+
+    std::sort(out.begin(), out.end(), [](const TargetStats &l, const TargetStats &r)
+              { return l.target < r.target; });
+    return out;
+  }
+
+} // namespace vix::sync::engine
@@ -0,0 +1,163 @@
+/**
+ *
+ *  @file RateLimiter.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/sync/engine/RateLimiter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace vix::sync::engine
+{
+
+  RateLimiter::RateLimiter(Config cfg) : cfg_(std::move(cfg))
+  {
+    for (auto &r : cfg_.rules)
+    {
+      r.burst = std::max(r.burst, 1.0);
+      sweep_interval_ms_ = std::max(sweep_interval_ms_, refill_ms_(r));
+    }
+  }
+
+  std::int64_t RateLimiter::refill_ms_(const Rule &rule) noexcept
+  {
+    if (rule.rate_per_sec <= 0.0)
+      return -1;
+    return static_cast<std::int64_t>(std::ceil(rule.burst * 1000.0 / rule.rate_per_sec));
+  }
+
+  void RateLimiter::evict_idle_(std::int64_t now_ms)
+  {
+    std::erase_if(buckets_, [&](const auto &kv)
+                  {
+                    const auto refill = refill_ms_(cfg_.rules[kv.second.rule]);
+                    return refill >= 0 && now_ms - kv.second.updated_at_ms > refill; });
+    last_sweep_ms_ = now_ms;
+  }
+
+  bool RateLimiter::matches_(const Rule &rule, const vix::sync::Operation &op) noexcept
+  {
+    if (!rule.kind.empty() && rule.kind != op.kind)
+      return false;
+    if (!rule.target.empty() && rule.target != op.target)
+      return false;
+    return true;
+  }
+
+  std::string RateLimiter::key_(std::size_t rule_index, const Rule &rule, const vix::sync::Operation &op)
+  {
+    std::string key = std::to_string(rule_index);
+    key.push_back('\0');
+
+    switch (rule.key_by)
+    {
+    case KeyBy::Rule:
+      break;
+    case KeyBy::Kind:
+      key.append(op.kind);
+      break;
+    case KeyBy::Target:
+      key.append(op.target);
+      break;
+    case KeyBy::KindAndTarget:
+      key.append(op.kind).push_back('\0');
+      key.append(op.target);
+      break;
+    }
+    return key;
+  }
+
+  RateLimiter::Decision RateLimiter::try_acquire(const vix::sync::Operation &op, std::int64_t now_ms)
+  {
+    Decision d;
+    if (cfg_.rules.empty())
+      return d;
+
+    std::lock_guard<std::mutex> lk(mu_);
+
+    if (sweep_interval_ms_ >= 0 && now_ms - last_sweep_ms_ > sweep_interval_ms_)
+      evict_idle_(now_ms);
+
+    std::vector<Bucket *> taken;
+    taken.reserve(cfg_.rules.size());
+
+    for (std::size_t i = 0; i < cfg_.rules.size(); ++i)
+    {
+      const auto &rule = cfg_.rules[i];
+      if (!matches_(rule, op))
+        continue;
+
+      auto &b = buckets_[key_(i, rule, op)];
+      if (!b.initialized)
+      {
+        b.tokens = rule.burst;
+        b.updated_at_ms = now_ms;
+        b.initialized = true;
+        b.rule = i;
+      }
+      else if (now_ms > b.updated_at_ms)
+      {
+        const double elapsed_s = static_cast<double>(now_ms - b.updated_at_ms) / 1000.0;
+        b.tokens = std::min(rule.burst, b.tokens + elapsed_s * rule.rate_per_sec);
+        b.updated_at_ms = now_ms;
+      }
+
+      if (b.tokens < 1.0)
+      {
+        std::int64_t wait_ms = std::numeric_limits<std::int64_t>::max() / 2;
+        if (rule.rate_per_sec > 0.0)
+          wait_ms = static_cast<std::int64_t>(std::ceil((1.0 - b.tokens) * 1000.0 / rule.rate_per_sec));
+
+        const auto retry_at = now_ms + std::max<std::int64_t>(wait_ms, 1);
+        d.retry_at_ms = d.allowed ? retry_at : std::max(d.retry_at_ms, retry_at);
+        d.allowed = false;
+        continue;
+      }
+
+      taken.push_back(&b);
+    }
+
+    if (d.allowed)
+    {
+      for (auto *b : taken)
+        b->tokens -= 1.0;
+    }
+    return d;
+  }
+
+  void RateLimiter::refund(const vix::sync::Operation &op)
+  {
+    if (cfg_.rules.empty())
+      return;
+
+    std::lock_guard<std::mutex> lk(mu_);
+
+    for (std::size_t i = 0; i < cfg_.rules.size(); ++i)
+    {
+      const auto &rule = cfg_.rules[i];
+      if (!matches_(rule, op))
+        continue;
+
+      auto it = buckets_.find(key_(i, rule, op));
+      if (it != buckets_.end())
+        it->second.tokens = std::min(rule.burst, it->second.tokens + 1.0);
+    }
+  }
+
+  std::size_t RateLimiter::bucket_count() const
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    return buckets_.size();
+  }
+
+} // namespace vix::sync::engine
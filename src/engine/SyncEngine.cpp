@@ -13,17 +13,12 @@
  */
 #include <vix/sync/engine/SyncEngine.hpp>
 
+#include <algorithm>
 #include <chrono>
 
 namespace vix::sync::engine
 {
 
-  static std::int64_t now_ms()
-  {
-    using namespace std::chrono;
-    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
-  }
-
   SyncEngine::SyncEngine(
       Config cfg,
       std::shared_ptr<vix::sync::outbox::Outbox> outbox,
@@ -32,8 +27,15 @@ namespace vix::sync::engine
       : cfg_(cfg),
         outbox_(std::move(outbox)),
         probe_(std::move(probe)),
-        transport_(std::move(transport))
+        transport_(std::move(transport)),
+        clock_(cfg_.clock),
+        breaker_(std::make_shared<CircuitBreaker>(cfg_.circuit_breaker)),
+        limiter_(std::make_shared<ConcurrencyLimiter>(cfg_.concurrency)),
+        rate_limiter_(std::make_shared<RateLimiter>(cfg_.rate_limits))
   {
+    if (!clock_)
+      clock_ = outbox_ ? outbox_->clock() : vix::sync::default_clock();
+
     workers_.reserve(cfg_.worker_count);
     for (std::size_t i = 0; i < cfg_.worker_count; ++i)
     {
@@ -42,8 +44,17 @@ namespace vix::sync::engine
       wc.idle_sleep_ms = cfg_.idle_sleep_ms;
       wc.offline_sleep_ms = cfg_.offline_sleep_ms;
       wc.inflight_timeout_ms = cfg_.inflight_timeout_ms;
+      wc.send_batch_max_ops = cfg_.send_batch_max_ops;
+      wc.send_batch_max_bytes = cfg_.send_batch_max_bytes;
+      wc.circuit_breaker = cfg_.circuit_breaker;
+      wc.concurrency = cfg_.concurrency;
+      wc.rate_limits = cfg_.rate_limits;
 
-      workers_.push_back(std::make_unique<SyncWorker>(wc, outbox_, probe_, transport_));
+      auto worker = std::make_unique<SyncWorker>(wc, outbox_, probe_, transport_);
+      worker->set_circuit_breaker(breaker_);
+      worker->set_concurrency_limiter(limiter_);
+      worker->set_rate_limiter(rate_limiter_);
+      workers_.push_back(std::move(worker));
     }
   }
 
@@ -52,16 +63,55 @@ namespace vix::sync::engine
     stop();
   }
 
-  std::size_t SyncEngine::tick(std::int64_t t_ms)
+  TickStats SyncEngine::tick_with_stats(std::int64_t t_ms)
   {
-    std::size_t total = 0;
+    TickStats total;
     for (auto &w : workers_)
     {
-      total += w->tick(t_ms);
+      total += w->tick_with_stats(t_ms);
     }
+
+    std::lock_guard<std::mutex> lk(stats_mu_);
+    last_tick_ = total;
+    total_ticks_ += total;
     return total;
   }
 
+  TickStats SyncEngine::last_tick_stats() const
+  {
+    std::lock_guard<std::mutex> lk(stats_mu_);
+    return last_tick_;
+  }
+
+  TickStats SyncEngine::tick_stats() const
+  {
+    std::lock_guard<std::mutex> lk(stats_mu_);
+    return total_ticks_;
+  }
+
+  void SyncEngine::reset_tick_stats()
+  {
+    std::lock_guard<std::mutex> lk(stats_mu_);
+    total_ticks_ = TickStats{};
+  }
+
+  std::vector<ConcurrencyLimiter::TargetStats> SyncEngine::concurrency_limits() const
+  {
+    return limiter_->snapshot();
+  }
+
+  std::int64_t SyncEngine::next_wake_at_ms() const noexcept
+  {
+    std::int64_t wake = 0;
+    for (const auto &w : workers_)
+    {
+      const auto t = w->next_wake_at_ms();
+      if (t != 0 && (wake == 0 || t < wake))
+        wake = t;
+    }
+    return wake;
+  }
+
   void SyncEngine::start()
   {
     if (running_.exchange(true))
@@ -82,10 +132,16 @@ namespace vix::sync::engine
   {
     while (running_.load())
     {
-      const auto t = now_ms();
+      const auto t = clock_->now_ms();
       const auto processed = tick(t);
 
-      const auto sleep_ms = (processed == 0) ? cfg_.idle_sleep_ms : 0;
+      auto sleep_ms = (processed == 0) ? cfg_.idle_sleep_ms : std::int64_t{0};
+
+      // Ops held back by a rate limit: wake up for the next token, not later.
+      const auto wake = next_wake_at_ms();
+      if (sleep_ms > 0 && wake > t)
+        sleep_ms = std::min(sleep_ms, wake - t);
+
       if (sleep_ms > 0)
       {
         std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
@@ -13,9 +13,62 @@
  */
 #include <vix/sync/engine/SyncWorker.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../Probes.hpp"
+
 namespace vix::sync::engine
 {
 
+  static double elapsed_ms(std::chrono::steady_clock::time_point since)
+  {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now() - since).count();
+  }
+
+  // Nanoseconds since mark, moving mark to now.
+  static std::int64_t lap_ns(std::chrono::steady_clock::time_point &mark)
+  {
+    const auto now = std::chrono::steady_clock::now();
+    const auto d = std::chrono::duration_cast<std::chrono::nanoseconds>(now - mark).count();
+    mark = now;
+    return d;
+  }
+
+  [[maybe_unused]] static std::size_t payload_bytes(const std::vector<vix::sync::Operation> &ops) noexcept
+  {
+    std::size_t n = 0;
+    for (const auto &op : ops)
+      n += op.payload.size();
+    return n;
+  }
+
+  TickStats &TickStats::operator+=(const TickStats &o) noexcept
+  {
+    ticks += o.ticks;
+    processed += o.processed;
+    scanned += o.scanned;
+    claimed += o.claimed;
+    claims_lost += o.claims_lost;
+    skipped += o.skipped;
+    requeued += o.requeued;
+    expired += o.expired;
+    bytes_persisted += o.bytes_persisted;
+    offline_ticks += o.offline_ticks;
+    requeue_ns += o.requeue_ns;
+    expire_ns += o.expire_ns;
+    probe_ns += o.probe_ns;
+    peek_ns += o.peek_ns;
+    claim_ns += o.claim_ns;
+    send_ns += o.send_ns;
+    settle_ns += o.settle_ns;
+    total_ns += o.total_ns;
+    return *this;
+  }
+
   SyncWorker::SyncWorker(
       Config cfg,
       std::shared_ptr<vix::sync::outbox::Outbox> outbox,
@@ -24,77 +77,377 @@ namespace vix::sync::engine
       : cfg_(cfg),
         outbox_(std::move(outbox)),
         probe_(std::move(probe)),
-        transport_(std::move(transport))
+        transport_(std::move(transport)),
+        breaker_(std::make_shared<CircuitBreaker>(cfg_.circuit_breaker)),
+        limiter_(std::make_shared<ConcurrencyLimiter>(cfg_.concurrency)),
+        rate_limiter_(std::make_shared<RateLimiter>(cfg_.rate_limits))
   {
   }
 
+  void SyncWorker::set_circuit_breaker(std::shared_ptr<CircuitBreaker> breaker)
+  {
+    if (breaker)
+      breaker_ = std::move(breaker);
+  }
+
+  void SyncWorker::set_concurrency_limiter(std::shared_ptr<ConcurrencyLimiter> limiter)
+  {
+    if (limiter)
+      limiter_ = std::move(limiter);
+  }
+
+  void SyncWorker::set_rate_limiter(std::shared_ptr<RateLimiter> limiter)
+  {
+    if (limiter)
+      rate_limiter_ = std::move(limiter);
+  }
+
   bool SyncWorker::should_send_(std::int64_t now_ms)
   {
     const bool online = probe_ ? probe_->refresh(now_ms) : true;
     return online;
   }
 
-  std::size_t SyncWorker::process_ready_(std::int64_t now_ms)
+  // Operations sharing this key go to the same transport endpoint and match
+  // the same rate-limit buckets.
+  static std::string group_key(const vix::sync::Operation &op)
   {
-    auto ops = outbox_->peek_ready(now_ms, cfg_.batch_limit);
-    if (ops.empty())
-      return 0;
+    std::string key;
+    key.reserve(op.kind.size() + 1 + op.target.size());
+    key.append(op.kind).push_back('\0');
+    key.append(op.target);
+    return key;
+  }
+
+  SyncWorker::Admission SyncWorker::admit_(const vix::sync::Operation &op, std::int64_t now_ms)
+  {
+    if (!limiter_->try_acquire(op.target))
+      return Admission::TargetBlocked;
+
+    if (!breaker_->allow(op.target, now_ms))
+    {
+      limiter_->release(op.target);
+      return Admission::TargetBlocked;
+    }
+
+    const auto d = rate_limiter_->try_acquire(op, now_ms);
+    if (!d.allowed)
+    {
+      if (next_wake_at_ms_ == 0 || d.retry_at_ms < next_wake_at_ms_)
+        next_wake_at_ms_ = d.retry_at_ms;
+
+      breaker_->release(op.target);
+      limiter_->release(op.target);
+      return Admission::RateLimited;
+    }
+
+    return Admission::Admitted;
+  }
+
+  void SyncWorker::revoke_(const vix::sync::Operation &op)
+  {
+    rate_limiter_->refund(op);
+    breaker_->release(op.target);
+    limiter_->release(op.target);
+  }
+
+  std::size_t SyncWorker::process_ready_(std::int64_t now_ms, TickStats &st)
+  {
+    auto mark = std::chrono::steady_clock::now();
+
+    const std::size_t max_ops = std::max<std::size_t>(cfg_.send_batch_max_ops, 1);
+
+    // Refused operations do not use up the batch: candidates whose target or
+    // buckets refused one this tick are passed over by the store, so a
+    // blocked backlog cannot hide ready work queued behind it.
+    seen_.clear();
+    blocked_targets_.clear();
+    blocked_groups_.clear();
+
+    auto skip = [this](const vix::sync::Operation &op)
+    {
+      return seen_.count(op.id) != 0 ||
+             blocked_targets_.count(op.target) != 0 ||
+             (!blocked_groups_.empty() && blocked_groups_.count(group_key(op)) != 0);
+    };
 
     std::size_t processed = 0;
+    std::size_t attempted = 0;
 
-    for (const auto &op : ops)
+    while (attempted < cfg_.batch_limit)
     {
-      if (!outbox_->claim(op.id, now_ms))
+      auto ops = outbox_->peek_ready(now_ms, cfg_.batch_limit - attempted, skip);
+      if (ops.empty())
+        break;
+
+      st.scanned += ops.size();
+      for (const auto &op : ops)
+        seen_.insert(op.id);
+
+      if (const auto &tracer = outbox_->tracer())
       {
+        for (const auto &op : ops)
+          tracer->record(op.id, vix::sync::TraceEvent::Ready);
+      }
+
+      // Group by (kind, target), keeping the order in which groups first appear.
+      std::vector<std::vector<vix::sync::Operation>> groups;
+      std::unordered_map<std::string, std::size_t> group_index;
+
+      for (auto &op : ops)
+      {
+        auto [it, inserted] = group_index.try_emplace(group_key(op), groups.size());
+        if (inserted)
+          groups.emplace_back();
+        groups[it->second].push_back(std::move(op));
+      }
+
+      st.peek_ns += lap_ns(mark);
+
+      const auto claimed_before = st.claimed;
+
+      for (auto &group : groups)
+      {
+        std::vector<vix::sync::Operation> batch;
+        std::size_t batch_bytes = 0;
+
+        for (auto &op : group)
+        {
+          const std::size_t sz = op.payload.size();
+          const bool over_bytes = cfg_.send_batch_max_bytes > 0 &&
+                                  !batch.empty() &&
+                                  batch_bytes + sz > cfg_.send_batch_max_bytes;
+
+          if (batch.size() >= max_ops || over_bytes)
+          {
+            processed += send_batch_(std::move(batch), now_ms, st);
+            batch.clear();
+            batch_bytes = 0;
+          }
+
+          batch_bytes += sz;
+          batch.push_back(std::move(op));
+        }
+
+        if (!batch.empty())
+          processed += send_batch_(std::move(batch), now_ms, st);
+      }
+
+      attempted += st.claimed - claimed_before;
+      mark = std::chrono::steady_clock::now();
+    }
+
+    st.peek_ns += lap_ns(mark);
+
+    for (const auto &target : permits_)
+      limiter_->release(target);
+    permits_.clear();
+
+    return processed;
+  }
+
+  std::size_t SyncWorker::send_batch_(std::vector<vix::sync::Operation> batch, std::int64_t now_ms, TickStats &st)
+  {
+    auto mark = std::chrono::steady_clock::now();
+
+    std::vector<vix::sync::Operation> claimed;
+    claimed.reserve(batch.size());
+
+    for (auto &op : batch)
+    {
+      // Past its deadline: never worth a send, left for the expiry sweep.
+      if (op.is_expired(now_ms))
+      {
+        ++st.skipped;
+        continue;
+      }
+
+      // Refused ops stay Pending: no claim, no attempt, no store write.
+      if (blocked_targets_.count(op.target) != 0)
+      {
+        ++st.skipped;
         continue;
       }
 
+      const auto admission = admit_(op, now_ms);
+      if (admission != Admission::Admitted)
+      {
+        if (admission == Admission::TargetBlocked)
+          blocked_targets_.insert(op.target);
+        else
+          blocked_groups_.insert(group_key(op));
+        ++st.skipped;
+        continue;
+      }
+
+      const bool won = outbox_->claim(op.id, now_ms);
+      VIX_SYNC_PROBE3(claim, op.id.c_str(), op.target.c_str(), won ? 1 : 0);
+
+      if (won)
+      {
+        ++st.claimed;
+        permits_.push_back(op.target);
+        claimed.push_back(std::move(op));
+      }
+      else
+      {
+        ++st.claims_lost;
+        revoke_(op);
+      }
+    }
+
+    st.claim_ns += lap_ns(mark);
+
+    if (claimed.empty())
+      return 0;
+
+    const auto &tracer = outbox_->tracer();
+    if (tracer)
+    {
+      for (const auto &op : claimed)
+        tracer->record(op.id, vix::sync::TraceEvent::SendStart);
+    }
+
+    VIX_SYNC_PROBE3(send__start, claimed.front().target.c_str(), claimed.size(), payload_bytes(claimed));
+
+    std::vector<SendResult> results;
+    const auto send_start = std::chrono::steady_clock::now();
+    if (transport_)
+    {
+      results = transport_->send_batch(std::span<const vix::sync::Operation>(claimed));
+    }
+    const double latency_ms = elapsed_ms(send_start);
+    st.send_ns += static_cast<std::int64_t>(latency_ms * 1e6);
+    mark = std::chrono::steady_clock::now();
+
+    VIX_SYNC_PROBE3(send__done, claimed.front().target.c_str(), claimed.size(),
+                    static_cast<std::uint64_t>(latency_ms * 1000.0));
+
+    if (tracer)
+    {
+      for (const auto &op : claimed)
+        tracer->record(op.id, vix::sync::TraceEvent::SendEnd);
+    }
+
+    if (const auto &m = outbox_->metrics())
+    {
+      m->send_latency.record(static_cast<std::uint64_t>(latency_ms * 1e6));
+      m->send_batches.add();
+      m->sent.add(claimed.size());
+    }
+
+    bool batch_congested = false;
+
+    for (std::size_t i = 0; i < claimed.size(); ++i)
+    {
+      const auto &op = claimed[i];
+
       SendResult r;
-      if (transport_)
+      if (i < results.size())
       {
-        r = transport_->send(op);
+        r = std::move(results[i]);
       }
       else
       {
         r.ok = false;
         r.retryable = true;
-        r.error = "No transport configured";
+        r.error = transport_ ? "No result from transport" : "No transport configured";
       }
 
+      const bool congested = !r.ok && r.retryable;
+      if (congested)
+        breaker_->on_failure(op.target, now_ms);
+      else
+        breaker_->on_success(op.target, now_ms);
+      batch_congested = batch_congested || congested;
+
       if (r.ok)
       {
+        VIX_SYNC_PROBE2(complete, op.id.c_str(), op.attempt + 1);
         outbox_->complete(op.id, now_ms);
       }
       else
       {
+        VIX_SYNC_PROBE3(fail, op.id.c_str(), r.retryable ? 1 : 0, op.attempt + 1);
         outbox_->fail(
             op.id,
             r.error.empty() ? "send failed" : r.error,
             now_ms,
             /*retryable=*/r.retryable);
       }
-      ++processed;
     }
 
-    return processed;
+    // One transport call, one latency sample, whatever the batch size.
+    limiter_->on_sample(claimed.front().target, latency_ms, batch_congested, now_ms);
+
+    st.settle_ns += lap_ns(mark);
+    return claimed.size();
   }
 
-  std::size_t SyncWorker::tick(std::int64_t now_ms)
+  TickStats SyncWorker::tick_with_stats(std::int64_t now_ms)
   {
+    TickStats st;
+    st.ticks = 1;
+
     if (!outbox_)
-      return 0;
+      return st;
+
+    const auto start = std::chrono::steady_clock::now();
+    auto mark = start;
 
-    if (auto store = outbox_->store())
+    const auto &m = outbox_->metrics();
+    const auto store = outbox_->store();
+    const auto written = store ? store->bytes_written() : 0;
+
+    if (store)
     {
-      store->requeue_inflight_older_than(
+      st.requeued = store->requeue_inflight_older_than(
           now_ms,
           cfg_.inflight_timeout_ms);
+      if (m && st.requeued > 0)
+        m->requeued.add(st.requeued);
     }
+    st.requeue_ns = lap_ns(mark);
 
-    if (!should_send_(now_ms))
-      return 0;
+    st.expired = outbox_->expire(now_ms);
+    st.expire_ns = lap_ns(mark);
+
+    next_wake_at_ms_ = 0;
+
+    const bool online = should_send_(now_ms);
+    st.probe_ns = lap_ns(mark);
+
+    if (online)
+      st.processed = process_ready_(now_ms, st);
+    else
+      st.offline_ticks = 1;
+
+    if (m)
+    {
+      const auto d = outbox_->depth();
+      m->queue_depth.set(static_cast<std::int64_t>(d.ops));
+      m->queue_bytes.set(static_cast<std::int64_t>(d.bytes));
+
+      vix::sync::GaugeVec::Series by_priority;
+      for (const auto &[priority, n] : outbox_->depth_by_priority())
+        by_priority.emplace_back(std::to_string(priority), static_cast<double>(n));
+      m->queue_depth_by_priority.set_all(std::move(by_priority));
+
+      if (limiter_->config().enabled)
+      {
+        vix::sync::GaugeVec::Series limits;
+        for (const auto &t : limiter_->snapshot())
+          limits.emplace_back(t.target, t.limit);
+        m->concurrency_limit.set_all(std::move(limits));
+      }
+    }
 
-    return process_ready_(now_ms);
+    if (store)
+      st.bytes_persisted = store->bytes_written() - written;
+    st.total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+    return st;
   }
 
 } // namespace vix::sync::engine
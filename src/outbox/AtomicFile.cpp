@@ -0,0 +1,140 @@
+/**
+ *
+ *  @file AtomicFile.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include "AtomicFile.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace vix::sync::outbox::detail
+{
+  [[noreturn]] static void fail(const char *what, const std::filesystem::path &path, int err)
+  {
+    throw std::runtime_error(std::string("cannot ") + what + " " + path.string() + ": " + std::strerror(err));
+  }
+
+#if !defined(_WIN32)
+  static void write_all(int fd, std::string_view bytes, const std::filesystem::path &path)
+  {
+    while (!bytes.empty())
+    {
+      const auto n = ::write(fd, bytes.data(), bytes.size());
+      if (n < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        fail("write", path, errno);
+      }
+      bytes.remove_prefix(static_cast<std::size_t>(n));
+    }
+  }
+
+  static void sync_dir(const std::filesystem::path &dir)
+  {
+    const auto d = dir.empty() ? std::filesystem::path(".") : dir;
+    const int fd = ::open(d.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+      fail("open directory", d, errno);
+    const int rc = ::fsync(fd);
+    const int err = errno;
+    ::close(fd);
+    if (rc != 0)
+      fail("fsync directory", d, err);
+  }
+#endif
+
+  void write_file_atomic(const std::filesystem::path &path, std::string_view bytes, bool sync)
+  {
+    auto tmp = path;
+    tmp += ".tmp";
+
+#if !defined(_WIN32)
+    const int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+      fail("create", tmp, errno);
+
+    try
+    {
+      write_all(fd, bytes, tmp);
+      if (sync && ::fdatasync(fd) != 0)
+        fail("fdatasync", tmp, errno);
+    }
+    catch (...)
+    {
+      ::close(fd);
+      ::unlink(tmp.c_str());
+      throw;
+    }
+
+    if (::close(fd) != 0)
+    {
+      const int err = errno;
+      ::unlink(tmp.c_str());
+      fail("close", tmp, err);
+    }
+
+    if (::rename(tmp.c_str(), path.c_str()) != 0)
+    {
+      const int err = errno;
+      ::unlink(tmp.c_str());
+      fail("rename", tmp, err);
+    }
+
+    if (sync)
+      sync_dir(path.parent_path());
+#else
+    (void)sync;
+    {
+      std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+      out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+      out.close();
+      if (!out)
+        throw std::runtime_error("cannot write " + tmp.string());
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec)
+    {
+      std::filesystem::remove(tmp, ec);
+      throw std::runtime_error("cannot rename " + tmp.string() + " to " + path.string());
+    }
+#endif
+  }
+
+  void sync_file(const std::filesystem::path &path)
+  {
+#if !defined(_WIN32)
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      fail("open", path, errno);
+    const int rc = ::fsync(fd);
+    const int err = errno;
+    ::close(fd);
+    if (rc != 0)
+      fail("fsync", path, err);
+#else
+    (void)path;
+#endif
+  }
+
+} // namespace vix::sync::outbox::detail
@@ -0,0 +1,46 @@
+/**
+ *
+ *  @file AtomicFile.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_ATOMIC_FILE_HPP
+#define VIX_SYNC_ATOMIC_FILE_HPP
+
+#include <filesystem>
+#include <string_view>
+
+namespace vix::sync::outbox::detail
+{
+  /**
+   * @brief Replace the content of path with bytes, atomically.
+   *
+   * Bytes are written to "<path>.tmp", which is then renamed over path, so a
+   * crash leaves either the previous file or the new one, never a truncated
+   * mix. With sync, the temporary file is fdatasync()ed before the rename
+   * and the parent directory fsync()ed after it, making the new content
+   * durable once the call returns.
+   *
+   * @throws std::runtime_error if a step fails; path is then left untouched.
+   */
+  void write_file_atomic(const std::filesystem::path &path, std::string_view bytes, bool sync);
+
+  /**
+   * @brief fsync() the file at path (no-op where unsupported).
+   *
+   * @throws std::runtime_error if the file cannot be opened or synced.
+   */
+  void sync_file(const std::filesystem::path &path);
+
+} // namespace vix::sync::outbox::detail
+
+#endif // VIX_SYNC_ATOMIC_FILE_HPP
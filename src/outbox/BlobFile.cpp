@@ -0,0 +1,100 @@
+/**
+ *
+ *  @file BlobFile.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include "BlobFile.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace vix::sync::outbox::detail
+{
+
+  BlobFile::BlobFile(std::filesystem::path path) : path_(std::move(path))
+  {
+    std::error_code ec;
+    const auto sz = std::filesystem::file_size(path_, ec);
+    size_ = ec ? 0 : static_cast<std::uint64_t>(sz);
+  }
+
+  void BlobFile::open_for_append_()
+  {
+    if (out_.is_open())
+      return;
+
+    if (path_.has_parent_path())
+      std::filesystem::create_directories(path_.parent_path());
+
+    out_.open(path_, std::ios::binary | std::ios::app);
+    if (!out_.good())
+      throw std::runtime_error("BlobFile: cannot open blob file");
+  }
+
+  BlobRef BlobFile::append(std::string_view bytes)
+  {
+    open_for_append_();
+
+    BlobRef ref{size_, bytes.size()};
+    out_.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    out_.flush();
+    if (!out_.good())
+      throw std::runtime_error("BlobFile: cannot write blob file");
+
+    size_ += bytes.size();
+    return ref;
+  }
+
+  vix::sync::Payload BlobFile::load(const BlobRef &ref) const
+  {
+    if (ref.size == 0)
+      return {};
+    if (ref.offset + ref.size > size_)
+      throw std::runtime_error("BlobFile: blob out of range");
+
+#if !defined(_WIN32)
+    const int fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      throw std::runtime_error("BlobFile: cannot open blob file");
+
+    const auto page = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+    const auto map_offset = ref.offset - ref.offset % page;
+    const auto map_size = static_cast<std::size_t>(ref.size + (ref.offset - map_offset));
+
+    void *addr = ::mmap(nullptr, map_size, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(map_offset));
+    ::close(fd);
+    if (addr == MAP_FAILED)
+      throw std::runtime_error("BlobFile: cannot map blob");
+
+    std::shared_ptr<const void> mapping(addr, [map_size](const void *p)
+                                        { ::munmap(const_cast<void *>(p), map_size); });
+
+    const auto *bytes = static_cast<const char *>(addr) + (ref.offset - map_offset);
+    return vix::sync::Payload::adopt(std::move(mapping), std::string_view(bytes, ref.size));
+#else
+    std::ifstream in(path_, std::ios::binary);
+    std::string bytes(ref.size, '\0');
+    in.seekg(static_cast<std::streamoff>(ref.offset));
+    in.read(bytes.data(), static_cast<std::streamsize>(ref.size));
+    if (!in.good())
+      throw std::runtime_error("BlobFile: cannot read blob");
+    return vix::sync::Payload(std::move(bytes));
+#endif
+  }
+
+} // namespace vix::sync::outbox::detail
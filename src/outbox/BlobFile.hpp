@@ -0,0 +1,92 @@
+/**
+ *
+ *  @file BlobFile.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_BLOB_FILE_HPP
+#define VIX_SYNC_BLOB_FILE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+#include <vix/sync/Payload.hpp>
+
+namespace vix::sync::outbox::detail
+{
+  /**
+   * @brief Location of a payload inside a BlobFile.
+   */
+  struct BlobRef
+  {
+    std::uint64_t offset{0};
+    std::uint64_t size{0};
+  };
+
+  /**
+   * @brief Append-only file holding out-of-line payload bytes.
+   *
+   * Blobs are never modified in place. Space held by dropped blobs is
+   * reclaimed by copying the live blobs into a new file (see
+   * FileOutboxStore::compact_blobs()).
+   *
+   * load() memory-maps the blob region (POSIX), so bytes only become
+   * resident when they are actually read. Returned payloads stay valid
+   * after the file is replaced or unlinked.
+   *
+   * @note Not thread-safe; the owning store serializes access.
+   */
+  class BlobFile
+  {
+  public:
+    /**
+     * @brief Open (or lazily create) the blob file at path.
+     */
+    explicit BlobFile(std::filesystem::path path);
+
+    /**
+     * @brief Append bytes and return their location.
+     */
+    BlobRef append(std::string_view bytes);
+
+    /**
+     * @brief Payload viewing the bytes at ref, without copying them.
+     */
+    vix::sync::Payload load(const BlobRef &ref) const;
+
+    /**
+     * @brief Current file size in bytes, dropped blobs included.
+     */
+    std::uint64_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Path of the blob file.
+     */
+    const std::filesystem::path &path() const noexcept { return path_; }
+
+  private:
+    /**
+     * @brief Open the append stream on first write.
+     */
+    void open_for_append_();
+
+  private:
+    std::filesystem::path path_;
+    std::ofstream out_;
+    std::uint64_t size_{0};
+  };
+
+} // namespace vix::sync::outbox::detail
+
+#endif // VIX_SYNC_BLOB_FILE_HPP
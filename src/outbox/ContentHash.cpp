@@ -0,0 +1,106 @@
+/**
+ *
+ *  @file ContentHash.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include "ContentHash.hpp"
+
+#include <cstring>
+
+namespace vix::sync::outbox::detail
+{
+  namespace
+  {
+    constexpr std::uint64_t kP1 = 0x9E3779B185EBCA87ull;
+    constexpr std::uint64_t kP2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr std::uint64_t kP3 = 0x165667B19E3779F9ull;
+
+    inline std::uint64_t load64(const char *p) noexcept
+    {
+      std::uint64_t v;
+      std::memcpy(&v, p, sizeof(v));
+      return v;
+    }
+
+    inline std::uint64_t rotl(std::uint64_t x, int r) noexcept
+    {
+      return (x << r) | (x >> (64 - r));
+    }
+
+    inline std::uint64_t round(std::uint64_t acc, std::uint64_t input) noexcept
+    {
+      acc += input * kP2;
+      acc = rotl(acc, 31);
+      return acc * kP1;
+    }
+
+    inline std::uint64_t avalanche(std::uint64_t h) noexcept
+    {
+      h ^= h >> 33;
+      h *= kP2;
+      h ^= h >> 29;
+      h *= kP3;
+      h ^= h >> 32;
+      return h;
+    }
+  } // namespace
+
+  std::uint64_t content_hash(std::string_view bytes) noexcept
+  {
+    const char *p = bytes.data();
+    const std::size_t n = bytes.size();
+    const char *end = p + n;
+
+    std::uint64_t h;
+
+    if (n >= 32)
+    {
+      std::uint64_t v1 = kP1 + kP2;
+      std::uint64_t v2 = kP2;
+      std::uint64_t v3 = 0;
+      std::uint64_t v4 = 0 - kP1;
+
+      for (; p + 32 <= end; p += 32)
+      {
+        v1 = round(v1, load64(p));
+        v2 = round(v2, load64(p + 8));
+        v3 = round(v3, load64(p + 16));
+        v4 = round(v4, load64(p + 24));
+      }
+
+      h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+    }
+    else
+    {
+      h = kP3;
+    }
+
+    h += static_cast<std::uint64_t>(n);
+
+    for (; p + 8 <= end; p += 8)
+      h = rotl(h ^ round(0, load64(p)), 27) * kP1 + kP2;
+
+    for (; p < end; ++p)
+      h = rotl(h ^ (static_cast<std::uint8_t>(*p) * kP3), 11) * kP1;
+
+    return avalanche(h);
+  }
+
+  std::string hash_hex(std::uint64_t h)
+  {
+    static constexpr char kDigits[] = "0123456789abcdef";
+    std::string out(16, '0');
+    for (std::size_t i = 16; i-- > 0; h >>= 4)
+      out[i] = kDigits[h & 0xf];
+    return out;
+  }
+
+} // namespace vix::sync::outbox::detail
@@ -0,0 +1,40 @@
+/**
+ *
+ *  @file ContentHash.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_CONTENT_HASH_HPP
+#define VIX_SYNC_CONTENT_HASH_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace vix::sync::outbox::detail
+{
+  /**
+   * @brief Fast non-cryptographic 64-bit hash of a byte string.
+   *
+   * Consumes 32 bytes per round in four independent lanes. Used to find
+   * candidate duplicates only: callers must compare bytes on a match.
+   */
+  std::uint64_t content_hash(std::string_view bytes) noexcept;
+
+  /**
+   * @brief 16-digit lowercase hexadecimal form of a hash.
+   */
+  std::string hash_hex(std::uint64_t h);
+
+} // namespace vix::sync::outbox::detail
+
+#endif // VIX_SYNC_CONTENT_HASH_HPP
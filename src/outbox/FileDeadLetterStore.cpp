@@ -0,0 +1,177 @@
+/**
+ *
+ *  @file FileDeadLetterStore.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/sync/outbox/FileDeadLetterStore.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include "AtomicFile.hpp"
+#include "OperationJson.hpp"
+
+namespace vix::sync::outbox
+{
+  FileDeadLetterStore::FileDeadLetterStore(Config cfg) : cfg_(std::move(cfg)) {}
+
+  void FileDeadLetterStore::load_if_needed_()
+  {
+    if (loaded_)
+      return;
+
+    std::ifstream in(cfg_.file_path, std::ios::binary);
+    if (!in.good())
+    {
+      loaded_ = true;
+      return;
+    }
+    const std::string text(std::istreambuf_iterator<char>(in), {});
+
+    detail::JsonReader r(text);
+    std::string_view key;
+    r.begin_object();
+    while (r.next_key(key))
+    {
+      if (key != "ops" || !r.at_object())
+      {
+        r.skip_value();
+        continue;
+      }
+
+      std::string_view id;
+      r.begin_object();
+      while (r.next_key(id))
+      {
+        vix::sync::Operation op = detail::read_op(r);
+        order_.emplace(op.updated_at_ms, op.id);
+        ops_[op.id] = std::move(op);
+      }
+    }
+    r.finish();
+
+    loaded_ = true;
+  }
+
+  void FileDeadLetterStore::flush_()
+  {
+    std::filesystem::create_directories(cfg_.file_path.parent_path());
+
+    std::string text;
+    detail::JsonWriter w(text, cfg_.pretty_json ? 2 : -1);
+    w.begin_object();
+    w.key("version");
+    w.int_value(1);
+    w.key("ops");
+    w.begin_object();
+    for (const auto &[id, op] : ops_)
+    {
+      w.key(id);
+      detail::write_op(w, op);
+    }
+    w.end_object();
+    w.end_object();
+
+    try
+    {
+      detail::write_file_atomic(cfg_.file_path, text, false);
+    }
+    catch (const std::exception &e)
+    {
+      throw std::runtime_error(std::string("FileDeadLetterStore: ") + e.what());
+    }
+  }
+
+  void FileDeadLetterStore::put(const vix::sync::Operation &op)
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_if_needed_();
+
+    auto it = ops_.find(op.id);
+    if (it != ops_.end())
+    {
+      order_.erase({it->second.updated_at_ms, op.id});
+      it->second = op;
+    }
+    else
+    {
+      ops_.emplace(op.id, op);
+    }
+    order_.emplace(op.updated_at_ms, op.id);
+
+    flush_();
+  }
+
+  std::optional<vix::sync::Operation> FileDeadLetterStore::get(const std::string &id)
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_if_needed_();
+
+    auto it = ops_.find(id);
+    if (it == ops_.end())
+      return std::nullopt;
+    return it->second;
+  }
+
+  std::vector<vix::sync::Operation> FileDeadLetterStore::list(const DeadLetterQuery &q)
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_if_needed_();
+
+    std::vector<vix::sync::Operation> out;
+    std::size_t skipped = 0;
+
+    for (const auto &[ts, id] : order_)
+    {
+      if (out.size() >= q.limit)
+        break;
+
+      const auto &op = ops_.at(id);
+      if (!q.kind.empty() && op.kind != q.kind)
+        continue;
+      if (!q.target.empty() && op.target != q.target)
+        continue;
+
+      if (skipped < q.offset)
+      {
+        ++skipped;
+        continue;
+      }
+      out.push_back(op);
+    }
+    return out;
+  }
+
+  bool FileDeadLetterStore::remove(const std::string &id)
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_if_needed_();
+
+    auto it = ops_.find(id);
+    if (it == ops_.end())
+      return false;
+
+    order_.erase({it->second.updated_at_ms, id});
+    ops_.erase(it);
+    flush_();
+    return true;
+  }
+
+  std::size_t FileDeadLetterStore::count()
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_if_needed_();
+    return ops_.size();
+  }
+
+} // namespace vix::sync::outbox
@@ -13,121 +13,1019 @@
  */
 #include <vix/sync/outbox/FileOutboxStore.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <fstream>
+#include <iterator>
+#include <optional>
 #include <stdexcept>
+#include <utility>
 
-#include <vix/json/json.hpp>
+#include "../Probes.hpp"
+#include "../codec/Base64.hpp"
+#include "AtomicFile.hpp"
+#include "BlobFile.hpp"
+#include "ContentHash.hpp"
+#include "JsonStream.hpp"
+#include "OperationJson.hpp"
 
 namespace vix::sync::outbox
 {
-  using json = nlohmann::json;
-
-  static json op_to_json(const vix::sync::Operation &op)
-  {
-    return json{
-        {"id", op.id},
-        {"kind", op.kind},
-        {"target", op.target},
-        {"payload", op.payload},
-        {"idempotency_key", op.idempotency_key},
-        {"created_at_ms", op.created_at_ms},
-        {"updated_at_ms", op.updated_at_ms},
-        {"attempt", op.attempt},
-        {"next_retry_at_ms", op.next_retry_at_ms},
-        {"status", static_cast<int>(op.status)},
-        {"last_error", op.last_error},
-    };
+  static bool is_live(vix::sync::OperationStatus s) noexcept
+  {
+    return s != vix::sync::OperationStatus::Done &&
+           s != vix::sync::OperationStatus::PermanentFailed &&
+           s != vix::sync::OperationStatus::Expired;
   }
 
-  static vix::sync::Operation op_from_json(const json &j)
-  {
-    vix::sync::Operation op;
-    op.id = j.value("id", "");
-    op.kind = j.value("kind", "");
-    op.target = j.value("target", "");
-    op.payload = j.value("payload", "");
-    op.idempotency_key = j.value("idempotency_key", "");
-    op.created_at_ms = j.value("created_at_ms", 0LL);
-    op.updated_at_ms = j.value("updated_at_ms", 0LL);
-    op.attempt = j.value("attempt", 0u);
-    op.next_retry_at_ms = j.value("next_retry_at_ms", 0LL);
-    op.status = static_cast<vix::sync::OperationStatus>(j.value("status", 0));
-    op.last_error = j.value("last_error", "");
-    return op;
+  // Only fields that do not change after enqueue, so the footprint added to
+  // the depth when indexing is the one removed later.
+  static std::size_t footprint(const vix::sync::Operation &op) noexcept
+  {
+    return op.payload.size() + op.id.size() + op.kind.size() + op.target.size() +
+           op.idempotency_key.size() + op.coalesce_key.size();
+  }
+
+  static std::filesystem::path blob_path(const std::filesystem::path &file_path, std::uint64_t generation)
+  {
+    auto name = file_path.stem().string() + ".blob." + std::to_string(generation);
+    return file_path.parent_path() / name;
+  }
+
+  static vix::sync::Payload unpack(vix::sync::CodecId id, const vix::sync::Payload &stored, std::size_t raw_size)
+  {
+    if (id == vix::sync::CodecId::None)
+      return stored;
+
+    auto codec = vix::sync::find_codec(id);
+    if (!codec)
+      throw std::runtime_error("FileOutboxStore: payload compressed with an unavailable codec");
+    return vix::sync::Payload(codec->decompress(stored.view(), raw_size));
+  }
+
+  static vix::sync::CodecId codec_by_name(const std::string &name)
+  {
+    auto codec = vix::sync::find_codec(name);
+    if (!codec)
+      throw std::runtime_error("FileOutboxStore: unknown payload codec '" + name + "'");
+    return codec->id();
+  }
+
+  static detail::BlobRef read_blob_ref(detail::JsonReader &r)
+  {
+    detail::BlobRef ref;
+    std::string_view key;
+    r.begin_object();
+    while (r.next_key(key))
+    {
+      if (key == "offset")
+        ref.offset = r.uint_value();
+      else if (key == "size")
+        ref.size = r.uint_value();
+      else
+        r.skip_value();
+    }
+    return ref;
+  }
+
+  static void write_blob_ref(detail::JsonWriter &w, const detail::BlobRef &ref)
+  {
+    w.begin_object();
+    w.key("offset");
+    w.uint_value(ref.offset);
+    w.key("size");
+    w.uint_value(ref.size);
+    w.end_object();
+  }
+
+  // Calls fn(key, reader) for each member of an object (nothing for other
+  // values); fn must consume the member value.
+  template <class Fn>
+  static void for_each_member(std::string_view text, Fn &&fn)
+  {
+    if (text.empty())
+      return;
+
+    detail::JsonReader r(text);
+    if (!r.at_object())
+      return;
+
+    std::string_view key;
+    r.begin_object();
+    while (r.next_key(key))
+      fn(key, r);
+  }
+
+  struct FileOutboxStore::BlobState
+  {
+    std::uint64_t generation{0};
+    std::unique_ptr<detail::BlobFile> file;
+    std::unordered_map<std::string, detail::BlobRef> refs;
+    std::unordered_map<std::string, detail::BlobRef> content_refs;
+    std::uint64_t live_bytes{0};
+    std::filesystem::path retired;
+  };
+
+  FileOutboxStore::FileOutboxStore(Config cfg) : cfg_(std::move(cfg))
+  {
+    if (cfg_.file_path.empty())
+    {
+      cfg_.blob_threshold_bytes = 0;
+      loaded_ = true;
+    }
+    else if (cfg_.flush_interval_ms > 0)
+    {
+      flusher_ = std::thread([this]
+                             { flusher_loop_(); });
+    }
+  }
+
+  FileOutboxStore::~FileOutboxStore()
+  {
+    if (flusher_.joinable())
+    {
+      {
+        std::lock_guard<std::mutex> lk(mu_);
+        stop_ = true;
+      }
+      flush_cv_.notify_one();
+      flusher_.join();
+    }
+
+    try
+    {
+      flush();
+    }
+    catch (...)
+    {
+    }
+  }
+
+  void FileOutboxStore::flush()
+  {
+    std::lock_guard<std::mutex> wl(write_mu_);
+    std::unique_lock<std::mutex> lk(mu_);
+    write_dirty_(lk);
+  }
+
+  void FileOutboxStore::flusher_loop_()
+  {
+    const auto interval = std::chrono::milliseconds(cfg_.flush_interval_ms);
+    for (;;)
+    {
+      {
+        std::unique_lock<std::mutex> lk(mu_);
+        flush_cv_.wait(lk, [this]
+                       { return stop_ || dirty_.load(std::memory_order_relaxed); });
+
+        // Let the mutations of the interval share this write.
+        flush_cv_.wait_for(lk, interval, [this]
+                           { return stop_; });
+        if (stop_)
+          return; // the destructor writes what is left
+      }
+
+      try
+      {
+        flush();
+      }
+      catch (...)
+      {
+        // Still dirty: retried after the next interval.
+      }
+    }
+  }
+
+  std::size_t FileOutboxStore::footprint_(const vix::sync::Operation &op) const
+  {
+    auto n = footprint(op);
+    if (auto c = op_content_.find(op.id); c != op_content_.end())
+      return n + contents_.at(c->second).size;
+
+    // Budgets count original bytes, whatever the stored form.
+    if (auto p = packing_.find(op.id); p != packing_.end())
+      return n - op.payload.size() + p->second.raw_size;
+
+    if (blobs_)
+    {
+      if (auto it = blobs_->refs.find(op.id); it != blobs_->refs.end())
+        n += static_cast<std::size_t>(it->second.size);
+    }
+    return n;
+  }
+
+  vix::sync::Operation FileOutboxStore::with_payload_(const vix::sync::Operation &op) const
+  {
+    if (auto c = op_content_.find(op.id); c != op_content_.end())
+    {
+      vix::sync::Operation out = op;
+      out.payload = content_bytes_(c->second);
+      return out;
+    }
+
+    auto p = packing_.find(op.id);
+    const bool blob = blobs_ && blobs_->refs.count(op.id) != 0;
+    if (p == packing_.end() && !blob)
+      return op;
+
+    vix::sync::Operation out = op;
+    if (blob)
+      out.payload = blobs_->file->load(blobs_->refs.at(op.id));
+    if (p != packing_.end())
+      out.payload = unpack(p->second.codec, out.payload, p->second.raw_size);
+    return out;
+  }
+
+  void FileOutboxStore::blob_store_(const std::string &key, std::string_view bytes, bool content)
+  {
+    if (!blobs_)
+      blobs_ = std::make_unique<BlobState>();
+    if (!blobs_->file)
+      blobs_->file = std::make_unique<detail::BlobFile>(blob_path(cfg_.file_path, blobs_->generation));
+
+    // Bytes reach the blob file before the JSON file refers to them.
+    auto &refs = content ? blobs_->content_refs : blobs_->refs;
+    refs[key] = blobs_->file->append(bytes);
+    blobs_->live_bytes += bytes.size();
+  }
+
+  void FileOutboxStore::blob_release_(const std::string &key, bool content)
+  {
+    if (!blobs_)
+      return;
+
+    auto &refs = content ? blobs_->content_refs : blobs_->refs;
+    auto it = refs.find(key);
+    if (it == refs.end())
+      return;
+
+    blobs_->live_bytes -= it->second.size;
+    refs.erase(it);
+  }
+
+  vix::sync::Payload FileOutboxStore::content_bytes_(const std::string &cid) const
+  {
+    const auto &c = contents_.at(cid);
+    if (c.size == 0)
+      return c.payload;
+
+    if (c.payload.empty())
+      return unpack(c.codec, blobs_->file->load(blobs_->content_refs.at(cid)), c.size);
+    return unpack(c.codec, c.payload, c.size);
+  }
+
+  std::string FileOutboxStore::content_acquire_(const vix::sync::Payload &bytes)
+  {
+    const auto h = detail::content_hash(bytes.view());
+
+    auto [first, last] = content_by_hash_.equal_range(h);
+    std::size_t collisions = 0;
+    for (auto it = first; it != last; ++it, ++collisions)
+    {
+      auto &c = contents_.at(it->second);
+      if (c.size == bytes.size() && content_bytes_(it->second) == bytes.view())
+      {
+        ++c.refs;
+        return it->second;
+      }
+    }
+
+    auto cid = detail::hash_hex(h);
+    if (collisions > 0)
+      cid += '-' + std::to_string(collisions);
+    while (contents_.count(cid) != 0)
+      cid += '+';
+
+    Content c;
+    c.size = bytes.size();
+    c.refs = 1;
+    c.hash = h;
+    vix::sync::Payload stored = bytes;
+    if (auto packed = vix::sync::compress_payload(cfg_.compression, bytes.view()))
+    {
+      c.codec = cfg_.compression.codec;
+      stored = vix::sync::Payload(std::move(*packed));
+    }
+
+    if (cfg_.blob_threshold_bytes > 0 && bytes.size() >= cfg_.blob_threshold_bytes)
+      blob_store_(cid, stored.view(), true);
+    else
+      c.payload = std::move(stored);
+
+    contents_.emplace(cid, std::move(c));
+    content_by_hash_.emplace(h, cid);
+    return cid;
+  }
+
+  void FileOutboxStore::payload_release_(const std::string &id)
+  {
+    auto it = op_content_.find(id);
+    if (it == op_content_.end())
+    {
+      packing_.erase(id);
+      blob_release_(id, false);
+      return;
+    }
+
+    const auto cid = std::move(it->second);
+    op_content_.erase(it);
+
+    auto c = contents_.find(cid);
+    if (c == contents_.end() || --c->second.refs > 0)
+      return;
+
+    auto [first, last] = content_by_hash_.equal_range(c->second.hash);
+    for (auto h = first; h != last; ++h)
+    {
+      if (h->second == cid)
+      {
+        content_by_hash_.erase(h);
+        break;
+      }
+    }
+
+    blob_release_(cid, true);
+    contents_.erase(c);
+  }
+
+  vix::sync::Payload FileOutboxStore::payload_store_(const vix::sync::Operation &op)
+  {
+    vix::sync::Payload stored = op.payload;
+    if (auto packed = vix::sync::compress_payload(cfg_.compression, op.payload.view()))
+    {
+      packing_[op.id] = Packing{cfg_.compression.codec, op.payload.size()};
+      stored = vix::sync::Payload(std::move(*packed));
+    }
+
+    if (cfg_.blob_threshold_bytes > 0 && op.payload.size() >= cfg_.blob_threshold_bytes)
+    {
+      blob_store_(op.id, stored.view(), false);
+      return {};
+    }
+    return stored;
+  }
+
+  std::uint64_t FileOutboxStore::compact_blobs_()
+  {
+    if (!blobs_ || !blobs_->file)
+      return 0;
+
+    // The new generation is only referenced once the JSON file is flushed;
+    // the old file is removed after that (see flush_()).
+    const auto generation = blobs_->generation + 1;
+    const auto path = blob_path(cfg_.file_path, generation);
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+
+    auto next = std::make_unique<detail::BlobFile>(path);
+    for (auto &[id, ref] : blobs_->refs)
+    {
+      ref = next->append(blobs_->file->load(ref).view());
+      touch_(id);
+    }
+    for (auto &[cid, ref] : blobs_->content_refs)
+      ref = next->append(blobs_->file->load(ref).view());
+
+    const auto reclaimed = blobs_->file->size() - next->size();
+
+    // Until the JSON file is written it references the first retired file;
+    // files of later compactions were never referenced on disk.
+    if (blobs_->retired.empty())
+      blobs_->retired = blobs_->file->path();
+    else
+      std::filesystem::remove(blobs_->file->path(), ec);
+    blobs_->file = std::move(next);
+    blobs_->generation = generation;
+    return reclaimed;
   }
 
-  FileOutboxStore::FileOutboxStore(Config cfg) : cfg_(std::move(cfg)) {}
+  std::uint64_t FileOutboxStore::compact_blobs()
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_if_needed_();
+
+    const auto reclaimed = compact_blobs_();
+    if (blobs_ && !blobs_->retired.empty())
+      flush_();
+    return reclaimed;
+  }
+
+  void FileOutboxStore::index_add_(const vix::sync::Operation &op)
+  {
+    if (!is_live(op.status))
+      return;
+    if (!live_[op.priority].emplace(op.created_at_ms, op.id).second)
+      return;
+
+    depth_.ops += 1;
+    depth_.bytes += footprint_(op);
+    idempotency_track_(op, true, 0);
+
+    if (!op.coalesce_key.empty())
+      by_coalesce_key_[op.coalesce_key].emplace(op.created_at_ms, op.id);
+    if (op.deadline_at_ms > 0)
+      deadlines_.emplace(op.deadline_at_ms, op.id);
+  }
+
+  void FileOutboxStore::index_remove_(const vix::sync::Operation &op)
+  {
+    auto it = live_.find(op.priority);
+    if (it == live_.end() || it->second.erase({op.created_at_ms, op.id}) == 0)
+      return;
+    if (it->second.empty())
+      live_.erase(it);
+
+    depth_.ops -= 1;
+    depth_.bytes -= footprint_(op);
+
+    if (op.deadline_at_ms > 0)
+      deadlines_.erase({op.deadline_at_ms, op.id});
+
+    if (op.coalesce_key.empty())
+      return;
+
+    if (auto kit = by_coalesce_key_.find(op.coalesce_key); kit != by_coalesce_key_.end())
+    {
+      kit->second.erase({op.created_at_ms, op.id});
+      if (kit->second.empty())
+        by_coalesce_key_.erase(kit);
+    }
+  }
 
   void FileOutboxStore::load_if_needed_()
   {
     if (loaded_)
       return;
 
-    std::ifstream in(cfg_.file_path);
+    std::ifstream in(cfg_.file_path, std::ios::binary);
     if (!in.good())
     {
       loaded_ = true;
       return;
     }
+    const std::string text(std::istreambuf_iterator<char>(in), {});
 
-    json root;
-    in >> root;
+    // Sections may come in any order; read them in dependency order.
+    std::string blob_file;
+    std::string_view contents_text, ops_text, keys_text, owners_text;
+    {
+      detail::JsonReader r(text);
+      std::string_view key;
+      r.begin_object();
+      while (r.next_key(key))
+      {
+        if (key == "blob_file")
+          r.string(blob_file);
+        else if (key == "contents")
+          contents_text = r.raw_value();
+        else if (key == "ops")
+          ops_text = r.raw_value();
+        else if (key == "idempotency")
+          keys_text = r.raw_value();
+        else if (key == "owners")
+          owners_text = r.raw_value();
+        else
+          r.skip_value();
+      }
+      r.finish();
+    }
 
-    auto ops = root.value("ops", json::object());
-    for (auto it = ops.begin(); it != ops.end(); ++it)
+    if (!blob_file.empty())
     {
-      vix::sync::Operation op = op_from_json(it.value());
-      ops_[op.id] = std::move(op);
+      blobs_ = std::make_unique<BlobState>();
+      blobs_->generation = std::strtoull(blob_file.substr(blob_file.rfind('.') + 1).c_str(), nullptr, 10);
+      blobs_->file = std::make_unique<detail::BlobFile>(cfg_.file_path.parent_path() / blob_file);
     }
 
-    auto owners = root.value("owners", json::object());
-    for (auto it = owners.begin(); it != owners.end(); ++it)
+    auto read_content = [&](std::string_view key, detail::JsonReader &r)
     {
-      owner_[it.key()] = it.value().get<std::string>();
+      std::string cid(key);
+      Content c;
+      c.hash = std::strtoull(cid.substr(0, 16).c_str(), nullptr, 16);
+
+      std::optional<detail::BlobRef> ref;
+      std::optional<std::string> codec;
+      std::string payload;
+      std::size_t size = 0;
+
+      std::string_view field;
+      r.begin_object();
+      while (r.next_key(field))
+      {
+        if (field == "payload_ref")
+          ref = read_blob_ref(r);
+        else if (field == "payload")
+          r.string(payload);
+        else if (field == "codec")
+          r.string(codec.emplace());
+        else if (field == "size")
+          size = static_cast<std::size_t>(r.uint_value());
+        else
+          r.skip_value();
+      }
+
+      if (blobs_ && ref)
+      {
+        blobs_->content_refs[cid] = *ref;
+        blobs_->live_bytes += ref->size;
+        c.size = static_cast<std::size_t>(ref->size);
+      }
+      else
+      {
+        c.payload = std::move(payload);
+        c.size = c.payload.size();
+      }
+      if (codec)
+      {
+        c.codec = codec_by_name(*codec);
+        c.size = size;
+        if (!c.payload.empty())
+          c.payload = vix::sync::detail::base64_decode(c.payload.view());
+      }
+      content_by_hash_.emplace(c.hash, cid);
+      contents_.emplace(std::move(cid), std::move(c));
+    };
+    for_each_member(contents_text, read_content);
+
+    auto read_op_entry = [&](std::string_view, detail::JsonReader &r)
+    {
+      std::optional<std::string> codec;
+      std::size_t payload_size = 0;
+      std::optional<detail::BlobRef> ref;
+      std::string cid;
+
+      auto extra = [&](std::string_view field)
+      {
+        if (field == "payload_codec")
+          r.string(codec.emplace());
+        else if (field == "payload_size")
+          payload_size = static_cast<std::size_t>(r.uint_value());
+        else if (field == "payload_ref")
+          ref = read_blob_ref(r);
+        else if (field == "payload_content")
+          r.string(cid);
+        else
+          return false;
+        return true;
+      };
+      vix::sync::Operation op = detail::read_op(r, extra);
+
+      if (codec)
+      {
+        packing_[op.id] = Packing{codec_by_name(*codec), payload_size};
+        if (!op.payload.empty())
+          op.payload = vix::sync::detail::base64_decode(op.payload.view());
+      }
+      if (blobs_ && ref)
+      {
+        blobs_->refs[op.id] = *ref;
+        blobs_->live_bytes += ref->size;
+      }
+      if (!cid.empty())
+      {
+        if (auto c = contents_.find(cid); c != contents_.end())
+        {
+          ++c->second.refs;
+          op_content_[op.id] = std::move(cid);
+        }
+      }
+      index_add_(op);
+      if (!is_live(op.status))
+        idempotency_track_(op, false, op.updated_at_ms);
+      ops_[op.id] = std::move(op);
+    };
+    for_each_member(ops_text, read_op_entry);
+
+    // Keys of terminal operations that were pruned since.
+    auto read_key = [&](std::string_view key, detail::JsonReader &r)
+    {
+      std::string k(key);
+      IdempotencyEntry e{{}, false, 0};
+
+      std::string_view field;
+      r.begin_object();
+      while (r.next_key(field))
+      {
+        if (field == "id")
+          r.string(e.id);
+        else if (field == "done_at_ms")
+          e.done_at_ms = r.int_value();
+        else
+          r.skip_value();
+      }
+
+      if (idempotency_.count(k) != 0)
+        return;
+      idempotency_expiry_.emplace(e.done_at_ms, k);
+      idempotency_[std::move(k)] = std::move(e);
+    };
+    for_each_member(keys_text, read_key);
+
+    for (auto c = contents_.begin(); c != contents_.end();)
+    {
+      if (c->second.refs > 0)
+      {
+        ++c;
+        continue;
+      }
+      blob_release_(c->first, true);
+      c = contents_.erase(c);
     }
+    if (content_by_hash_.size() != contents_.size())
+      std::erase_if(content_by_hash_, [&](const auto &e)
+                    { return contents_.count(e.second) == 0; });
+
+    for_each_member(owners_text, [&](std::string_view key, detail::JsonReader &r)
+                    { r.string(owner_[std::string(key)]); });
 
     loaded_ = true;
   }
 
   void FileOutboxStore::flush_()
   {
-    std::filesystem::create_directories(cfg_.file_path.parent_path());
+    if (cfg_.file_path.empty())
+      return;
+
+    if (cfg_.flush_interval_ms > 0)
+    {
+      if (!dirty_.exchange(true, std::memory_order_relaxed))
+        flush_cv_.notify_one();
+      return;
+    }
+
+    const auto &m = cfg_.metrics;
+    vix::sync::ScopedTimer timer(m ? &m->store_flush_latency : nullptr);
+
+    auto r = render_();
+    try
+    {
+      write_(r);
+    }
+    catch (...)
+    {
+      unretire_(r);
+      throw;
+    }
+  }
+
+  void FileOutboxStore::write_dirty_(std::unique_lock<std::mutex> &lk)
+  {
+    if (!dirty_.load(std::memory_order_relaxed))
+      return;
+
+    const auto &m = cfg_.metrics;
+    vix::sync::ScopedTimer timer(m ? &m->store_flush_latency : nullptr);
+
+    auto r = render_();
+    dirty_.store(false, std::memory_order_relaxed);
+    lk.unlock();
+
+    try
+    {
+      write_(r);
+    }
+    catch (...)
+    {
+      lk.lock();
+      dirty_.store(true, std::memory_order_relaxed);
+      unretire_(r);
+      throw;
+    }
+  }
+
+  void FileOutboxStore::unretire_(const Rendered &r)
+  {
+    if (r.retired.empty() || !blobs_)
+      return;
+
+    // The file on disk still references r.retired; a file retired since
+    // was never referenced on disk.
+    std::error_code ec;
+    if (!blobs_->retired.empty())
+      std::filesystem::remove(blobs_->retired, ec);
+    blobs_->retired = r.retired;
+  }
+
+  std::string FileOutboxStore::encode_op_(const vix::sync::Operation &op) const
+  {
+    const auto packing = packing_.find(op.id);
+
+    std::string encoded;
+    std::string_view payload = op.payload.view();
+    if (packing != packing_.end() && !payload.empty())
+    {
+      encoded = vix::sync::detail::base64_encode(payload);
+      payload = encoded;
+    }
+
+    // Members sit two levels deep: root, then "ops".
+    std::string out;
+    detail::append_json_string(out, op.id);
+    out += cfg_.pretty_json ? ": " : ":";
+
+    detail::JsonWriter w(out, cfg_.pretty_json ? 2 : -1, 2);
+    w.begin_object();
+    detail::write_op_fields(w, op, payload);
+    if (auto c = op_content_.find(op.id); c != op_content_.end())
+    {
+      w.key("payload_content");
+      w.string(c->second);
+    }
+    else if (blobs_)
+    {
+      if (auto it = blobs_->refs.find(op.id); it != blobs_->refs.end())
+      {
+        w.key("payload_ref");
+        write_blob_ref(w, it->second);
+      }
+    }
+    if (packing != packing_.end())
+    {
+      w.key("payload_codec");
+      w.string(vix::sync::find_codec(packing->second.codec)->name());
+      w.key("payload_size");
+      w.uint_value(packing->second.raw_size);
+    }
+    w.end_object();
+    return out;
+  }
+
+  FileOutboxStore::Rendered FileOutboxStore::render_()
+  {
+    VIX_SYNC_PROBE1(store__flush__start, ops_.size());
 
-    json root;
-    root["version"] = 1;
+    if (blobs_ && blobs_->file)
+    {
+      const auto garbage = blobs_->file->size() - blobs_->live_bytes;
+      if (garbage > 0 && garbage >= cfg_.blob_compact_min_bytes &&
+          static_cast<double>(garbage) >= cfg_.blob_compact_ratio * static_cast<double>(blobs_->file->size()))
+        compact_blobs_();
+    }
 
-    json ops = json::object();
+    // Cached members are copied as is; only changed operations are encoded.
+    Rendered r;
+    std::vector<const std::string *> members;
+    members.reserve(ops_.size());
+    std::size_t members_bytes = 0;
     for (const auto &[id, op] : ops_)
     {
-      ops[id] = op_to_json(op);
+      auto it = op_json_.find(id);
+      if (it == op_json_.end())
+      {
+        it = op_json_.emplace(id, encode_op_(op)).first;
+        ++r.encoded;
+      }
+      members.push_back(&it->second);
+      members_bytes += it->second.size() + 8;
     }
-    root["ops"] = std::move(ops);
 
-    json owners = json::object();
+    r.text.reserve(members_bytes + 64 * (contents_.size() + owner_.size() + idempotency_.size()) + 128);
+
+    detail::JsonWriter w(r.text, cfg_.pretty_json ? 2 : -1);
+    w.begin_object();
+    w.key("version");
+    w.int_value(1);
+
+    w.key("ops");
+    w.begin_object();
+    for (const auto *member : members)
+      w.raw_member(*member);
+    w.end_object();
+
+    if (!contents_.empty())
+    {
+      w.key("contents");
+      w.begin_object();
+      for (const auto &[cid, c] : contents_)
+      {
+        w.key(cid);
+        w.begin_object();
+        const detail::BlobRef *ref = nullptr;
+        if (blobs_)
+        {
+          if (auto it = blobs_->content_refs.find(cid); it != blobs_->content_refs.end())
+            ref = &it->second;
+        }
+        if (ref)
+        {
+          w.key("payload_ref");
+          write_blob_ref(w, *ref);
+        }
+        else
+        {
+          w.key("payload");
+          if (c.codec != vix::sync::CodecId::None)
+            w.string(vix::sync::detail::base64_encode(c.payload.view()));
+          else
+            w.string(c.payload.view());
+        }
+        if (c.codec != vix::sync::CodecId::None)
+        {
+          w.key("codec");
+          w.string(vix::sync::find_codec(c.codec)->name());
+          w.key("size");
+          w.uint_value(c.size);
+        }
+        w.end_object();
+      }
+      w.end_object();
+    }
+
+    if (blobs_ && blobs_->file)
+    {
+      w.key("blob_file");
+      w.string(blobs_->file->path().filename().string());
+    }
+
+    w.key("owners");
+    w.begin_object();
     for (const auto &[id, o] : owner_)
     {
-      owners[id] = o;
+      w.key(id);
+      w.string(o);
+    }
+    w.end_object();
+
+    w.key("idempotency");
+    w.begin_object();
+    for (const auto &[key, e] : idempotency_)
+    {
+      if (e.live)
+        continue;
+      w.key(key);
+      w.begin_object();
+      w.key("id");
+      w.string(e.id);
+      w.key("done_at_ms");
+      w.int_value(e.done_at_ms);
+      w.end_object();
     }
-    root["owners"] = std::move(owners);
+    w.end_object();
 
-    std::ofstream out(cfg_.file_path, std::ios::trunc);
-    if (!out.good())
-      throw std::runtime_error("FileOutboxStore: cannot write outbox file");
+    w.end_object();
+    r.ops = ops_.size();
+    if (blobs_)
+    {
+      if (blobs_->file)
+        r.blob_file = blobs_->file->path();
+      r.retired = std::exchange(blobs_->retired, {});
+    }
+    return r;
+  }
 
-    if (cfg_.pretty_json)
-      out << root.dump(2);
+  void FileOutboxStore::write_(const Rendered &r)
+  {
+    std::filesystem::create_directories(cfg_.file_path.parent_path());
+
+    // Blobs must be durable before the JSON file references them.
+    if (cfg_.fsync_on_write && !r.blob_file.empty() && std::filesystem::exists(r.blob_file))
+      detail::sync_file(r.blob_file);
+
+    try
+    {
+      detail::write_file_atomic(cfg_.file_path, r.text, cfg_.fsync_on_write);
+    }
+    catch (const std::exception &e)
+    {
+      throw std::runtime_error(std::string("FileOutboxStore: ") + e.what());
+    }
+
+    if (const auto &m = cfg_.metrics)
+    {
+      m->store_flushes.add();
+      m->store_flush_bytes.add(r.text.size());
+      m->store_ops_encoded.add(r.encoded);
+    }
+    bytes_written_.fetch_add(r.text.size(), std::memory_order_relaxed);
+    VIX_SYNC_PROBE2(store__flush__done, r.ops, r.text.size());
+
+    if (!r.retired.empty())
+    {
+      std::error_code ec;
+      std::filesystem::remove(r.retired, ec);
+    }
+  }
+
+  void FileOutboxStore::upsert_(const vix::sync::Operation &op)
+  {
+    touch_(op.id);
+
+    auto it = ops_.find(op.id);
+    if (it != ops_.end())
+      index_remove_(it->second);
+
+    vix::sync::Operation stored = op;
+    if (cfg_.dedupe_payloads && !op.payload.empty())
+    {
+      // Acquire before releasing the previous payload, so re-putting an
+      // operation never drops and re-stores its own content.
+      auto cid = content_acquire_(op.payload);
+      payload_release_(op.id);
+      op_content_[op.id] = std::move(cid);
+      stored.payload = {};
+    }
     else
-      out << root.dump();
+    {
+      payload_release_(op.id);
+      stored.payload = payload_store_(op);
+    }
+
+    auto &slot = ops_[op.id];
+    slot = std::move(stored);
+    index_add_(slot);
+
+    if (!is_live(slot.status))
+      idempotency_track_(slot, false, slot.updated_at_ms);
   }
 
   void FileOutboxStore::put(const vix::sync::Operation &op)
   {
     std::lock_guard<std::mutex> lk(mu_);
     load_if_needed_();
-    ops_[op.id] = op;
+
+    upsert_(op);
     flush_();
   }
 
+  std::string FileOutboxStore::put_idempotent(const vix::sync::Operation &op, std::int64_t now_ms)
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_if_needed_();
+
+    if (!op.idempotency_key.empty())
+    {
+      if (auto existing = find_idempotent_(op.idempotency_key, now_ms))
+        return *existing;
+    }
+
+    upsert_(op);
+    flush_();
+    return op.id;
+  }
+
+  std::optional<std::string> FileOutboxStore::find_by_idempotency_key(
+      const std::string &idempotency_key,
+      std::int64_t now_ms)
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_if_needed_();
+    return find_idempotent_(idempotency_key, now_ms);
+  }
+
+  std::optional<std::string> FileOutboxStore::find_idempotent_(const std::string &key, std::int64_t now_ms)
+  {
+    idempotency_purge_(now_ms);
+
+    auto it = idempotency_.find(key);
+    if (it == idempotency_.end())
+      return std::nullopt;
+    return it->second.id;
+  }
+
+  void FileOutboxStore::idempotency_track_(const vix::sync::Operation &op, bool live, std::int64_t done_at_ms)
+  {
+    if (op.idempotency_key.empty())
+      return;
+
+    auto &e = idempotency_[op.idempotency_key];
+    if (!e.live)
+      idempotency_expiry_.erase({e.done_at_ms, op.idempotency_key});
+
+    e.id = op.id;
+    e.live = live;
+    e.done_at_ms = live ? 0 : done_at_ms;
+
+    if (!live)
+      idempotency_expiry_.emplace(e.done_at_ms, op.idempotency_key);
+  }
+
+  void FileOutboxStore::idempotency_forget_(const vix::sync::Operation &op)
+  {
+    if (op.idempotency_key.empty())
+      return;
+
+    auto it = idempotency_.find(op.idempotency_key);
+    if (it == idempotency_.end() || it->second.id != op.id)
+      return;
+
+    if (!it->second.live)
+      idempotency_expiry_.erase({it->second.done_at_ms, op.idempotency_key});
+    idempotency_.erase(it);
+  }
+
+  void FileOutboxStore::idempotency_purge_(std::int64_t now_ms)
+  {
+    const auto cutoff = now_ms - cfg_.idempotency_retention_ms;
+
+    while (!idempotency_expiry_.empty() && idempotency_expiry_.begin()->first <= cutoff)
+    {
+      idempotency_.erase(idempotency_expiry_.begin()->second);
+      idempotency_expiry_.erase(idempotency_expiry_.begin());
+    }
+  }
+
   std::optional<vix::sync::Operation> FileOutboxStore::get(const std::string &id)
   {
     std::lock_guard<std::mutex> lk(mu_);
@@ -135,7 +1033,7 @@ namespace vix::sync::outbox
     auto it = ops_.find(id);
     if (it == ops_.end())
       return std::nullopt;
-    return it->second;
+    return with_payload_(it->second);
   }
 
   std::vector<vix::sync::Operation> FileOutboxStore::list(const ListOptions &opt)
@@ -144,28 +1042,91 @@ namespace vix::sync::outbox
     load_if_needed_();
 
     std::vector<vix::sync::Operation> out;
-    out.reserve(opt.limit);
+    out.reserve(std::min(opt.limit, ops_.size()));
 
-    for (const auto &[id, op] : ops_)
+    // Returns false once the limit is reached.
+    auto visit = [&](const std::string &id) -> bool
     {
+      auto it = ops_.find(id);
+      if (it == ops_.end())
+        return true;
+
+      const auto &op = it->second;
       const bool is_ready = (op.next_retry_at_ms <= opt.now_ms);
       const bool is_inflight = (op.status == vix::sync::OperationStatus::InFlight);
 
       if (!opt.include_inflight && is_inflight)
-        continue;
+        return true;
       if (opt.only_ready && !is_ready)
-        continue;
+        return true;
+      if (op.is_expired(opt.now_ms))
+        return true;
+      if (opt.skip && opt.skip(op))
+        return true;
 
-      if (op.status == vix::sync::OperationStatus::Done)
-        continue;
+      out.push_back(with_payload_(op));
+      return out.size() < opt.limit;
+    };
 
-      if (op.status == vix::sync::OperationStatus::PermanentFailed)
-        continue;
+    if (opt.limit == 0)
+      return out;
+
+    if (opt.priority_aging_ms <= 0)
+    {
+      for (const auto &[priority, fifo] : live_)
+      {
+        for (const auto &[created_at, id] : fifo)
+        {
+          if (!visit(id))
+            return out;
+        }
+      }
+      return out;
+    }
+
+    // Aging: merge priority classes by created_at - priority * aging, i.e.
+    // waiting one aging window is worth one priority level.
+    using FifoIt = std::set<std::pair<std::int64_t, std::string>>::const_iterator;
+    struct Cursor
+    {
+      FifoIt cur;
+      FifoIt end;
+      std::int64_t bonus;
+    };
+
+    std::vector<Cursor> cursors;
+    cursors.reserve(live_.size());
+    for (const auto &[priority, fifo] : live_)
+    {
+      cursors.push_back({fifo.begin(), fifo.end(), static_cast<std::int64_t>(priority) * opt.priority_aging_ms});
+    }
+
+    while (true)
+    {
+      Cursor *best = nullptr;
+      std::int64_t best_score = 0;
 
-      out.push_back(op);
-      if (out.size() >= opt.limit)
+      for (auto &c : cursors)
+      {
+        if (c.cur == c.end)
+          continue;
+        const auto score = c.cur->first - c.bonus;
+        if (!best || score < best_score)
+        {
+          best = &c;
+          best_score = score;
+        }
+      }
+
+      if (!best)
+        break;
+
+      const auto &id = best->cur->second;
+      ++best->cur;
+      if (!visit(id))
         break;
     }
+
     return out;
   }
 
@@ -180,7 +1141,7 @@ namespace vix::sync::outbox
 
     auto &op = it->second;
 
-    if (op.status == vix::sync::OperationStatus::Done)
+    if (!is_live(op.status))
       return false;
     if (op.status == vix::sync::OperationStatus::InFlight)
       return false;
@@ -188,6 +1149,7 @@ namespace vix::sync::outbox
     op.status = vix::sync::OperationStatus::InFlight;
     op.updated_at_ms = now_ms;
     owner_[id] = owner;
+    touch_(id);
     flush_();
     return true;
   }
@@ -202,9 +1164,12 @@ namespace vix::sync::outbox
       return false;
 
     auto &op = it->second;
+    index_remove_(op);
     op.status = vix::sync::OperationStatus::Done;
     op.updated_at_ms = now_ms;
     op.last_error.clear();
+    idempotency_track_(op, false, now_ms);
+    touch_(id);
 
     owner_.erase(id);
     flush_();
@@ -225,10 +1190,13 @@ namespace vix::sync::outbox
       return false;
 
     auto &op = it->second;
+    index_remove_(op);
     op.status = vix::sync::OperationStatus::Failed;
     op.last_error = error;
     op.updated_at_ms = now_ms;
     op.next_retry_at_ms = next_retry_at_ms;
+    index_add_(op);
+    touch_(id);
 
     owner_.erase(id);
     flush_();
@@ -244,9 +1212,13 @@ namespace vix::sync::outbox
     for (auto it = ops_.begin(); it != ops_.end();)
     {
       const auto &op = it->second;
-      if (op.status == vix::sync::OperationStatus::Done && op.updated_at_ms <= older_than_ms)
+      const bool finished = op.status == vix::sync::OperationStatus::Done ||
+                            op.status == vix::sync::OperationStatus::Expired;
+      if (finished && op.updated_at_ms <= older_than_ms)
       {
+        payload_release_(it->first);
         owner_.erase(it->first);
+        touch_(it->first);
         it = ops_.erase(it);
         ++removed;
       }
@@ -274,10 +1246,13 @@ namespace vix::sync::outbox
       return false;
 
     auto &op = it->second;
+    index_remove_(op);
     op.status = vix::sync::OperationStatus::PermanentFailed;
     op.last_error = error;
     op.updated_at_ms = now_ms;
     op.next_retry_at_ms = now_ms;
+    idempotency_track_(op, false, now_ms);
+    touch_(id);
 
     owner_.erase(id);
     flush_();
@@ -307,6 +1282,7 @@ namespace vix::sync::outbox
       op.updated_at_ms = now_ms;
       op.next_retry_at_ms = now_ms;
       op.last_error = "requeued after inflight timeout";
+      touch_(id);
 
       owner_.erase(id);
       ++count;
@@ -318,4 +1294,171 @@ namespace vix::sync::outbox
     return count;
   }
 
+  std::vector<std::string> FileOutboxStore::coalesce(
+      const std::string &coalesce_key,
+      std::int64_t /*now_ms*/)
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_if_needed_();
+
+    std::vector<std::string> removed;
+
+    auto kit = by_coalesce_key_.find(coalesce_key);
+    if (kit == by_coalesce_key_.end() || kit->second.size() < 2)
+      return removed;
+
+    // Everything but the newest entry is superseded (in-flight ops excepted).
+    const auto &entries = kit->second;
+    for (auto e = entries.begin(); e != std::prev(entries.end()); ++e)
+    {
+      auto it = ops_.find(e->second);
+      if (it != ops_.end() && it->second.status != vix::sync::OperationStatus::InFlight)
+        removed.push_back(e->second);
+    }
+
+    for (const auto &id : removed)
+    {
+      auto it = ops_.find(id);
+      index_remove_(it->second); // may erase kit
+      idempotency_forget_(it->second);
+      payload_release_(id);
+      owner_.erase(id);
+      touch_(id);
+      ops_.erase(it);
+    }
+
+    if (!removed.empty())
+      flush_();
+    return removed;
+  }
+
+  std::size_t FileOutboxStore::expire_due(std::int64_t now_ms)
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_if_needed_();
+
+    std::vector<std::string> due;
+    for (auto it = deadlines_.begin(); it != deadlines_.end() && it->first <= now_ms; ++it)
+    {
+      auto op = ops_.find(it->second);
+      if (op != ops_.end() && op->second.status != vix::sync::OperationStatus::InFlight)
+        due.push_back(it->second);
+    }
+
+    for (const auto &id : due)
+    {
+      auto &op = ops_.at(id);
+      index_remove_(op);
+      op.status = vix::sync::OperationStatus::Expired;
+      op.updated_at_ms = now_ms;
+      op.last_error = "deadline exceeded";
+      idempotency_track_(op, false, now_ms);
+      touch_(id);
+      owner_.erase(id);
+    }
+
+    if (!due.empty())
+      flush_();
+    return due.size();
+  }
+
+  OutboxDepth FileOutboxStore::depth()
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_if_needed_();
+    return depth_;
+  }
+
+  std::size_t FileOutboxStore::shed(
+      std::size_t max_ops,
+      std::size_t max_bytes,
+      std::int32_t max_priority)
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_if_needed_();
+
+    auto over = [&]
+    {
+      return depth_.ops > max_ops || (max_bytes > 0 && depth_.bytes > max_bytes);
+    };
+
+    std::size_t dropped = 0;
+
+    // live_ is ordered by descending priority: walk it from the back.
+    for (auto cls = live_.rbegin(); cls != live_.rend() && over();)
+    {
+      if (cls->first > max_priority)
+        break;
+
+      // Collect victims first: removing from the index invalidates iterators.
+      std::vector<std::string> victims;
+      auto ops = depth_.ops;
+      auto bytes = depth_.bytes;
+      for (const auto &[created_at, id] : cls->second)
+      {
+        if (ops <= max_ops && (max_bytes == 0 || bytes <= max_bytes))
+          break;
+        const auto &op = ops_.at(id);
+        if (op.status == vix::sync::OperationStatus::InFlight)
+          continue;
+        victims.push_back(id);
+        ops -= 1;
+        bytes -= footprint_(op);
+      }
+
+      const auto priority = cls->first;
+      for (const auto &id : victims)
+      {
+        auto it = ops_.find(id);
+        index_remove_(it->second);
+        idempotency_forget_(it->second);
+        payload_release_(id);
+        owner_.erase(id);
+        touch_(id);
+        ops_.erase(it);
+        ++dropped;
+      }
+
+      // The class may have been erased; continue below this priority.
+      cls = std::make_reverse_iterator(live_.lower_bound(priority));
+    }
+
+    if (dropped > 0)
+      flush_();
+    return dropped;
+  }
+
+  std::optional<vix::sync::Operation> FileOutboxStore::remove(const std::string &id)
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_if_needed_();
+
+    auto it = ops_.find(id);
+    if (it == ops_.end())
+      return std::nullopt;
+
+    vix::sync::Operation op = with_payload_(it->second);
+    index_remove_(it->second);
+    if (is_live(op.status))
+      idempotency_forget_(op);
+    payload_release_(id);
+    touch_(id);
+    ops_.erase(it);
+    owner_.erase(id);
+
+    flush_();
+    return op;
+  }
+
+  std::map<std::int32_t, std::size_t> FileOutboxStore::depth_by_priority()
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    load_if_needed_();
+
+    std::map<std::int32_t, std::size_t> out;
+    for (const auto &[priority, fifo] : live_)
+      out[priority] = fifo.size();
+    return out;
+  }
+
 } // namespace vix::sync::outbox
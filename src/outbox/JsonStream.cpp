@@ -0,0 +1,560 @@
+/**
+ *
+ *  @file JsonStream.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include "JsonStream.hpp"
+
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define VIX_SYNC_JSON_SSE2 1
+#endif
+
+namespace vix::sync::outbox::detail
+{
+  namespace
+  {
+    constexpr std::uint64_t kOnes = 0x0101010101010101ull;
+    constexpr std::uint64_t kHighs = 0x8080808080808080ull;
+
+    // High bit set in each byte of x that is zero; exact up to the first
+    // such byte, which is all the scan needs.
+    inline std::uint64_t zero_bytes(std::uint64_t x) noexcept
+    {
+      return (x - kOnes) & ~x & kHighs;
+    }
+
+    // High bit set in each byte of x below n (n <= 128), same caveat.
+    inline std::uint64_t bytes_below(std::uint64_t x, std::uint8_t n) noexcept
+    {
+      return (x - kOnes * n) & ~x & kHighs;
+    }
+
+    inline bool plain(unsigned char c) noexcept
+    {
+      return c >= 0x20 && c != '"' && c != '\\';
+    }
+
+    inline int hex_digit(char c) noexcept
+    {
+      if (c >= '0' && c <= '9')
+        return c - '0';
+      if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+      if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+      return -1;
+    }
+
+    void append_utf8(std::string &out, std::uint32_t cp)
+    {
+      if (cp < 0x80)
+      {
+        out += static_cast<char>(cp);
+      }
+      else if (cp < 0x800)
+      {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+      }
+      else if (cp < 0x10000)
+      {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+      }
+      else
+      {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+      }
+    }
+  } // namespace
+
+  std::size_t json_plain_prefix(const char *p, std::size_t n) noexcept
+  {
+    std::size_t i = 0;
+
+#if defined(VIX_SYNC_JSON_SSE2)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= n; i += 16)
+    {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+      // Unsigned v <= 0x1F is min(v, 0x1F) == v.
+      const __m128i hit = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+          _mm_cmpeq_epi8(_mm_min_epu8(v, control), v));
+      const auto mask = static_cast<unsigned>(_mm_movemask_epi8(hit));
+      if (mask != 0)
+        return i + static_cast<std::size_t>(std::countr_zero(mask));
+    }
+#else
+    if constexpr (std::endian::native == std::endian::little)
+    {
+      for (; i + 8 <= n; i += 8)
+      {
+        std::uint64_t x;
+        std::memcpy(&x, p + i, sizeof(x));
+        const auto hit = zero_bytes(x ^ (kOnes * '"')) |
+                         zero_bytes(x ^ (kOnes * '\\')) |
+                         bytes_below(x, 0x20);
+        if (hit != 0)
+          return i + static_cast<std::size_t>(std::countr_zero(hit) / 8);
+      }
+    }
+#endif
+
+    while (i < n && plain(static_cast<unsigned char>(p[i])))
+      ++i;
+    return i;
+  }
+
+  void append_json_string(std::string &out, std::string_view s)
+  {
+    static constexpr char kHex[] = "0123456789abcdef";
+
+    out += '"';
+    for (;;)
+    {
+      const auto n = json_plain_prefix(s.data(), s.size());
+      out.append(s.data(), n);
+      if (n == s.size())
+        break;
+
+      const auto c = static_cast<unsigned char>(s[n]);
+      switch (c)
+      {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\b':
+        out += "\\b";
+        break;
+      case '\f':
+        out += "\\f";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        out += "\\u00";
+        out += kHex[c >> 4];
+        out += kHex[c & 0xF];
+        break;
+      }
+      s.remove_prefix(n + 1);
+    }
+    out += '"';
+  }
+
+  // JsonWriter
+
+  void JsonWriter::begin_object()
+  {
+    out_ += '{';
+    ++depth_;
+    first_ = true;
+  }
+
+  void JsonWriter::end_object()
+  {
+    --depth_;
+    if (!first_ && indent_ >= 0)
+      newline_();
+    out_ += '}';
+    first_ = false;
+  }
+
+  void JsonWriter::key(std::string_view k)
+  {
+    member_();
+    append_json_string(out_, k);
+    out_ += indent_ >= 0 ? ": " : ":";
+  }
+
+  void JsonWriter::int_value(std::int64_t v)
+  {
+    char buf[24];
+    const auto r = std::to_chars(buf, buf + sizeof(buf), v);
+    out_.append(buf, r.ptr);
+  }
+
+  void JsonWriter::uint_value(std::uint64_t v)
+  {
+    char buf[24];
+    const auto r = std::to_chars(buf, buf + sizeof(buf), v);
+    out_.append(buf, r.ptr);
+  }
+
+  void JsonWriter::raw_member(std::string_view member)
+  {
+    member_();
+    out_ += member;
+  }
+
+  void JsonWriter::member_()
+  {
+    if (!first_)
+      out_ += ',';
+    if (indent_ >= 0)
+      newline_();
+    first_ = false;
+  }
+
+  void JsonWriter::newline_()
+  {
+    out_ += '\n';
+    out_.append(static_cast<std::size_t>(depth_ * indent_), ' ');
+  }
+
+  // JsonReader
+
+  void JsonReader::fail_(const char *what) const
+  {
+    throw std::runtime_error(std::string("JSON: ") + what + " at offset " + std::to_string(pos_));
+  }
+
+  void JsonReader::skip_ws_() noexcept
+  {
+    while (pos_ < text_.size())
+    {
+      const char c = text_[pos_];
+      if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+        break;
+      ++pos_;
+    }
+  }
+
+  bool JsonReader::null_()
+  {
+    skip_ws_();
+    if (text_.compare(pos_, 4, "null") != 0)
+      return false;
+    pos_ += 4;
+    return true;
+  }
+
+  void JsonReader::begin_object()
+  {
+    skip_ws_();
+    if (pos_ >= text_.size() || text_[pos_] != '{')
+      fail_("expected '{'");
+    ++pos_;
+    after_open_ = true;
+  }
+
+  bool JsonReader::next_key(std::string_view &key)
+  {
+    skip_ws_();
+    if (pos_ >= text_.size())
+      fail_("unterminated object");
+
+    if (text_[pos_] == '}')
+    {
+      ++pos_;
+      after_open_ = false;
+      return false;
+    }
+
+    if (!after_open_)
+    {
+      if (text_[pos_] != ',')
+        fail_("expected ',' or '}'");
+      ++pos_;
+    }
+    after_open_ = false;
+
+    key = string_(key_scratch_);
+
+    skip_ws_();
+    if (pos_ >= text_.size() || text_[pos_] != ':')
+      fail_("expected ':'");
+    ++pos_;
+    return true;
+  }
+
+  std::string_view JsonReader::string_(std::string &scratch)
+  {
+    skip_ws_();
+    if (pos_ >= text_.size() || text_[pos_] != '"')
+      fail_("expected string");
+
+    const auto start = ++pos_;
+    for (;;)
+    {
+      pos_ += json_plain_prefix(text_.data() + pos_, text_.size() - pos_);
+      if (pos_ >= text_.size())
+        fail_("unterminated string");
+
+      const char c = text_[pos_];
+      if (c == '"')
+      {
+        ++pos_;
+        return text_.substr(start, pos_ - 1 - start);
+      }
+      if (c == '\\')
+      {
+        scratch.assign(text_.data() + start, pos_ - start);
+        unescape_(scratch);
+        return scratch;
+      }
+      ++pos_; // raw control character, kept as is
+    }
+  }
+
+  void JsonReader::unescape_(std::string &out)
+  {
+    auto hex4 = [this]
+    {
+      if (pos_ + 4 > text_.size())
+        fail_("truncated \\u escape");
+      std::uint32_t v = 0;
+      for (std::size_t k = 0; k < 4; ++k)
+      {
+        const int d = hex_digit(text_[pos_ + k]);
+        if (d < 0)
+          fail_("invalid \\u escape");
+        v = (v << 4) | static_cast<std::uint32_t>(d);
+      }
+      pos_ += 4;
+      return v;
+    };
+
+    for (;;)
+    {
+      if (pos_ >= text_.size())
+        fail_("unterminated string");
+
+      const char c = text_[pos_];
+      if (c == '"')
+      {
+        ++pos_;
+        return;
+      }
+      if (c != '\\')
+      {
+        auto n = json_plain_prefix(text_.data() + pos_, text_.size() - pos_);
+        if (n == 0)
+          n = 1; // raw control character
+        out.append(text_.data() + pos_, n);
+        pos_ += n;
+        continue;
+      }
+
+      if (++pos_ >= text_.size())
+        fail_("unterminated string");
+      const char e = text_[pos_++];
+      switch (e)
+      {
+      case '"':
+      case '\\':
+      case '/':
+        out += e;
+        break;
+      case 'b':
+        out += '\b';
+        break;
+      case 'f':
+        out += '\f';
+        break;
+      case 'n':
+        out += '\n';
+        break;
+      case 'r':
+        out += '\r';
+        break;
+      case 't':
+        out += '\t';
+        break;
+      case 'u':
+      {
+        auto cp = hex4();
+        if (cp >= 0xD800 && cp <= 0xDBFF)
+        {
+          if (text_.compare(pos_, 2, "\\u") != 0)
+            fail_("unpaired surrogate");
+          pos_ += 2;
+          const auto lo = hex4();
+          if (lo < 0xDC00 || lo > 0xDFFF)
+            fail_("unpaired surrogate");
+          cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+        }
+        else if (cp >= 0xDC00 && cp <= 0xDFFF)
+        {
+          fail_("unpaired surrogate");
+        }
+        append_utf8(out, cp);
+        break;
+      }
+      default:
+        fail_("invalid escape");
+      }
+    }
+  }
+
+  void JsonReader::string(std::string &out)
+  {
+    if (null_())
+    {
+      out.clear();
+      return;
+    }
+
+    const auto v = string_(out);
+    if (v.data() != out.data())
+      out.assign(v);
+  }
+
+  std::string_view JsonReader::number_()
+  {
+    skip_ws_();
+    const auto start = pos_;
+    while (pos_ < text_.size())
+    {
+      const char c = text_[pos_];
+      if ((c < '0' || c > '9') && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E')
+        break;
+      ++pos_;
+    }
+    if (pos_ == start)
+      fail_("expected number");
+    return text_.substr(start, pos_ - start);
+  }
+
+  std::int64_t JsonReader::int_value()
+  {
+    if (null_())
+      return 0;
+
+    const auto s = number_();
+    std::int64_t v = 0;
+    auto r = std::from_chars(s.data(), s.data() + s.size(), v);
+    if (r.ec == std::errc() && r.ptr == s.data() + s.size())
+      return v;
+
+    double d = 0;
+    r = std::from_chars(s.data(), s.data() + s.size(), d);
+    if (r.ec != std::errc() || r.ptr != s.data() + s.size())
+      fail_("invalid number");
+    return static_cast<std::int64_t>(d);
+  }
+
+  std::uint64_t JsonReader::uint_value()
+  {
+    skip_ws_();
+    if (pos_ < text_.size() && text_[pos_] == '-')
+      return static_cast<std::uint64_t>(int_value());
+    if (null_())
+      return 0;
+
+    const auto s = number_();
+    std::uint64_t v = 0;
+    auto r = std::from_chars(s.data(), s.data() + s.size(), v);
+    if (r.ec == std::errc() && r.ptr == s.data() + s.size())
+      return v;
+
+    double d = 0;
+    r = std::from_chars(s.data(), s.data() + s.size(), d);
+    if (r.ec != std::errc() || r.ptr != s.data() + s.size())
+      fail_("invalid number");
+    return static_cast<std::uint64_t>(d);
+  }
+
+  bool JsonReader::at_object()
+  {
+    skip_ws_();
+    return pos_ < text_.size() && text_[pos_] == '{';
+  }
+
+  void JsonReader::skip_value()
+  {
+    int depth = 0;
+    do
+    {
+      skip_ws_();
+      if (pos_ >= text_.size())
+        fail_("unexpected end of input");
+
+      const char c = text_[pos_];
+      switch (c)
+      {
+      case '"':
+        string_(key_scratch_);
+        break;
+      case '{':
+      case '[':
+        ++depth;
+        ++pos_;
+        break;
+      case '}':
+      case ']':
+        if (depth == 0)
+          fail_("expected value");
+        --depth;
+        ++pos_;
+        break;
+      case ',':
+      case ':':
+        if (depth == 0)
+          fail_("expected value");
+        ++pos_;
+        break;
+      case 't':
+      case 'f':
+      case 'n':
+        if (text_.compare(pos_, 4, "true") == 0 || text_.compare(pos_, 4, "null") == 0)
+          pos_ += 4;
+        else if (text_.compare(pos_, 5, "false") == 0)
+          pos_ += 5;
+        else
+          fail_("invalid literal");
+        break;
+      default:
+        number_();
+        break;
+      }
+    } while (depth > 0);
+  }
+
+  std::string_view JsonReader::raw_value()
+  {
+    skip_ws_();
+    const auto start = pos_;
+    skip_value();
+    return text_.substr(start, pos_ - start);
+  }
+
+  void JsonReader::finish()
+  {
+    skip_ws_();
+    if (pos_ != text_.size())
+      fail_("trailing characters");
+  }
+
+} // namespace vix::sync::outbox::detail
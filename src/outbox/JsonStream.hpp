@@ -0,0 +1,233 @@
+/**
+ *
+ *  @file JsonStream.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_JSON_STREAM_HPP
+#define VIX_SYNC_JSON_STREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace vix::sync::outbox::detail
+{
+  /**
+   * @brief Length of the prefix of bytes that a JSON string holds verbatim.
+   *
+   * Stops at the first '"', '\\' or control character (< 0x20). Scans 16
+   * bytes per step with SSE2, or 8 with word-at-a-time (SWAR) tests.
+   */
+  std::size_t json_plain_prefix(const char *p, std::size_t n) noexcept;
+
+  /**
+   * @brief Append s to out as a quoted, escaped JSON string.
+   *
+   * Escapes like nlohmann::json::dump(): \" \\ \b \f \n \r \t and \u00XX
+   * for other control characters. Other bytes, UTF-8 or not, are copied.
+   */
+  void append_json_string(std::string &out, std::string_view s);
+
+  /**
+   * @brief Streaming JSON writer appending to a string.
+   *
+   * Writes objects only as deep as the file formats need: objects, string
+   * and integer values. No DOM, no allocation besides the output buffer.
+   * With an indent, the layout matches nlohmann::json::dump(indent).
+   *
+   * @note Not thread-safe.
+   */
+  class JsonWriter
+  {
+  public:
+    /**
+     * @brief Write into out.
+     *
+     * @param out Buffer written to (appended).
+     * @param indent Spaces per level, or a negative value for compact output.
+     * @param depth Nesting level of the first value, for indented fragments.
+     */
+    explicit JsonWriter(std::string &out, int indent = -1, int depth = 0) noexcept
+        : out_(out), indent_(indent), depth_(depth)
+    {
+    }
+
+    /**
+     * @brief Open an object (as a value).
+     */
+    void begin_object();
+
+    /**
+     * @brief Close the innermost object.
+     */
+    void end_object();
+
+    /**
+     * @brief Start a member of the open object.
+     */
+    void key(std::string_view k);
+
+    /**
+     * @brief Write a string value.
+     */
+    void string(std::string_view s) { append_json_string(out_, s); }
+
+    /**
+     * @brief Write a signed integer value.
+     */
+    void int_value(std::int64_t v);
+
+    /**
+     * @brief Write an unsigned integer value.
+     */
+    void uint_value(std::uint64_t v);
+
+    /**
+     * @brief Write a member already encoded as "key": value.
+     *
+     * The member must have been encoded for this nesting level.
+     */
+    void raw_member(std::string_view member);
+
+  private:
+    /**
+     * @brief Separator and indentation before a member.
+     */
+    void member_();
+
+    /**
+     * @brief Line break and indentation of depth_ levels.
+     */
+    void newline_();
+
+  private:
+    std::string &out_;
+    int indent_;
+    int depth_;
+
+    /**
+     * @brief Whether the open object has no member yet.
+     */
+    bool first_{true};
+  };
+
+  /**
+   * @brief Pull (SAX-style) JSON reader over an in-memory document.
+   *
+   * Callers walk objects with begin_object() / next_key() and read each
+   * value with the accessor of its expected type, or skip_value(). Strings
+   * without escapes are copied in one go after a SIMD scan; keys are
+   * returned as views and never allocate.
+   *
+   * Reading is lenient where nlohmann::json::value() would be: null reads
+   * as an empty string or 0, and integers written as floating point are
+   * truncated.
+   *
+   * @throws std::runtime_error on malformed input, with its byte offset.
+   * @note Not thread-safe.
+   */
+  class JsonReader
+  {
+  public:
+    /**
+     * @brief Read text, which must outlive the reader.
+     */
+    explicit JsonReader(std::string_view text) noexcept : text_(text) {}
+
+    /**
+     * @brief Consume the '{' opening an object.
+     */
+    void begin_object();
+
+    /**
+     * @brief Move to the next member of the current object.
+     *
+     * @param key Set to the member key; valid until the next call.
+     * @return false once the closing '}' has been consumed.
+     */
+    bool next_key(std::string_view &key);
+
+    /**
+     * @brief Read a string value into out.
+     */
+    void string(std::string &out);
+
+    /**
+     * @brief Read a signed integer value.
+     */
+    std::int64_t int_value();
+
+    /**
+     * @brief Read an unsigned integer value.
+     */
+    std::uint64_t uint_value();
+
+    /**
+     * @brief Whether the next value is an object.
+     */
+    bool at_object();
+
+    /**
+     * @brief Skip the next value, whatever its type.
+     */
+    void skip_value();
+
+    /**
+     * @brief Skip the next value and return its text.
+     *
+     * Lets callers read sections of a document in their own order, each
+     * with a reader of its own.
+     */
+    std::string_view raw_value();
+
+    /**
+     * @brief Check that only whitespace remains.
+     */
+    void finish();
+
+  private:
+    [[noreturn]] void fail_(const char *what) const;
+    void skip_ws_() noexcept;
+    bool null_();
+
+    /**
+     * @brief Read a string; returns a view of text_ or of scratch.
+     */
+    std::string_view string_(std::string &scratch);
+
+    /**
+     * @brief Decode the escaped remainder of a string into out.
+     */
+    void unescape_(std::string &out);
+
+    /**
+     * @brief Span of the number at the current position.
+     */
+    std::string_view number_();
+
+  private:
+    std::string_view text_;
+    std::size_t pos_{0};
+
+    /**
+     * @brief Whether the last token was the '{' of the current object.
+     */
+    bool after_open_{false};
+
+    std::string key_scratch_;
+  };
+
+} // namespace vix::sync::outbox::detail
+
+#endif // VIX_SYNC_JSON_STREAM_HPP
@@ -0,0 +1,157 @@
+/**
+ *
+ *  @file OperationJson.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include "OperationJson.hpp"
+
+#include <string>
+
+namespace vix::sync::outbox::detail
+{
+  void write_op_fields(JsonWriter &w, const vix::sync::Operation &op, std::string_view payload)
+  {
+    w.key("id");
+    w.string(op.id);
+    w.key("kind");
+    w.string(op.kind);
+    w.key("target");
+    w.string(op.target);
+    w.key("payload");
+    w.string(payload);
+    w.key("idempotency_key");
+    w.string(op.idempotency_key);
+    w.key("created_at_ms");
+    w.int_value(op.created_at_ms);
+    w.key("updated_at_ms");
+    w.int_value(op.updated_at_ms);
+    w.key("attempt");
+    w.uint_value(op.attempt);
+    w.key("next_retry_at_ms");
+    w.int_value(op.next_retry_at_ms);
+    w.key("status");
+    w.int_value(static_cast<int>(op.status));
+    w.key("last_error");
+    w.string(op.last_error);
+    w.key("priority");
+    w.int_value(op.priority);
+    w.key("coalesce_key");
+    w.string(op.coalesce_key);
+    w.key("deadline_at_ms");
+    w.int_value(op.deadline_at_ms);
+  }
+
+  bool read_op_field(JsonReader &r, std::string_view key, vix::sync::Operation &op)
+  {
+    // Dispatch on length first: most keys have a unique one.
+    switch (key.size())
+    {
+    case 2:
+      if (key == "id")
+      {
+        r.string(op.id);
+        return true;
+      }
+      break;
+    case 4:
+      if (key == "kind")
+      {
+        r.string(op.kind);
+        return true;
+      }
+      break;
+    case 6:
+      if (key == "target")
+      {
+        r.string(op.target);
+        return true;
+      }
+      if (key == "status")
+      {
+        op.status = static_cast<vix::sync::OperationStatus>(r.int_value());
+        return true;
+      }
+      break;
+    case 7:
+      if (key == "payload")
+      {
+        std::string bytes;
+        r.string(bytes);
+        op.payload = std::move(bytes);
+        return true;
+      }
+      if (key == "attempt")
+      {
+        op.attempt = static_cast<std::uint32_t>(r.uint_value());
+        return true;
+      }
+      break;
+    case 8:
+      if (key == "priority")
+      {
+        op.priority = static_cast<std::int32_t>(r.int_value());
+        return true;
+      }
+      break;
+    case 10:
+      if (key == "last_error")
+      {
+        r.string(op.last_error);
+        return true;
+      }
+      break;
+    case 12:
+      if (key == "coalesce_key")
+      {
+        r.string(op.coalesce_key);
+        return true;
+      }
+      break;
+    case 13:
+      if (key == "created_at_ms")
+      {
+        op.created_at_ms = r.int_value();
+        return true;
+      }
+      if (key == "updated_at_ms")
+      {
+        op.updated_at_ms = r.int_value();
+        return true;
+      }
+      break;
+    case 14:
+      if (key == "deadline_at_ms")
+      {
+        op.deadline_at_ms = r.int_value();
+        return true;
+      }
+      break;
+    case 15:
+      if (key == "idempotency_key")
+      {
+        r.string(op.idempotency_key);
+        return true;
+      }
+      break;
+    case 16:
+      if (key == "next_retry_at_ms")
+      {
+        op.next_retry_at_ms = r.int_value();
+        return true;
+      }
+      break;
+    default:
+      break;
+    }
+    return false;
+  }
+
+} // namespace vix::sync::outbox::detail
@@ -0,0 +1,86 @@
+/**
+ *
+ *  @file OperationJson.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_SYNC_OPERATION_JSON_HPP
+#define VIX_SYNC_OPERATION_JSON_HPP
+
+#include <string_view>
+
+#include <vix/sync/Operation.hpp>
+
+#include "JsonStream.hpp"
+
+namespace vix::sync::outbox::detail
+{
+  /**
+   * @brief Write the fields of op into the object open in w.
+   *
+   * File format version 1, in a fixed key order. Shared by the file-backed
+   * stores so that outbox and dead-letter files use the same layout.
+   *
+   * @param payload Bytes written as "payload" (op.payload, or its stored
+   * form when the store encodes it).
+   */
+  void write_op_fields(JsonWriter &w, const vix::sync::Operation &op, std::string_view payload);
+
+  /**
+   * @brief Write op as a JSON object.
+   */
+  inline void write_op(JsonWriter &w, const vix::sync::Operation &op)
+  {
+    w.begin_object();
+    write_op_fields(w, op, op.payload.view());
+    w.end_object();
+  }
+
+  /**
+   * @brief Read the value of member key into op if it is an Operation field.
+   *
+   * @return false, with nothing consumed, for any other key.
+   */
+  bool read_op_field(JsonReader &r, std::string_view key, vix::sync::Operation &op);
+
+  /**
+   * @brief Read an operation object.
+   *
+   * Keys may come in any order; missing fields keep their default value,
+   * so files written by older versions remain readable. Members that are
+   * not Operation fields go to extra(key), which reads the value and
+   * returns true, or returns false to have it skipped.
+   */
+  template <class Extra>
+  vix::sync::Operation read_op(JsonReader &r, Extra &&extra)
+  {
+    vix::sync::Operation op;
+    std::string_view key;
+    r.begin_object();
+    while (r.next_key(key))
+    {
+      if (!read_op_field(r, key, op) && !extra(key))
+        r.skip_value();
+    }
+    return op;
+  }
+
+  /**
+   * @brief Read an operation object, skipping unknown members.
+   */
+  inline vix::sync::Operation read_op(JsonReader &r)
+  {
+    return read_op(r, [](std::string_view)
+                   { return false; });
+  }
+
+} // namespace vix::sync::outbox::detail
+
+#endif // VIX_SYNC_OPERATION_JSON_HPP
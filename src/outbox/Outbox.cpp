@@ -13,25 +13,67 @@
  */
 #include <vix/sync/outbox/Outbox.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <unordered_set>
 #include <utility>
 
+#include <vix/sync/OperationId.hpp>
+
+#include "../Probes.hpp"
+
 namespace vix::sync::outbox
 {
 
+  // Same accounting as the stores' OutboxDepth::bytes.
+  static std::size_t footprint(const vix::sync::Operation &op) noexcept
+  {
+    return op.payload.size() + op.id.size() + op.kind.size() + op.target.size() +
+           op.idempotency_key.size() + op.coalesce_key.size();
+  }
+
   Outbox::Outbox(Config cfg, std::shared_ptr<OutboxStore> store)
       : cfg_(std::move(cfg)), store_(std::move(store))
   {
+    if (!cfg_.clock)
+      cfg_.clock = vix::sync::default_clock();
   }
 
   std::string Outbox::enqueue(vix::sync::Operation op, std::int64_t now_ms)
   {
+    return enqueue_(std::move(op), now_ms, cfg_.dedupe_idempotency_keys);
+  }
+
+  std::string Outbox::enqueue_(vix::sync::Operation op, std::int64_t now_ms, bool dedupe)
+  {
+    const auto &m = cfg_.metrics;
+    vix::sync::ScopedTimer timer(m ? &m->enqueue_latency : nullptr);
+
+    VIX_SYNC_PROBE3(enqueue__start, op.kind.c_str(), op.target.c_str(), op.payload.size());
+
     if (cfg_.auto_generate_ids && op.id.empty())
     {
       op.id = make_id();
     }
     if (cfg_.auto_generate_idempotency_key && op.idempotency_key.empty())
     {
+      // A fresh key cannot collide: skip the lookup.
       op.idempotency_key = make_idempotency_key();
+      dedupe = false;
+    }
+    dedupe = dedupe && !op.idempotency_key.empty();
+
+    // Duplicates are answered before backpressure: they take no room.
+    if (dedupe)
+    {
+      if (auto existing = store_->find_by_idempotency_key(op.idempotency_key, now_ms))
+      {
+        if (m)
+          m->enqueue_duplicates.add();
+        VIX_SYNC_PROBE1(enqueue__duplicate, existing->c_str());
+        return *existing;
+      }
     }
 
     if (op.created_at_ms == 0)
@@ -40,37 +82,126 @@ namespace vix::sync::outbox
 
     if (op.next_retry_at_ms == 0)
       op.next_retry_at_ms = now_ms;
+    if (op.deadline_at_ms == 0 && cfg_.default_ttl_ms > 0)
+      op.deadline_at_ms = now_ms + cfg_.default_ttl_ms;
     if (op.status == vix::sync::OperationStatus::Pending)
     {
       // ok
     }
 
-    store_->put(op);
+    if (cfg_.coalesce != CoalesceMode::Disabled &&
+        op.coalesce_key.empty() &&
+        cfg_.coalesce_by_kind_target)
+    {
+      op.coalesce_key = op.kind + '\n' + op.target;
+    }
+
+    std::unique_lock<std::mutex> lk(bp_mu_, std::defer_lock);
+    if (bounded_())
+    {
+      lk.lock();
+      reserve_room_(op, lk);
+    }
+
+    if (dedupe)
+    {
+      auto id = store_->put_idempotent(op, now_ms);
+      if (id != op.id)
+      {
+        // lost a race against an identical enqueue
+        if (m)
+          m->enqueue_duplicates.add();
+        VIX_SYNC_PROBE1(enqueue__duplicate, id.c_str());
+        return id;
+      }
+    }
+    else
+    {
+      store_->put(op);
+    }
+
+    if (lk.owns_lock())
+      lk.unlock();
+
+    if (m)
+      m->enqueued.add();
+    if (cfg_.tracer)
+      cfg_.tracer->record(op.id, vix::sync::TraceEvent::Enqueue);
+    VIX_SYNC_PROBE2(enqueue__done, op.id.c_str(), op.payload.size());
+
+    if (cfg_.coalesce == CoalesceMode::OnEnqueue && !op.coalesce_key.empty())
+      store_->coalesce(op.coalesce_key, now_ms);
+
     return op.id;
   }
 
-  std::vector<vix::sync::Operation> Outbox::peek_ready(std::int64_t now_ms, std::size_t limit)
+  std::vector<vix::sync::Operation> Outbox::peek_ready(
+      std::int64_t now_ms,
+      std::size_t limit,
+      std::function<bool(const vix::sync::Operation &)> skip)
   {
     ListOptions opt;
     opt.limit = limit;
     opt.now_ms = now_ms;
     opt.only_ready = true;
     opt.include_inflight = false;
-    return store_->list(opt);
+    opt.priority_aging_ms = cfg_.priority_aging_ms;
+    opt.skip = std::move(skip);
+
+    auto ops = store_->list(opt);
+    if (cfg_.coalesce != CoalesceMode::OnClaim)
+      return ops;
+
+    std::unordered_set<std::string> keys;
+    std::unordered_set<std::string> dropped;
+    for (const auto &op : ops)
+    {
+      if (op.coalesce_key.empty() || !keys.insert(op.coalesce_key).second)
+        continue;
+      for (auto &id : store_->coalesce(op.coalesce_key, now_ms))
+        dropped.insert(std::move(id));
+    }
+
+    if (!dropped.empty())
+    {
+      std::erase_if(ops, [&](const vix::sync::Operation &op)
+                    { return dropped.count(op.id) != 0; });
+    }
+    return ops;
   }
 
   bool Outbox::claim(const std::string &id, std::int64_t now_ms)
   {
-    return store_->claim(id, cfg_.owner, now_ms);
+    const auto &m = cfg_.metrics;
+    vix::sync::ScopedTimer timer(m ? &m->claim_latency : nullptr);
+
+    const bool ok = store_->claim(id, cfg_.owner, now_ms);
+    if (m)
+      (ok ? m->claimed : m->claims_lost).add();
+    if (ok && cfg_.tracer)
+      cfg_.tracer->record(id, vix::sync::TraceEvent::Claim);
+    return ok;
   }
 
   bool Outbox::complete(const std::string &id, std::int64_t now_ms)
   {
-    return store_->mark_done(id, now_ms);
+    const auto &m = cfg_.metrics;
+    vix::sync::ScopedTimer timer(m ? &m->complete_latency : nullptr);
+
+    const bool ok = store_->mark_done(id, now_ms);
+    if (ok && m)
+      m->completed.add();
+    if (ok && cfg_.tracer)
+      cfg_.tracer->record(id, vix::sync::TraceEvent::Complete);
+    notify_drained_();
+    return ok;
   }
 
   bool Outbox::fail(const std::string &id, const std::string &error, std::int64_t now_ms, bool retryable)
   {
+    const auto &m = cfg_.metrics;
+    vix::sync::ScopedTimer timer(m ? &m->fail_latency : nullptr);
+
     auto cur = store_->get(id);
     if (!cur)
       return false;
@@ -79,9 +210,26 @@ namespace vix::sync::outbox
     op.attempt += 1;
     op.updated_at_ms = now_ms;
 
+    if (m)
+      (retryable ? m->failed : m->failed_permanent).add();
+    if (cfg_.tracer)
+      cfg_.tracer->record(id, retryable ? vix::sync::TraceEvent::Fail : vix::sync::TraceEvent::PermanentFail);
+
     if (!retryable)
     {
-      return store_->mark_permanent_failed(id, error, now_ms);
+      const bool ok = store_->mark_permanent_failed(id, error, now_ms);
+      if (ok && cfg_.dead_letter)
+      {
+        // Written to the dead-letter store before leaving the outbox, so a
+        // crash in between leaves a PermanentFailed copy rather than nothing.
+        if (auto dead = store_->get(id))
+        {
+          cfg_.dead_letter->put(*dead);
+          store_->remove(id);
+        }
+      }
+      notify_drained_();
+      return ok;
     }
 
     if (!cfg_.retry.can_retry(op.attempt))
@@ -94,7 +242,144 @@ namespace vix::sync::outbox
     return store_->mark_failed(id, error, now_ms, next_at);
   }
 
-  std::string Outbox::make_id() { return "op_" + std::to_string(std::rand()); }
-  std::string Outbox::make_idempotency_key() { return "idem_" + std::to_string(std::rand()); }
+  std::size_t Outbox::expire(std::int64_t now_ms)
+  {
+    const auto n = store_->expire_due(now_ms);
+    if (n > 0)
+    {
+      if (cfg_.metrics)
+        cfg_.metrics->expired.add(n);
+      notify_drained_();
+    }
+    return n;
+  }
+
+  bool Outbox::redrive(const std::string &id, std::int64_t now_ms)
+  {
+    if (!cfg_.dead_letter)
+      return false;
+
+    auto dead = cfg_.dead_letter->get(id);
+    if (!dead)
+      return false;
+
+    auto op = std::move(*dead);
+    op.status = vix::sync::OperationStatus::Pending;
+    op.attempt = 0;
+    op.last_error.clear();
+    op.next_retry_at_ms = now_ms;
+    if (op.deadline_at_ms > 0 && op.deadline_at_ms <= now_ms)
+      op.deadline_at_ms = 0;
+
+    enqueue_(std::move(op), now_ms, /*dedupe*/ false);
+    cfg_.dead_letter->remove(id);
+    return true;
+  }
+
+  std::size_t Outbox::redrive_all(const DeadLetterQuery &q, std::int64_t now_ms)
+  {
+    if (!cfg_.dead_letter)
+      return 0;
+
+    DeadLetterQuery page = q;
+    page.offset = 0;
+
+    std::size_t n = 0;
+    for (const auto &op : cfg_.dead_letter->list(page))
+    {
+      if (redrive(op.id, now_ms))
+        ++n;
+    }
+    return n;
+  }
+
+  bool Outbox::bounded_() const noexcept
+  {
+    const auto &bp = cfg_.backpressure;
+    return bp.high_water_ops > 0 || bp.high_water_bytes > 0;
+  }
+
+  bool Outbox::is_full_locked_(std::size_t incoming_bytes)
+  {
+    const auto &bp = cfg_.backpressure;
+    const auto d = store_->depth();
+
+    if (full_)
+    {
+      const auto low_ops = bp.low_water_ops > 0 ? bp.low_water_ops : bp.high_water_ops;
+      const auto low_bytes = bp.low_water_bytes > 0 ? bp.low_water_bytes : bp.high_water_bytes;
+
+      const bool drained = (bp.high_water_ops == 0 || d.ops <= low_ops) &&
+                           (bp.high_water_bytes == 0 || d.bytes <= low_bytes);
+      if (!drained)
+        return true;
+      full_ = false;
+    }
+
+    const bool over = (bp.high_water_ops > 0 && d.ops + 1 > bp.high_water_ops) ||
+                      (bp.high_water_bytes > 0 && d.bytes + incoming_bytes > bp.high_water_bytes);
+    if (over)
+      full_ = true;
+    return over;
+  }
+
+  void Outbox::reserve_room_(const vix::sync::Operation &op, std::unique_lock<std::mutex> &lk)
+  {
+    const auto &bp = cfg_.backpressure;
+    const auto bytes = footprint(op);
+
+    if (!is_full_locked_(bytes))
+      return;
+
+    switch (bp.policy)
+    {
+    case OverflowPolicy::Reject:
+      throw OutboxFullError("Outbox: full");
+
+    case OverflowPolicy::DropOldest:
+    {
+      if (bp.high_water_bytes > 0 && bytes >= bp.high_water_bytes)
+        throw OutboxFullError("Outbox: operation larger than high_water_bytes");
+
+      const auto max_ops = bp.high_water_ops > 0
+                               ? bp.high_water_ops - 1
+                               : std::numeric_limits<std::size_t>::max();
+      const auto max_bytes = bp.high_water_bytes > 0 ? bp.high_water_bytes - bytes : 0;
+
+      store_->shed(max_ops, max_bytes, op.priority);
+
+      full_ = false;
+      if (is_full_locked_(bytes))
+        throw OutboxFullError("Outbox: full (nothing droppable)");
+      return;
+    }
+
+    case OverflowPolicy::Block:
+    {
+      using clock = std::chrono::steady_clock;
+      const auto deadline = clock::now() + std::chrono::milliseconds(bp.block_timeout_ms);
+
+      // Bounded waits: the outbox may also drain through the store directly
+      // (prune, sweeps), which does not notify.
+      while (is_full_locked_(bytes))
+      {
+        const auto now = clock::now();
+        if (now >= deadline)
+          throw OutboxFullError("Outbox: full (timed out)");
+        bp_cv_.wait_until(lk, std::min(deadline, now + std::chrono::milliseconds(50)));
+      }
+      return;
+    }
+    }
+  }
+
+  void Outbox::notify_drained_()
+  {
+    if (bounded_())
+      bp_cv_.notify_all();
+  }
+
+  std::string Outbox::make_id() { return "op_" + vix::sync::OperationId::generate().to_string(); }
+  std::string Outbox::make_idempotency_key() { return "idem_" + vix::sync::OperationId::generate().to_string(); }
 
 } // namespace vix::sync::outbox
@@ -22,7 +22,7 @@ namespace vix::sync::wal
 
   std::int64_t Wal::append(const WalRecord &rec)
   {
-    WalWriter w({cfg_.file_path, cfg_.fsync_on_write});
+    WalWriter w({cfg_.file_path, cfg_.fsync_on_write, cfg_.compression});
     return w.append(rec);
   }
 
@@ -13,14 +13,21 @@
  */
 #include <vix/sync/wal/WalReader.hpp>
 
+#include <vix/sync/Codec.hpp>
+
+#include <cstring>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
+#include "../Probes.hpp"
+
 namespace vix::sync::wal
 {
 
   static constexpr std::uint32_t kMagic = 0x56495857; // 'VIXW'
   static constexpr std::uint16_t kVersion = 1;
+  static constexpr std::uint8_t kCodecMask = 0x0f;
 
   WalReader::WalReader(std::filesystem::path p) : file_path_(std::move(p)) { open_(); }
 
@@ -49,10 +56,12 @@ namespace vix::sync::wal
     if (in_.eof())
       return std::nullopt;
 
+    VIX_SYNC_PROBE1(wal__next__start, start);
+
     std::uint32_t magic{};
     std::uint16_t version{};
     std::uint8_t type{};
-    std::uint8_t reserved{};
+    std::uint8_t flags{};
     std::int64_t ts_ms{};
     std::uint32_t id_len{}, payload_len{}, error_len{};
     std::int64_t next_retry_at_ms{};
@@ -63,7 +72,7 @@ namespace vix::sync::wal
 
     in_.read(reinterpret_cast<char *>(&version), sizeof(version));
     in_.read(reinterpret_cast<char *>(&type), sizeof(type));
-    in_.read(reinterpret_cast<char *>(&reserved), sizeof(reserved));
+    in_.read(reinterpret_cast<char *>(&flags), sizeof(flags));
     in_.read(reinterpret_cast<char *>(&ts_ms), sizeof(ts_ms));
     in_.read(reinterpret_cast<char *>(&id_len), sizeof(id_len));
     in_.read(reinterpret_cast<char *>(&payload_len), sizeof(payload_len));
@@ -103,7 +112,28 @@ namespace vix::sync::wal
     if (!in_)
       return std::nullopt;
 
+    const auto codec_id = static_cast<vix::sync::CodecId>(flags & kCodecMask);
+    if (codec_id != vix::sync::CodecId::None)
+    {
+      auto codec = vix::sync::find_codec(codec_id);
+      if (!codec)
+        throw std::runtime_error("WalReader: record compressed with an unavailable codec");
+
+      std::uint32_t raw_len{};
+      if (r.payload.size() < sizeof(raw_len))
+        throw std::runtime_error("WalReader: truncated compressed payload");
+      std::memcpy(&raw_len, r.payload.data(), sizeof(raw_len));
+
+      const std::string_view packed(
+          reinterpret_cast<const char *>(r.payload.data()) + sizeof(raw_len),
+          r.payload.size() - sizeof(raw_len));
+      const auto raw = codec->decompress(packed, raw_len);
+      r.payload.assign(raw.begin(), raw.end());
+    }
+
     offset_ = start;
+
+    VIX_SYNC_PROBE3(wal__next__done, r.id.c_str(), static_cast<int>(r.type), r.payload.size());
     return r;
   }
 
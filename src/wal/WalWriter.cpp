@@ -14,15 +14,37 @@
 #include <vix/sync/wal/WalWriter.hpp>
 
 #include <stdexcept>
+#include <string_view>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "../Probes.hpp"
 
 namespace vix::sync::wal
 {
 
   static constexpr std::uint32_t kMagic = 0x56495857; // 'VIXW'
   static constexpr std::uint16_t kVersion = 1;
+  static constexpr std::uint8_t kCodecMask = 0x0f;
 
   WalWriter::WalWriter(Config cfg) : cfg_(std::move(cfg)) { open_(); }
-  WalWriter::~WalWriter() { flush(); }
+  WalWriter::~WalWriter()
+  {
+    try
+    {
+      flush();
+    }
+    catch (...)
+    {
+    }
+#if !defined(_WIN32)
+    if (sync_fd_ >= 0)
+      ::close(sync_fd_);
+#endif
+  }
 
   void WalWriter::open_()
   {
@@ -30,6 +52,16 @@ namespace vix::sync::wal
     out_.open(cfg_.file_path, std::ios::binary | std::ios::app);
     if (!out_)
       throw std::runtime_error("WalWriter: cannot open file");
+
+#if !defined(_WIN32)
+    // fsync() applies to the file, whichever descriptor it is called on.
+    if (cfg_.fsync_on_write && sync_fd_ < 0)
+    {
+      sync_fd_ = ::open(cfg_.file_path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (sync_fd_ < 0)
+        throw std::runtime_error("WalWriter: cannot open file for fsync");
+    }
+#endif
   }
 
   std::int64_t WalWriter::tell_()
@@ -44,8 +76,16 @@ namespace vix::sync::wal
 
     const auto offset = tell_();
 
+    VIX_SYNC_PROBE3(wal__append__start, r.id.c_str(), static_cast<int>(r.type), r.payload.size());
+
+    const std::string_view raw(reinterpret_cast<const char *>(r.payload.data()), r.payload.size());
+    const auto packed = vix::sync::compress_payload(cfg_.compression, raw);
+
+    const std::uint32_t raw_len = static_cast<std::uint32_t>(raw.size());
     const std::uint32_t id_len = static_cast<std::uint32_t>(r.id.size());
-    const std::uint32_t payload_len = static_cast<std::uint32_t>(r.payload.size());
+    const std::uint32_t payload_len = packed
+                                          ? static_cast<std::uint32_t>(sizeof(raw_len) + packed->size())
+                                          : raw_len;
     const std::uint32_t error_len = static_cast<std::uint32_t>(r.error.size());
 
     // header
@@ -55,8 +95,10 @@ namespace vix::sync::wal
     const std::uint8_t type = static_cast<std::uint8_t>(r.type);
     out_.write(reinterpret_cast<const char *>(&type), sizeof(type));
 
-    const std::uint8_t reserved = 0;
-    out_.write(reinterpret_cast<const char *>(&reserved), sizeof(reserved));
+    const std::uint8_t flags = packed
+                                   ? static_cast<std::uint8_t>(static_cast<std::uint8_t>(cfg_.compression.codec) & kCodecMask)
+                                   : 0;
+    out_.write(reinterpret_cast<const char *>(&flags), sizeof(flags));
 
     out_.write(reinterpret_cast<const char *>(&r.ts_ms), sizeof(r.ts_ms));
     out_.write(reinterpret_cast<const char *>(&id_len), sizeof(id_len));
@@ -67,12 +109,21 @@ namespace vix::sync::wal
     // body
     if (id_len)
       out_.write(r.id.data(), id_len);
-    if (payload_len)
-      out_.write(reinterpret_cast<const char *>(r.payload.data()), payload_len);
+    if (packed)
+    {
+      out_.write(reinterpret_cast<const char *>(&raw_len), sizeof(raw_len));
+      out_.write(packed->data(), static_cast<std::streamsize>(packed->size()));
+    }
+    else if (payload_len)
+    {
+      out_.write(raw.data(), payload_len);
+    }
     if (error_len)
       out_.write(r.error.data(), error_len);
 
     flush();
+
+    VIX_SYNC_PROBE3(wal__append__done, r.id.c_str(), offset, tell_() - offset);
     return offset;
   }
 
@@ -81,6 +132,11 @@ namespace vix::sync::wal
     if (!out_)
       return;
     out_.flush();
+
+#if !defined(_WIN32)
+    if (sync_fd_ >= 0 && ::fsync(sync_fd_) != 0)
+      throw std::runtime_error("WalWriter: fsync failed");
+#endif
   }
 
 } // namespace vix::sync::wal
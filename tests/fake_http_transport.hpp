@@ -16,6 +16,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <vix/sync/engine/SyncWorker.hpp>
 
@@ -48,9 +49,12 @@ namespace vix::sync::engine
       by_target_[std::move(target)] = std::move(r);
     }
 
-    // Count calls for assertions
+    // Count calls for assertions (one per operation, batched or not)
     std::size_t callCount() const noexcept { return calls_; }
 
+    // Sizes of the batches received through send_batch()
+    const std::vector<std::size_t> &batchSizes() const noexcept { return batches_; }
+
     SendResult send(const vix::sync::Operation &op) override
     {
       ++calls_;
@@ -66,6 +70,12 @@ namespace vix::sync::engine
       return toResult(def_);
     }
 
+    std::vector<SendResult> send_batch(std::span<const vix::sync::Operation> ops) override
+    {
+      batches_.push_back(ops.size());
+      return ISyncTransport::send_batch(ops);
+    }
+
   private:
     static SendResult toResult(const Rule &r)
     {
@@ -81,6 +91,7 @@ namespace vix::sync::engine
     std::unordered_map<std::string, Rule> by_kind_;
     std::unordered_map<std::string, Rule> by_target_;
     std::size_t calls_{0};
+    std::vector<std::size_t> batches_;
   };
 
 } // namespace vix::sync::engine
@@ -0,0 +1,105 @@
+/**
+ *
+ *  @file sync_clock_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include <vix/sync/Clock.hpp>
+#include <vix/sync/engine/SyncEngine.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+
+#include "fake_http_transport.hpp"
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+  using namespace vix::sync::engine;
+
+  // 1) Monotonic clock never goes backwards
+  MonotonicClock mono;
+  auto prev = mono.now_ms();
+  for (int i = 0; i < 1'000; ++i)
+  {
+    const auto t = mono.now_ms();
+    assert(t >= prev);
+    prev = t;
+  }
+
+  // 2) Wall clock is Unix time, advancing with the monotonic clock
+  const auto sys_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+  WallClock wall;
+  const auto w0 = wall.now_ms();
+  assert(w0 >= sys_ms - 1'000 && w0 <= sys_ms + 1'000);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  const auto w1 = wall.now_ms();
+  assert(w1 >= w0 + 20 && w1 <= w0 + 1'000);
+
+  assert(default_clock() == default_clock());
+
+  // 3) Virtual clock only moves when told to
+  VirtualClock vc(5'000);
+  assert(vc.now_ms() == 5'000);
+  assert(vc.advance_ms(250) == 5'250);
+  vc.set_ms(10'000);
+  assert(vc.now_ms() == 10'000);
+
+  // 4) Outbox and engine share a virtual clock
+  auto clock = std::make_shared<VirtualClock>(1'000);
+
+  FileOutboxStore::Config scfg;
+  scfg.file_path.clear();
+  auto store = std::make_shared<FileOutboxStore>(scfg);
+
+  Outbox::Config ocfg;
+  ocfg.owner = "test";
+  ocfg.clock = clock;
+  auto outbox = std::make_shared<Outbox>(ocfg, store);
+  assert(outbox->clock() == clock);
+
+  auto transport = std::make_shared<FakeHttpTransport>();
+  transport->setDefault({.ok = false, .retryable = true});
+
+  SyncEngine engine(SyncEngine::Config{}, outbox, nullptr, transport);
+  assert(engine.clock() == clock);
+
+  Operation op;
+  op.kind = "http.post";
+  op.target = "/api/messages";
+  op.payload = "{}";
+  const auto id = outbox->enqueue(op);
+  assert(store->get(id)->created_at_ms == 1'000);
+
+  // First attempt fails and is scheduled after the base retry delay
+  assert(engine.tick() == 1);
+  const auto retry_at = store->get(id)->next_retry_at_ms;
+  assert(retry_at > 1'000);
+
+  clock->set_ms(retry_at - 1);
+  assert(engine.tick() == 0);
+
+  transport->setDefault({.ok = true});
+  clock->set_ms(retry_at);
+  assert(engine.tick() == 1);
+  assert(store->get(id)->status == OperationStatus::Done);
+
+  std::cout << "OK: clocks are monotonic, wall-anchored and virtual\n";
+  return 0;
+}
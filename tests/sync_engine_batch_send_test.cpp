@@ -0,0 +1,115 @@
+/**
+ *
+ *  @file sync_engine_batch_send_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <numeric>
+
+#include <vix/net/NetworkProbe.hpp>
+#include <vix/sync/Clock.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/engine/SyncEngine.hpp>
+
+#include "fake_http_transport.hpp"
+
+static void reset_test_dir(const std::filesystem::path &dir)
+{
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  std::filesystem::create_directories(dir, ec);
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+  using namespace vix::sync::engine;
+
+  const auto clock = default_clock();
+
+  const std::filesystem::path test_dir = "./.vix_test_batch";
+  reset_test_dir(test_dir);
+
+  // 1) Store
+  auto store = std::make_shared<FileOutboxStore>(FileOutboxStore::Config{
+      .file_path = test_dir / "outbox.json",
+      .pretty_json = false,
+      .fsync_on_write = false});
+
+  auto outbox = std::make_shared<Outbox>(
+      Outbox::Config{
+          .owner = "test-engine",
+      },
+      store);
+
+  // 2) Probe: always online
+  auto probe = std::make_shared<vix::net::NetworkProbe>(
+      vix::net::NetworkProbe::Config{},
+      []
+      { return true; });
+
+  // 3) Transport: success
+  auto transport = std::make_shared<FakeHttpTransport>();
+  transport->setDefault({.ok = true});
+
+  // 4) Engine: batches of at most 4 ops
+  SyncEngine::Config ecfg;
+  ecfg.worker_count = 1;
+  ecfg.batch_limit = 50;
+  ecfg.send_batch_max_ops = 4;
+
+  SyncEngine engine(ecfg, outbox, probe, transport);
+
+  // 5) Enqueue 10 ops for one target and 3 for another
+  const auto t0 = clock->now_ms();
+  for (int i = 0; i < 10; ++i)
+  {
+    Operation op;
+    op.kind = "http.post";
+    op.target = "/api/messages";
+    op.payload = R"({"n":)" + std::to_string(i) + "}";
+    outbox->enqueue(op, t0);
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    Operation op;
+    op.kind = "http.post";
+    op.target = "/api/events";
+    op.payload = "{}";
+    outbox->enqueue(op, t0);
+  }
+
+  // 6) Tick => 13 ops sent in 4 + 4 + 2 + 3 batches, never mixing targets
+  const auto processed = engine.tick(t0 + 1);
+  assert(processed == 13);
+  assert(transport->callCount() == 13);
+
+  const auto &sizes = transport->batchSizes();
+  assert(sizes.size() == 4);
+  assert(std::accumulate(sizes.begin(), sizes.end(), std::size_t{0}) == 13);
+  assert(*std::max_element(sizes.begin(), sizes.end()) <= 4);
+
+  ListOptions opt;
+  opt.limit = 100;
+  opt.now_ms = t0 + 1;
+  opt.only_ready = false;
+  opt.include_inflight = true;
+  assert(store->list(opt).empty());
+
+  std::cout << "OK: ready ops are batched by kind/target within limits\n";
+  return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ *
+ *  @file sync_engine_circuit_breaker_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
+#include <vix/net/NetworkProbe.hpp>
+#include <vix/sync/Clock.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/engine/SyncEngine.hpp>
+
+#include "fake_http_transport.hpp"
+
+static void reset_test_dir(const std::filesystem::path &dir)
+{
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  std::filesystem::create_directories(dir, ec);
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+  using namespace vix::sync::engine;
+
+  const auto clock = default_clock();
+
+  const std::filesystem::path test_dir = "./.vix_test_breaker";
+  reset_test_dir(test_dir);
+
+  // 1) Store
+  auto store = std::make_shared<FileOutboxStore>(FileOutboxStore::Config{
+      .file_path = test_dir / "outbox.json",
+      .pretty_json = false,
+      .fsync_on_write = false});
+
+  auto outbox = std::make_shared<Outbox>(
+      Outbox::Config{
+          .owner = "test-engine",
+      },
+      store);
+
+  // 2) Probe: always online
+  auto probe = std::make_shared<vix::net::NetworkProbe>(
+      vix::net::NetworkProbe::Config{},
+      []
+      { return true; });
+
+  // 3) Transport: target is down (retryable failures)
+  auto transport = std::make_shared<FakeHttpTransport>();
+  transport->setRuleForTarget(
+      "/api/down",
+      FakeHttpTransport::Rule{.ok = false, .retryable = true, .error = "503"});
+
+  // 4) Engine: breaker opens after 2 consecutive failures
+  SyncEngine::Config ecfg;
+  ecfg.worker_count = 1;
+  ecfg.batch_limit = 50;
+  ecfg.circuit_breaker.enabled = true;
+  ecfg.circuit_breaker.failure_threshold = 2;
+  ecfg.circuit_breaker.open_duration_ms = 10'000;
+
+  SyncEngine engine(ecfg, outbox, probe, transport);
+
+  // 5) Enqueue 5 ops for the failing target
+  const auto t0 = clock->now_ms();
+  for (int i = 0; i < 5; ++i)
+  {
+    Operation op;
+    op.kind = "http.post";
+    op.target = "/api/down";
+    op.payload = "{}";
+    outbox->enqueue(op, t0);
+  }
+
+  // 6) Tick => only 2 sends, then the circuit is open and the rest is skipped
+  engine.tick(t0);
+  assert(transport->callCount() == 2);
+  assert(engine.circuit_breaker()->state("/api/down", t0) == CircuitBreaker::State::Open);
+
+  ListOptions opt;
+  opt.limit = 100;
+  opt.now_ms = t0;
+  opt.only_ready = true;
+  assert(store->list(opt).size() == 3); // skipped ops are still Pending and ready
+
+  // 7) While open, nothing is sent
+  engine.tick(t0 + 5'000);
+  assert(transport->callCount() == 2);
+
+  // 8) Half-open after open_duration_ms: a single failing probe re-opens
+  engine.tick(t0 + 10'000);
+  assert(transport->callCount() == 3);
+  assert(engine.circuit_breaker()->state("/api/down", t0 + 10'000) == CircuitBreaker::State::Open);
+
+  // 9) Target recovers: the next probe closes the circuit and the backlog drains
+  transport->setRuleForTarget("/api/down", FakeHttpTransport::Rule{.ok = true});
+  engine.tick(t0 + 20'000);
+  assert(engine.circuit_breaker()->state("/api/down", t0 + 20'000) == CircuitBreaker::State::Closed);
+
+  opt.now_ms = t0 + 60'000;
+  opt.only_ready = false;
+  engine.tick(t0 + 60'000);
+  assert(store->list(opt).empty());
+
+  // 10) A tripped target with a backlog larger than batch_limit does not
+  //     starve a healthy target queued behind it
+  {
+    auto store2 = std::make_shared<FileOutboxStore>(FileOutboxStore::Config{.file_path = ""});
+    auto outbox2 = std::make_shared<Outbox>(Outbox::Config{.owner = "test-engine"}, store2);
+
+    auto transport2 = std::make_shared<FakeHttpTransport>();
+    transport2->setRuleForTarget(
+        "/api/down",
+        FakeHttpTransport::Rule{.ok = false, .retryable = true, .error = "503"});
+
+    SyncEngine engine2(ecfg, outbox2, probe, transport2);
+
+    const auto t1 = t0 + 100'000;
+    for (int i = 0; i < 200; ++i)
+    {
+      Operation op;
+      op.kind = "http.post";
+      op.target = "/api/down";
+      op.payload = "{}";
+      outbox2->enqueue(op, t1);
+    }
+
+    Operation up;
+    up.kind = "http.post";
+    up.target = "/up";
+    up.payload = "{}";
+    const auto up_id = outbox2->enqueue(up, t1 + 1);
+
+    const auto stats = engine2.tick_with_stats(t1 + 1);
+    assert(engine2.circuit_breaker()->state("/api/down", t1 + 1) == CircuitBreaker::State::Open);
+    assert(transport2->callCount() == 3); // 2 failures to /api/down, then /up
+    assert(stats.claimed == 3);
+    assert(store2->get(up_id)->status == OperationStatus::Done);
+
+    // The first window is read once; the store then passes over the open
+    // target, and skipped ops are still Pending.
+    assert(stats.scanned == 51);
+    assert(stats.skipped == 48);
+    assert(outbox2->depth().ops == 200);
+
+    // Still open: the next tick sends nothing
+    const auto idle = engine2.tick_with_stats(t1 + 2);
+    assert(idle.claimed == 0 && transport2->callCount() == 3);
+  }
+
+  std::cout << "OK: open circuit skips ops without claiming and probes when half-open\n";
+  return 0;
+}
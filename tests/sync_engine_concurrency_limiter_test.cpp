@@ -0,0 +1,199 @@
+/**
+ *
+ *  @file sync_engine_concurrency_limiter_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <vix/sync/Clock.hpp>
+#include <vix/sync/engine/ConcurrencyLimiter.hpp>
+#include <vix/sync/engine/SyncEngine.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+
+#include "fake_http_transport.hpp"
+
+static const vix::sync::engine::ConcurrencyLimiter::TargetStats *
+find_target(const std::vector<vix::sync::engine::ConcurrencyLimiter::TargetStats> &limits,
+            const std::string &target)
+{
+  for (const auto &s : limits)
+  {
+    if (s.target == target)
+      return &s;
+  }
+  return nullptr;
+}
+
+static void enqueue_n(vix::sync::outbox::Outbox &outbox, const std::string &target, int n, std::int64_t now_ms)
+{
+  for (int i = 0; i < n; ++i)
+  {
+    vix::sync::Operation op;
+    op.kind = "http.post";
+    op.target = target;
+    op.payload = "{}";
+    outbox.enqueue(op, now_ms);
+  }
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+  using namespace vix::sync::engine;
+
+  // 1) Aimd: additive increase on success, multiplicative decrease on
+  //    errors and slow sends, within [min_limit, max_limit]
+  {
+    ConcurrencyLimiter::Config cfg;
+    cfg.enabled = true;
+    cfg.initial_limit = 4.0;
+    cfg.min_limit = 2.0;
+    cfg.max_limit = 6.0;
+    cfg.additive_increase = 1.0;
+    cfg.backoff_ratio = 0.5;
+    cfg.latency_threshold_ms = 50.0;
+    cfg.decrease_interval_ms = 100;
+    ConcurrencyLimiter limiter(cfg);
+
+    for (int i = 0; i < 4; ++i)
+      assert(limiter.try_acquire("/a"));
+    assert(!limiter.try_acquire("/a"));
+    for (int i = 0; i < 4; ++i)
+      limiter.release("/a");
+
+    // A full window of successes adds one permit
+    for (int i = 0; i < 4; ++i)
+      limiter.on_sample("/a", 1.0, false, 0);
+    assert(limiter.limit("/a") > 4.9 && limiter.limit("/a") < 5.0);
+    limiter.on_sample("/a", 1.0, false, 0);
+    assert(limiter.limit("/a") >= 5.0);
+
+    for (int i = 0; i < 100; ++i)
+      limiter.on_sample("/a", 1.0, false, 0);
+    assert(limiter.limit("/a") == 6.0);
+
+    // Errors halve the limit, at most once per decrease_interval_ms
+    limiter.on_sample("/a", 1.0, true, 1'000);
+    assert(limiter.limit("/a") == 3.0);
+    limiter.on_sample("/a", 1.0, true, 1'050);
+    assert(limiter.limit("/a") == 3.0);
+    limiter.on_sample("/a", 1.0, true, 1'100);
+    assert(limiter.limit("/a") == 2.0); // 1.5 clamped to min_limit
+    limiter.on_sample("/a", 1.0, true, 1'200);
+    assert(limiter.limit("/a") == 2.0);
+
+    // Slow sends count as congestion
+    for (int i = 0; i < 100; ++i)
+      limiter.on_sample("/b", 1.0, false, 0);
+    assert(limiter.limit("/b") == 6.0);
+    limiter.on_sample("/b", 80.0, false, 1'000);
+    assert(limiter.limit("/b") == 3.0);
+  }
+
+  // 2) Idle targets back at initial_limit are forgotten, others are kept
+  {
+    ConcurrencyLimiter::Config cfg;
+    cfg.enabled = true;
+    cfg.initial_limit = 4.0;
+    cfg.idle_eviction_ms = 1'000;
+    ConcurrencyLimiter limiter(cfg);
+
+    for (int i = 0; i < 8; ++i)
+      limiter.on_sample("/hot", 1.0, false, 0);
+    assert(limiter.limit("/hot") >= 5.0);
+
+    for (int i = 0; i < 100; ++i)
+      limiter.on_sample("/item/" + std::to_string(i), 1.0, false, 0);
+    assert(limiter.snapshot().size() == 101);
+
+    limiter.on_sample("/late", 1.0, false, 2'000);
+    const auto snap = limiter.snapshot();
+    assert(snap.size() == 2);
+    assert(find_target(snap, "/hot") && find_target(snap, "/late"));
+    assert(limiter.limit("/hot") >= 5.0);
+  }
+
+  // 3) Engine: the limit bounds sends per target, is adapted once per
+  //    transport call and is reported by concurrency_limits()
+  auto clock = std::make_shared<VirtualClock>(1'000);
+
+  auto transport = std::make_shared<FakeHttpTransport>();
+  transport->setRuleForTarget("/down", FakeHttpTransport::Rule{.ok = false, .retryable = true, .error = "503"});
+
+  SyncEngine::Config ecfg;
+  ecfg.worker_count = 1;
+  ecfg.batch_limit = 50;
+  ecfg.clock = clock;
+  ecfg.concurrency.enabled = true;
+  ecfg.concurrency.initial_limit = 2.0;
+  ecfg.concurrency.max_limit = 8.0;
+  ecfg.concurrency.decrease_interval_ms = 0;
+
+  {
+    auto store = std::make_shared<FileOutboxStore>(FileOutboxStore::Config{.file_path = ""});
+    auto outbox = std::make_shared<Outbox>(Outbox::Config{.owner = "test", .clock = clock}, store);
+    SyncEngine engine(ecfg, outbox, nullptr, transport);
+
+    // A target at its limit does not hold back the others behind it
+    enqueue_n(*outbox, "/a", 200, clock->now_ms());
+    enqueue_n(*outbox, "/b", 1, clock->now_ms() + 1);
+
+    auto st = engine.tick_with_stats(clock->now_ms() + 1);
+    assert(st.claimed == 3);
+    assert(transport->callCount() == 3);
+
+    auto limits = engine.concurrency_limits();
+    const auto *a = find_target(limits, "/a");
+    assert(a && a->samples == 2 && a->inflight == 0);
+    assert(a->limit > 2.0 && a->limit == engine.concurrency_limiter()->limit("/a"));
+
+    // Later ticks get the extra permits earned by the successes
+    clock->advance_ms(10);
+    while (engine.concurrency_limiter()->limit("/a") < 3.0)
+    {
+      engine.tick(clock->now_ms());
+      clock->advance_ms(10);
+    }
+    const auto before = transport->callCount();
+    engine.tick(clock->now_ms());
+    assert(transport->callCount() - before >= 3);
+
+    // Retryable errors shrink the reported limit
+    enqueue_n(*outbox, "/down", 4, clock->now_ms());
+    engine.tick(clock->now_ms());
+    limits = engine.concurrency_limits();
+    assert(find_target(limits, "/down")->limit == 1.0);
+  }
+
+  // 4) A batched send is a single sample
+  {
+    ecfg.send_batch_max_ops = 10;
+    ecfg.concurrency.initial_limit = 8.0;
+
+    auto store = std::make_shared<FileOutboxStore>(FileOutboxStore::Config{.file_path = ""});
+    auto outbox = std::make_shared<Outbox>(Outbox::Config{.owner = "test", .clock = clock}, store);
+    auto batched = std::make_shared<FakeHttpTransport>();
+    SyncEngine engine(ecfg, outbox, nullptr, batched);
+
+    enqueue_n(*outbox, "/bulk", 6, clock->now_ms());
+    assert(engine.tick(clock->now_ms()) == 6);
+    assert(batched->batchSizes().size() == 1);
+    assert(find_target(engine.concurrency_limits(), "/bulk")->samples == 1);
+  }
+
+  std::cout << "OK: concurrency limits adapt per transport call and are reported\n";
+  return 0;
+}
@@ -0,0 +1,132 @@
+/**
+ *
+ *  @file sync_engine_dead_letter_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
+#include <vix/net/NetworkProbe.hpp>
+#include <vix/sync/Clock.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+#include <vix/sync/outbox/FileDeadLetterStore.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/engine/SyncEngine.hpp>
+
+#include "fake_http_transport.hpp"
+
+static void reset_test_dir(const std::filesystem::path &dir)
+{
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  std::filesystem::create_directories(dir, ec);
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+  using namespace vix::sync::engine;
+
+  const auto clock = default_clock();
+
+  const std::filesystem::path test_dir = "./.vix_test_dead_letter";
+  reset_test_dir(test_dir);
+
+  auto store = std::make_shared<FileOutboxStore>(FileOutboxStore::Config{
+      .file_path = test_dir / "outbox.json",
+      .pretty_json = true,
+      .fsync_on_write = false});
+
+  auto dlq = std::make_shared<FileDeadLetterStore>(FileDeadLetterStore::Config{
+      .file_path = test_dir / "deadletter.json",
+      .pretty_json = true});
+
+  Outbox::Config ocfg;
+  ocfg.owner = "test-engine";
+  ocfg.dead_letter = dlq;
+  auto outbox = std::make_shared<Outbox>(ocfg, store);
+
+  auto probe = std::make_shared<vix::net::NetworkProbe>(
+      vix::net::NetworkProbe::Config{},
+      []
+      { return true; });
+
+  auto transport = std::make_shared<FakeHttpTransport>();
+  transport->setRuleForTarget(
+      "/api/messages",
+      FakeHttpTransport::Rule{
+          .ok = false,
+          .retryable = false,
+          .error = "bad request (permanent)"});
+
+  SyncEngine::Config ecfg;
+  ecfg.worker_count = 1;
+  ecfg.batch_limit = 10;
+  ecfg.idle_sleep_ms = 0;
+  ecfg.offline_sleep_ms = 0;
+
+  SyncEngine engine(ecfg, outbox, probe, transport);
+
+  Operation op;
+  op.kind = "http.post";
+  op.target = "/api/messages";
+  op.payload = R"({"text":"hello"})";
+
+  const auto id = outbox->enqueue(op, clock->now_ms());
+
+  // 1) Permanent failure => moved out of the outbox into the dead-letter store
+  engine.tick(clock->now_ms());
+  assert(transport->callCount() == 1);
+  assert(!store->get(id).has_value());
+  assert(outbox->depth().ops == 0);
+
+  auto dead = dlq->get(id);
+  assert(dead.has_value());
+  assert(dead->status == OperationStatus::PermanentFailed);
+  assert(dead->last_error.find("permanent") != std::string::npos);
+
+  DeadLetterQuery q;
+  q.target = "/api/messages";
+  assert(dlq->list(q).size() == 1);
+  q.target = "/api/other";
+  assert(dlq->list(q).empty());
+
+  // 2) Dead letters survive a reload
+  {
+    FileDeadLetterStore reloaded(FileDeadLetterStore::Config{
+        .file_path = test_dir / "deadletter.json"});
+    assert(reloaded.count() == 1);
+  }
+
+  // 3) Redrive once the target is fixed => sent and completed
+  transport->setRuleForTarget("/api/messages", FakeHttpTransport::Rule{.ok = true});
+
+  assert(outbox->redrive(id, clock->now_ms()));
+  assert(dlq->count() == 0);
+
+  auto back = store->get(id);
+  assert(back.has_value());
+  assert(back->status == OperationStatus::Pending);
+  assert(back->attempt == 0);
+
+  engine.tick(clock->now_ms());
+  assert(transport->callCount() == 2);
+
+  auto done = store->get(id);
+  assert(done.has_value());
+  assert(done->status == OperationStatus::Done);
+
+  std::cout << "OK: permanent failures are dead-lettered and can be redriven\n";
+  return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ *
+ *  @file sync_engine_deadline_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
+#include <vix/net/NetworkProbe.hpp>
+#include <vix/sync/Clock.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/engine/SyncEngine.hpp>
+
+#include "fake_http_transport.hpp"
+
+static void reset_test_dir(const std::filesystem::path &dir)
+{
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  std::filesystem::create_directories(dir, ec);
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+  using namespace vix::sync::engine;
+
+  const auto clock = default_clock();
+
+  const std::filesystem::path test_dir = "./.vix_test_deadline";
+  reset_test_dir(test_dir);
+
+  // 1) Store + outbox with a default TTL of 100ms
+  auto store = std::make_shared<FileOutboxStore>(FileOutboxStore::Config{
+      .file_path = test_dir / "outbox.json",
+      .pretty_json = false,
+      .fsync_on_write = false});
+
+  auto outbox = std::make_shared<Outbox>(
+      Outbox::Config{
+          .owner = "test-engine",
+          .default_ttl_ms = 100,
+      },
+      store);
+
+  // 2) Probe: always online
+  auto probe = std::make_shared<vix::net::NetworkProbe>(
+      vix::net::NetworkProbe::Config{},
+      []
+      { return true; });
+
+  // 3) Transport: success
+  auto transport = std::make_shared<FakeHttpTransport>();
+  transport->setDefault({.ok = true});
+
+  SyncEngine::Config ecfg;
+  ecfg.worker_count = 1;
+  ecfg.batch_limit = 10;
+
+  SyncEngine engine(ecfg, outbox, probe, transport);
+
+  // 4) One op with the default TTL, one with an explicit late deadline
+  const auto t0 = clock->now_ms();
+
+  Operation stale;
+  stale.kind = "presence.update";
+  stale.target = "/api/presence";
+  const auto stale_id = outbox->enqueue(stale, t0);
+
+  Operation fresh;
+  fresh.kind = "chat.send";
+  fresh.target = "/api/messages";
+  fresh.deadline_at_ms = t0 + 60'000;
+  const auto fresh_id = outbox->enqueue(fresh, t0);
+
+  assert(store->get(stale_id)->deadline_at_ms == t0 + 100);
+
+  // 5) Expired ops are never listed as ready
+  assert(outbox->peek_ready(t0 + 150, 10).size() == 1);
+
+  // 6) Tick after the TTL => stale op is swept to Expired, never sent
+  engine.tick(t0 + 150);
+  assert(transport->callCount() == 1);
+
+  auto s = store->get(stale_id);
+  assert(s.has_value());
+  assert(s->status == OperationStatus::Expired);
+  assert(store->get(fresh_id)->status == OperationStatus::Done);
+
+  // 7) Expired ops are terminal: not claimable, pruned like Done ones
+  assert(!outbox->claim(stale_id, t0 + 200));
+  assert(store->prune_done(t0 + 200) == 2);
+  assert(!store->get(stale_id).has_value());
+
+  std::cout << "OK: ops past their deadline are expired without being sent\n";
+  return 0;
+}
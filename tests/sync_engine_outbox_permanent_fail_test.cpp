@@ -12,24 +12,18 @@
  *
  */
 #include <cassert>
-#include <chrono>
 #include <filesystem>
 #include <iostream>
 #include <memory>
 
 #include <vix/net/NetworkProbe.hpp>
+#include <vix/sync/Clock.hpp>
 #include <vix/sync/outbox/Outbox.hpp>
 #include <vix/sync/outbox/FileOutboxStore.hpp>
 #include <vix/sync/engine/SyncEngine.hpp>
 
 #include "fake_http_transport.hpp"
 
-static std::int64_t now_ms()
-{
-  using namespace std::chrono;
-  return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
-}
-
 static void reset_test_dir(const std::filesystem::path &dir)
 {
   std::error_code ec;
@@ -43,6 +37,8 @@ int main()
   using namespace vix::sync::outbox;
   using namespace vix::sync::engine;
 
+  const auto clock = default_clock();
+
   const std::filesystem::path test_dir = "./.vix_test_perm";
   reset_test_dir(test_dir);
 
@@ -88,11 +84,11 @@ int main()
   op.target = "/api/messages";
   op.payload = R"({"text":"hello offline"})";
 
-  const auto t0 = now_ms();
+  const auto t0 = clock->now_ms();
   const auto id = outbox->enqueue(op, t0);
 
   // 6) Tick engine => should attempt once and then mark PermanentFailed
-  const auto processed1 = engine.tick(now_ms());
+  const auto processed1 = engine.tick(clock->now_ms());
   assert(processed1 >= 1);
   assert(transport->callCount() == 1);
 
@@ -102,7 +98,7 @@ int main()
   assert(saved1->last_error.find("permanent") != std::string::npos);
 
   // 7) Tick again => MUST NOT retry (it should not come back from peek_ready)
-  const auto processed2 = engine.tick(now_ms());
+  const auto processed2 = engine.tick(clock->now_ms());
   // processed2 could be 0 (most likely) – but the key assertion is: no more sends
   (void)processed2;
   assert(transport->callCount() == 1);
@@ -12,29 +12,25 @@
  *
  */
 #include <cassert>
-#include <chrono>
 #include <iostream>
 #include <memory>
 
 #include <vix/net/NetworkProbe.hpp>
+#include <vix/sync/Clock.hpp>
 #include <vix/sync/outbox/Outbox.hpp>
 #include <vix/sync/outbox/FileOutboxStore.hpp>
 #include <vix/sync/engine/SyncEngine.hpp>
 
 #include "fake_http_transport.hpp"
 
-static std::int64_t now_ms()
-{
-  using namespace std::chrono;
-  return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
-}
-
 int main()
 {
   using namespace vix::sync;
   using namespace vix::sync::outbox;
   using namespace vix::sync::engine;
 
+  const auto clock = default_clock();
+
   // 1) Outbox store
   auto store = std::make_shared<FileOutboxStore>(FileOutboxStore::Config{
       .file_path = "./.vix_test/outbox.json",
@@ -70,11 +66,11 @@ int main()
   op.target = "/api/messages";
   op.payload = R"({"text":"hello offline"})";
 
-  const auto t0 = now_ms();
+  const auto t0 = clock->now_ms();
   const auto id = outbox->enqueue(op, t0);
 
   // 6) Tick engine => should send and complete
-  const auto processed = engine.tick(now_ms());
+  const auto processed = engine.tick(clock->now_ms());
   assert(processed >= 1);
 
   auto saved = store->get(id);
@@ -0,0 +1,158 @@
+/**
+ *
+ *  @file sync_engine_rate_limit_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <vix/sync/Clock.hpp>
+#include <vix/sync/engine/RateLimiter.hpp>
+#include <vix/sync/engine/SyncEngine.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+
+#include "fake_http_transport.hpp"
+
+static vix::sync::Operation make_op(const std::string &kind, const std::string &target)
+{
+  vix::sync::Operation op;
+  op.kind = kind;
+  op.target = target;
+  op.payload = "{}";
+  return op;
+}
+
+static vix::sync::engine::RateLimiter::Rule make_rule(
+    vix::sync::engine::RateLimiter::KeyBy key_by,
+    double rate_per_sec,
+    double burst)
+{
+  vix::sync::engine::RateLimiter::Rule r;
+  r.key_by = key_by;
+  r.rate_per_sec = rate_per_sec;
+  r.burst = burst;
+  return r;
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+  using namespace vix::sync::engine;
+
+  // 1) Burst capacity, then refill over time
+  {
+    RateLimiter limiter(RateLimiter::Config{.rules = {make_rule(RateLimiter::KeyBy::Rule, 2.0, 3.0)}});
+    const auto op = make_op("k", "/t");
+
+    for (int i = 0; i < 3; ++i)
+      assert(limiter.try_acquire(op, 0).allowed);
+
+    auto d = limiter.try_acquire(op, 0);
+    assert(!d.allowed);
+    assert(d.retry_at_ms == 500);
+
+    assert(!limiter.try_acquire(op, 499).allowed);
+    assert(limiter.try_acquire(op, 500).allowed);
+    assert(!limiter.try_acquire(op, 500).allowed);
+
+    // A refunded token can be taken again
+    limiter.refund(op);
+    assert(limiter.try_acquire(op, 500).allowed);
+
+    // Refill is capped at burst
+    for (int i = 0; i < 3; ++i)
+      assert(limiter.try_acquire(op, 60'000).allowed);
+    assert(!limiter.try_acquire(op, 60'000).allowed);
+  }
+
+  // 2) Per-kind and per-target buckets are independent
+  {
+    auto per_target = make_rule(RateLimiter::KeyBy::Target, 1.0, 1.0);
+    per_target.target = "/limited";
+    RateLimiter limiter(RateLimiter::Config{.rules = {make_rule(RateLimiter::KeyBy::Kind, 1.0, 1.0), per_target}});
+
+    assert(limiter.try_acquire(make_op("a", "/x"), 0).allowed);
+    assert(!limiter.try_acquire(make_op("a", "/y"), 0).allowed); // kind "a" is empty
+    assert(limiter.try_acquire(make_op("b", "/x"), 0).allowed);  // kind "b" has its own bucket
+
+    assert(limiter.try_acquire(make_op("c", "/limited"), 0).allowed);
+    assert(!limiter.try_acquire(make_op("d", "/limited"), 0).allowed); // target bucket empty
+    assert(limiter.try_acquire(make_op("d", "/other"), 0).allowed);    // denied all-or-nothing: kind "d" kept its token
+  }
+
+  // 3) Idle buckets are dropped once refilled
+  {
+    RateLimiter limiter(RateLimiter::Config{.rules = {make_rule(RateLimiter::KeyBy::Target, 10.0, 10.0)}});
+
+    for (int i = 0; i < 100; ++i)
+      assert(limiter.try_acquire(make_op("k", "/item/" + std::to_string(i)), 0).allowed);
+    assert(limiter.bucket_count() == 100);
+
+    assert(limiter.try_acquire(make_op("k", "/item/0"), 500).allowed);
+    assert(limiter.bucket_count() == 100); // not idle for a refill period yet
+
+    assert(limiter.try_acquire(make_op("k", "/new"), 1'400).allowed);
+    assert(limiter.bucket_count() == 2); // "/item/0" was used at 500
+  }
+
+  // 4) Engine: throttled ops stay Pending, other kinds are not held back
+  {
+    auto clock = std::make_shared<VirtualClock>(10'000);
+
+    auto store = std::make_shared<FileOutboxStore>(FileOutboxStore::Config{.file_path = ""});
+    auto outbox = std::make_shared<Outbox>(Outbox::Config{.owner = "test", .clock = clock}, store);
+    auto transport = std::make_shared<FakeHttpTransport>();
+
+    SyncEngine::Config ecfg;
+    ecfg.worker_count = 1;
+    ecfg.batch_limit = 50;
+    ecfg.clock = clock;
+    auto slow = make_rule(RateLimiter::KeyBy::Rule, 1.0, 1.0);
+    slow.kind = "slow";
+    ecfg.rate_limits.rules.push_back(slow);
+    SyncEngine engine(ecfg, outbox, nullptr, transport);
+
+    std::vector<std::string> slow_ids;
+    for (int i = 0; i < 200; ++i)
+      slow_ids.push_back(outbox->enqueue(make_op("slow", "/api"), clock->now_ms()));
+    const auto fast_id = outbox->enqueue(make_op("fast", "/api"), clock->now_ms() + 1);
+
+    const auto now = clock->now_ms() + 1;
+    const auto st = engine.tick_with_stats(now);
+    assert(st.claimed == 2);
+    assert(transport->callCount() == 2);
+    assert(store->get(fast_id)->status == OperationStatus::Done);
+    assert(store->get(slow_ids[0])->status == OperationStatus::Done);
+
+    // Throttled, not failed: no attempt consumed, no retry scheduled
+    const auto held = store->get(slow_ids[1]);
+    assert(held->status == OperationStatus::Pending);
+    assert(held->attempt == 0);
+    assert(held->last_error.empty());
+    assert(engine.next_wake_at_ms() == now + 1'000);
+
+    // Nothing more before the next token
+    engine.tick(now + 999);
+    assert(transport->callCount() == 2);
+
+    engine.tick(now + 1'000);
+    assert(transport->callCount() == 3);
+    assert(store->get(slow_ids[1])->status == OperationStatus::Done);
+  }
+
+  std::cout << "OK: rate limits throttle per bucket without holding back other work\n";
+  return 0;
+}
@@ -0,0 +1,241 @@
+/**
+ *
+ *  @file sync_metrics_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <vix/sync/Clock.hpp>
+#include <vix/sync/Metrics.hpp>
+#include <vix/sync/engine/SyncEngine.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+
+#include "fake_http_transport.hpp"
+
+static void reset_test_dir(const std::filesystem::path &dir)
+{
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  std::filesystem::create_directories(dir, ec);
+}
+
+static bool contains(const std::string &s, const std::string &needle)
+{
+  return s.find(needle) != std::string::npos;
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+  using namespace vix::sync::engine;
+
+  // 1) Log-linear buckets: contiguous, and within 12.5% of the value
+  for (std::size_t i = 1; i < Histogram::kBuckets; ++i)
+    assert(Histogram::bucket_lower(i) == Histogram::bucket_upper(i - 1));
+
+  for (std::uint64_t v : {0ull, 1ull, 7ull, 8ull, 15ull, 16ull, 1000ull, 123456789ull, (1ull << 47) + 5})
+  {
+    const auto i = Histogram::bucket_index(v);
+    assert(Histogram::bucket_lower(i) <= v && v < Histogram::bucket_upper(i));
+    const auto width = Histogram::bucket_upper(i) - Histogram::bucket_lower(i);
+    assert(v < 8 || width * 8 <= v);
+  }
+  assert(Histogram::bucket_index(~0ull) == Histogram::kBuckets - 1);
+
+  // 2) Percentiles
+  {
+    Histogram h;
+    for (std::uint64_t v = 1; v <= 1000; ++v)
+      h.record(v * 1000);
+
+    const auto s = h.snapshot();
+    assert(s.count == 1000);
+    assert(s.max == 1'000'000);
+    assert(s.sum == 500'500'000);
+
+    const auto p50 = s.percentile(0.5);
+    assert(p50 >= 500'000 && p50 <= 500'000 + 500'000 / 8);
+    assert(s.percentile(1.0) == 1'000'000);
+    assert(s.count_at_or_below(1'048'575) == 1000);
+  }
+
+  // 3) Sharded counter summed across threads
+  {
+    MetricsRegistry reg;
+    auto &c = reg.counter("test_events_total", "Events");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 12; ++t)
+      threads.emplace_back([&]
+                           { for (int i = 0; i < 10'000; ++i) c.add(); });
+    for (auto &t : threads)
+      t.join();
+
+    assert(c.value() == 120'000);
+    assert(&reg.counter("test_events_total") == &c);
+    assert(reg.snapshot().counter("test_events_total") == 120'000);
+
+    bool threw = false;
+    try
+    {
+      reg.gauge("test_events_total");
+    }
+    catch (const std::invalid_argument &)
+    {
+      threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try
+    {
+      reg.counter("bad name");
+    }
+    catch (const std::invalid_argument &)
+    {
+      threw = true;
+    }
+    assert(threw);
+
+    // Labeled gauges: escaped label values, series replaced as a whole
+    auto &limits = reg.gauge_vec("test_limit", "target", "Limit");
+    assert(&reg.gauge_vec("test_limit", "target") == &limits);
+    limits.set_all({{"/a", 2.5}, {"say \"hi\"\n", 1.0}});
+    auto text = reg.to_prometheus();
+    assert(contains(text, "# TYPE test_limit gauge\ntest_limit{target=\"/a\"} 2.5\n"));
+    assert(contains(text, "test_limit{target=\"say \\\"hi\\\"\\n\"} 1\n"));
+
+    limits.set_all({{"/b", 3.0}});
+    const auto snap = reg.snapshot();
+    assert(snap.gauge_vec("test_limit")->size() == 1);
+    assert(snap.gauge_vec("test_limit")->front().first == "/b");
+    assert(!contains(reg.to_prometheus(), "/a"));
+
+    threw = false;
+    try
+    {
+      reg.gauge_vec("test_other", "bad:label");
+    }
+    catch (const std::invalid_argument &)
+    {
+      threw = true;
+    }
+    assert(threw);
+  }
+
+  // 4) Sync pipeline metrics
+  const std::filesystem::path test_dir = "./.vix_test_metrics";
+  reset_test_dir(test_dir);
+
+  auto metrics = std::make_shared<SyncMetrics>();
+  auto clock = std::make_shared<VirtualClock>(1'000);
+
+  FileOutboxStore::Config scfg;
+  scfg.file_path = test_dir / "outbox.json";
+  scfg.metrics = metrics;
+  auto store = std::make_shared<FileOutboxStore>(scfg);
+
+  Outbox::Config ocfg;
+  ocfg.owner = "test";
+  ocfg.clock = clock;
+  ocfg.metrics = metrics;
+  auto outbox = std::make_shared<Outbox>(ocfg, store);
+
+  auto transport = std::make_shared<FakeHttpTransport>();
+  transport->setDefault({.ok = true});
+  transport->setRuleForTarget("/retry", {.ok = false, .retryable = true});
+  transport->setRuleForTarget("/reject", {.ok = false, .retryable = false});
+
+  SyncEngine::Config ecfg;
+  ecfg.concurrency.enabled = true;
+  SyncEngine engine(ecfg, outbox, nullptr, transport);
+  assert(engine.metrics() == metrics);
+
+  for (const char *target : {"/ok", "/ok", "/retry", "/reject"})
+  {
+    Operation op;
+    op.kind = "http.post";
+    op.target = target;
+    op.payload = "{}";
+    op.idempotency_key = std::string("k") + target + std::to_string(store->depth().ops);
+    outbox->enqueue(op);
+  }
+
+  Operation dup;
+  dup.kind = "http.post";
+  dup.target = "/ok";
+  dup.idempotency_key = "k/ok0";
+  outbox->enqueue(dup);
+
+  assert(engine.tick() == 4);
+
+  const auto snap = metrics->snapshot();
+  assert(snap.counter("vix_sync_enqueued_total") == 4);
+  assert(snap.counter("vix_sync_enqueue_duplicates_total") == 1);
+  assert(snap.counter("vix_sync_claimed_total") == 4);
+  assert(snap.counter("vix_sync_sent_total") == 4);
+  assert(snap.counter("vix_sync_completed_total") == 2);
+  assert(snap.counter("vix_sync_failed_total") == 1);
+  assert(snap.counter("vix_sync_failed_permanent_total") == 1);
+  assert(snap.gauge("vix_sync_queue_depth") == 1); // the retry
+
+  const auto *by_priority = snap.gauge_vec("vix_sync_queue_depth_by_priority");
+  assert(by_priority && by_priority->size() == 1);
+  assert(by_priority->front() == std::make_pair(std::string("0"), 1.0));
+
+  const auto *limits = snap.gauge_vec("vix_sync_concurrency_limit");
+  assert(limits && limits->size() == 3);
+  for (const auto &[target, limit] : *limits)
+    assert(limit == engine.concurrency_limiter()->limit(target));
+
+  assert(snap.histogram("vix_sync_enqueue_seconds")->count == 5);
+  assert(snap.histogram("vix_sync_send_seconds")->count == snap.counter("vix_sync_send_batches_total"));
+  assert(snap.histogram("vix_sync_complete_seconds")->count == 2);
+  assert(snap.counter("vix_sync_store_flushes_total") > 0);
+  assert(snap.counter("vix_sync_store_flush_bytes_total") > 0);
+  assert(snap.histogram("vix_sync_store_flush_seconds")->count == snap.counter("vix_sync_store_flushes_total"));
+
+  // 5) Prometheus exposition
+  const auto text = metrics->to_prometheus();
+  assert(contains(text, "# TYPE vix_sync_enqueued_total counter\nvix_sync_enqueued_total 4\n"));
+  assert(contains(text, "# TYPE vix_sync_queue_depth gauge\n"));
+  assert(contains(text, "vix_sync_queue_depth_by_priority{priority=\"0\"} 1\n"));
+  assert(contains(text, "vix_sync_concurrency_limit{target=\"/retry\"} "));
+  assert(contains(text, "# TYPE vix_sync_send_seconds histogram\n"));
+  assert(contains(text, "vix_sync_complete_seconds_bucket{le=\"+Inf\"} 2\n"));
+  assert(contains(text, "vix_sync_complete_seconds_count 2\n"));
+
+  const auto prom = test_dir / "metrics.prom";
+  std::ofstream(prom) << std::string(text.size() * 2, 'x');
+  metrics->write_prometheus(prom);
+  assert(!std::filesystem::exists(std::filesystem::path(prom).concat(".tmp")));
+  {
+    std::ifstream in(prom);
+    const std::string written((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    assert(contains(written, "vix_sync_enqueued_total 4\n"));
+    assert(written == metrics->to_prometheus());
+  }
+
+  std::cout << "OK: metrics count the sync pipeline and export Prometheus text\n";
+  return 0;
+}
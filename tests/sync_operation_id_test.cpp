@@ -0,0 +1,61 @@
+/**
+ *
+ *  @file sync_operation_id_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+
+#include <vix/sync/OperationId.hpp>
+
+int main()
+{
+  using vix::sync::OperationId;
+
+  // 1) Strictly increasing within one thread, even in the same millisecond
+  const std::int64_t t = 1'700'000'000'000;
+  auto prev = OperationId::generate(t);
+  std::unordered_set<std::string> seen;
+  seen.insert(prev.to_string());
+
+  for (int i = 0; i < 100'000; ++i)
+  {
+    const auto id = OperationId::generate(t + i / 1000);
+    assert(prev < id);
+
+    const auto text = id.to_string();
+    assert(prev.to_string() < text);
+    assert(seen.insert(text).second);
+    prev = id;
+  }
+
+  // 2) Clock going backwards does not break ordering
+  const auto back = OperationId::generate(t - 10'000);
+  assert(prev < back);
+
+  // 3) Text round-trip and embedded timestamp
+  const auto id = OperationId::generate(t + 500'000);
+  const auto text = id.to_string();
+  assert(text.size() == OperationId::text_size);
+  assert(id.timestamp_ms() == t + 500'000);
+
+  auto parsed = OperationId::parse(text);
+  assert(parsed.has_value());
+  assert(*parsed == id);
+
+  assert(!OperationId::parse("too-short").has_value());
+  assert(!OperationId::parse("8ZZZZZZZZZZZZZZZZZZZZZZZZZ").has_value());
+
+  std::cout << "OK: operation ids are unique, ordered and round-trip\n";
+  return 0;
+}
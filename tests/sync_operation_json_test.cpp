@@ -0,0 +1,255 @@
+/**
+ *
+ *  @file sync_operation_json_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <vix/json/json.hpp>
+#include <vix/sync/outbox/FileDeadLetterStore.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+
+using json = nlohmann::json;
+
+static void reset_test_dir(const std::filesystem::path &dir)
+{
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  std::filesystem::create_directories(dir, ec);
+}
+
+static void write_text(const std::filesystem::path &p, const std::string &text)
+{
+  std::ofstream out(p, std::ios::binary | std::ios::trunc);
+  out << text;
+}
+
+static std::string read_text(const std::filesystem::path &p)
+{
+  std::ifstream in(p, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+static vix::sync::Operation make_op(const std::string &id, const std::string &text)
+{
+  vix::sync::Operation op;
+  op.id = id;
+  op.kind = "http.post";
+  op.target = "/t/" + text;
+  op.payload = text;
+  op.idempotency_key = "k-" + id;
+  op.created_at_ms = 1'000;
+  op.updated_at_ms = 2'000;
+  op.attempt = 3;
+  op.next_retry_at_ms = -5;
+  op.status = vix::sync::OperationStatus::Failed;
+  op.last_error = text;
+  op.priority = -7;
+  op.coalesce_key = "c";
+  op.deadline_at_ms = 9'000'000'000;
+  return op;
+}
+
+static void assert_same(const vix::sync::Operation &a, const vix::sync::Operation &b)
+{
+  assert(a.id == b.id);
+  assert(a.kind == b.kind);
+  assert(a.target == b.target);
+  assert(a.payload.view() == b.payload.view());
+  assert(a.idempotency_key == b.idempotency_key);
+  assert(a.created_at_ms == b.created_at_ms);
+  assert(a.updated_at_ms == b.updated_at_ms);
+  assert(a.attempt == b.attempt);
+  assert(a.next_retry_at_ms == b.next_retry_at_ms);
+  assert(a.status == b.status);
+  assert(a.last_error == b.last_error);
+  assert(a.priority == b.priority);
+  assert(a.coalesce_key == b.coalesce_key);
+  assert(a.deadline_at_ms == b.deadline_at_ms);
+}
+
+template <typename Fn>
+static bool throws(Fn &&fn)
+{
+  try
+  {
+    fn();
+  }
+  catch (const std::runtime_error &)
+  {
+    return true;
+  }
+  return false;
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+
+  const std::filesystem::path test_dir = "./.vix_test_operation_json";
+  reset_test_dir(test_dir);
+
+  // Strings with something to escape at every offset of the SIMD scan.
+  std::vector<std::string> texts = {"", "plain", "caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80"};
+  for (std::size_t at = 0; at < 40; ++at)
+  {
+    for (const char special : {'"', '\\', '\n', '\x01', '\x1f', '\t'})
+    {
+      std::string s(40, 'a');
+      s[at] = special;
+      texts.push_back(s);
+    }
+  }
+  texts.push_back(std::string("nul\0inside", 10));
+
+  // 1) Round trip through both stores, compact and pretty
+  for (const bool pretty : {false, true})
+  {
+    FileOutboxStore::Config scfg;
+    scfg.file_path = test_dir / (pretty ? "pretty.json" : "compact.json");
+    scfg.pretty_json = pretty;
+
+    FileDeadLetterStore::Config dcfg;
+    dcfg.file_path = test_dir / (pretty ? "dl_pretty.json" : "dl_compact.json");
+    dcfg.pretty_json = pretty;
+
+    {
+      FileOutboxStore store(scfg);
+      FileDeadLetterStore dead(dcfg);
+      for (std::size_t i = 0; i < texts.size(); ++i)
+      {
+        store.put(make_op("op" + std::to_string(i), texts[i]));
+        dead.put(make_op("op" + std::to_string(i), texts[i]));
+      }
+    }
+
+    // Output is valid JSON with the expected layout
+    const auto text = read_text(scfg.file_path);
+    const auto doc = json::parse(text);
+    assert(doc["version"] == 1);
+    assert(doc["ops"].size() == texts.size());
+    assert(doc["ops"]["op1"]["payload"] == "plain");
+    assert((text.find('\n') != std::string::npos) == pretty);
+    assert(json::parse(read_text(dcfg.file_path))["ops"].size() == texts.size());
+
+    FileOutboxStore store(scfg);
+    FileDeadLetterStore dead(dcfg);
+    for (std::size_t i = 0; i < texts.size(); ++i)
+    {
+      const auto want = make_op("op" + std::to_string(i), texts[i]);
+      assert_same(*store.get(want.id), want);
+      assert_same(*dead.get(want.id), want);
+    }
+  }
+
+  // 2) Bytes that are not UTF-8 are kept as is
+  {
+    FileOutboxStore::Config scfg;
+    scfg.file_path = test_dir / "raw.json";
+    {
+      FileOutboxStore store(scfg);
+      store.put(make_op("raw", "\xff\xfe\xc3"));
+    }
+    FileOutboxStore store(scfg);
+    assert_same(*store.get("raw"), make_op("raw", "\xff\xfe\xc3"));
+  }
+
+  // 3) Files written with the DOM codec: sorted keys, \u escapes, extra keys and nulls
+  {
+    json op = {{"id", "a"},
+               {"kind", "k"},
+               {"target", "/x"},
+               {"payload", "\xc3\xa9\x01"},
+               {"idempotency_key", "ik"},
+               {"created_at_ms", 10},
+               {"updated_at_ms", 20},
+               {"attempt", 1},
+               {"next_retry_at_ms", 0},
+               {"status", 0},
+               {"last_error", nullptr},
+               {"future_field", {{"nested", {1, 2.5, true, nullptr}}}}};
+    json root = {{"version", 1},
+                 {"extra", "ignored"},
+                 {"owners", {{"a", "w1"}}},
+                 {"idempotency", json::object()},
+                 {"ops", {{"a", op}}}};
+
+    const auto outbox_file = test_dir / "dom.json";
+    write_text(outbox_file, root.dump(2, ' ', true));
+
+    FileOutboxStore::Config scfg;
+    scfg.file_path = outbox_file;
+    FileOutboxStore store(scfg);
+
+    const auto got = store.get("a");
+    assert(got);
+    assert(got->payload.view() == "\xc3\xa9\x01");
+    assert(got->last_error.empty());
+    assert(got->priority == 0);
+    assert(got->updated_at_ms == 20);
+    assert(store.find_by_idempotency_key("ik", 0) == std::optional<std::string>("a"));
+
+    const auto dl_file = test_dir / "dl_dom.json";
+    write_text(dl_file, json{{"ops", {{"a", op}}}, {"version", 1}}.dump());
+
+    FileDeadLetterStore::Config dcfg;
+    dcfg.file_path = dl_file;
+    FileDeadLetterStore dead(dcfg);
+    assert(dead.count() == 1);
+    assert(dead.get("a")->target == "/x");
+  }
+
+  // 4) Surrogate pairs decode to UTF-8
+  {
+    const auto file = test_dir / "escapes.json";
+    write_text(file, R"({"ops":{"e":{"id":"e","payload":"\ud83d\ude00\u00e9\/\b\f","kind":"k"}},"version":1})");
+
+    FileDeadLetterStore::Config dcfg;
+    dcfg.file_path = file;
+    FileDeadLetterStore dead(dcfg);
+    assert(dead.get("e")->payload.view() == "\xf0\x9f\x98\x80\xc3\xa9/\b\f");
+  }
+
+  // 5) Malformed files are rejected with an error
+  for (const char *bad : {R"({"ops":{"e":{"id":"e"}})",
+                          R"({"ops":{"e":{"id":"e","payload":"\ud83d"}}})",
+                          R"({"ops":{"e":{"id":"e","attempt":x}}})",
+                          R"({"ops":{"e":{"id":"e"}}} trailing)",
+                          R"({"ops":{"e":{"id":"unterminated}}})"})
+  {
+    const auto file = test_dir / "bad.json";
+    write_text(file, bad);
+
+    FileDeadLetterStore::Config dcfg;
+    dcfg.file_path = file;
+    FileDeadLetterStore dead(dcfg);
+    assert(throws([&]
+                  { dead.count(); }));
+
+    FileOutboxStore::Config scfg;
+    scfg.file_path = file;
+    FileOutboxStore store(scfg);
+    assert(throws([&]
+                  { store.get("e"); }));
+  }
+
+  std::cout << "OK: operations stream to and from JSON without a DOM\n";
+  return 0;
+}
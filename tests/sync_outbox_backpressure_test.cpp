@@ -0,0 +1,191 @@
+/**
+ *
+ *  @file sync_outbox_backpressure_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+
+using vix::sync::outbox::Outbox;
+
+static vix::sync::Operation make_op(std::int32_t priority = 0, std::size_t payload_bytes = 2)
+{
+  vix::sync::Operation op;
+  op.kind = "http.post";
+  op.target = "/api";
+  op.payload = std::string(payload_bytes, 'x');
+  op.priority = priority;
+  return op;
+}
+
+static std::shared_ptr<vix::sync::outbox::FileOutboxStore> memory_store()
+{
+  return std::make_shared<vix::sync::outbox::FileOutboxStore>(
+      vix::sync::outbox::FileOutboxStore::Config{.file_path = ""});
+}
+
+// Footprint of make_op() once enqueued (ids and keys have a fixed length).
+static std::size_t op_bytes()
+{
+  Outbox outbox(Outbox::Config{}, memory_store());
+  outbox.enqueue(make_op(), 0);
+  return outbox.depth().bytes;
+}
+
+// Watermarks of `high` and `low` operations, counted in ops or in bytes.
+static Outbox::Backpressure limits(bool by_bytes, std::size_t high, std::size_t low, Outbox::OverflowPolicy policy)
+{
+  Outbox::Backpressure bp;
+  bp.policy = policy;
+  if (by_bytes)
+  {
+    bp.high_water_bytes = high * op_bytes();
+    bp.low_water_bytes = low * op_bytes();
+  }
+  else
+  {
+    bp.high_water_ops = high;
+    bp.low_water_ops = low;
+  }
+  return bp;
+}
+
+template <typename Fn>
+static bool rejected(Fn &&fn)
+{
+  try
+  {
+    fn();
+  }
+  catch (const vix::sync::outbox::OutboxFullError &)
+  {
+    return true;
+  }
+  return false;
+}
+
+static void settle(Outbox &outbox, const std::string &id)
+{
+  assert(outbox.claim(id, 0));
+  assert(outbox.complete(id, 0));
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+
+  for (const bool by_bytes : {false, true})
+  {
+    // 1) Reject: full at high water, accepting again only at low water
+    {
+      Outbox outbox(Outbox::Config{.backpressure = limits(by_bytes, 3, 1, Outbox::OverflowPolicy::Reject)}, memory_store());
+
+      const auto a = outbox.enqueue(make_op(), 0);
+      const auto b = outbox.enqueue(make_op(), 0);
+      outbox.enqueue(make_op(), 0);
+      assert(rejected([&]
+                      { outbox.enqueue(make_op(), 0); }));
+      assert(outbox.depth().ops == 3);
+
+      settle(outbox, a);
+      assert(rejected([&]
+                      { outbox.enqueue(make_op(), 0); })); // above low water
+
+      settle(outbox, b);
+      outbox.enqueue(make_op(), 0);
+      outbox.enqueue(make_op(), 0);
+      assert(outbox.depth().ops == 3);
+    }
+
+    // 2) DropOldest: sheds the oldest op of the lowest priority, never a
+    //    higher priority one and never an in-flight one
+    {
+      auto store = memory_store();
+      Outbox outbox(Outbox::Config{.backpressure = limits(by_bytes, 3, 3, Outbox::OverflowPolicy::DropOldest)}, store);
+
+      const auto inflight = outbox.enqueue(make_op(0), 0);
+      assert(outbox.claim(inflight, 0));
+      const auto low = outbox.enqueue(make_op(0), 1);
+      const auto high = outbox.enqueue(make_op(5), 2);
+
+      const auto newer = outbox.enqueue(make_op(0), 3);
+      assert(!store->get(low));
+      assert(store->get(inflight) && store->get(high) && store->get(newer));
+
+      // Only ops above the incoming priority are left: nothing to drop
+      const auto top = outbox.enqueue(make_op(5), 4);
+      assert(!store->get(newer));
+      assert(rejected([&]
+                      { outbox.enqueue(make_op(1), 5); }));
+      assert(store->get(top) && store->get(high) && store->get(inflight));
+      assert(outbox.depth().ops == 3);
+    }
+
+    // 3) Block: times out while full, unblocks once complete() drains to
+    //    low water
+    {
+      Outbox::Backpressure bp = limits(by_bytes, 3, 1, Outbox::OverflowPolicy::Block);
+      bp.block_timeout_ms = 50;
+      auto outbox = std::make_shared<Outbox>(Outbox::Config{.backpressure = bp}, memory_store());
+
+      const auto a = outbox->enqueue(make_op(), 0);
+      const auto b = outbox->enqueue(make_op(), 0);
+      outbox->enqueue(make_op(), 0);
+
+      const auto t0 = std::chrono::steady_clock::now();
+      assert(rejected([&]
+                      { outbox->enqueue(make_op(), 0); }));
+      assert(std::chrono::steady_clock::now() - t0 >= std::chrono::milliseconds(50));
+
+      // Same store, longer timeout
+      bp.block_timeout_ms = 10'000;
+      auto waiting = std::make_shared<Outbox>(Outbox::Config{.backpressure = bp}, outbox->store());
+      std::atomic<bool> done{false};
+      std::thread producer([&]
+                           { waiting->enqueue(make_op(), 0); done = true; });
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      assert(!done);
+
+      // Below high water but above low water: still blocked
+      settle(*waiting, a);
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      assert(!done);
+
+      settle(*waiting, b);
+      producer.join();
+      assert(done);
+      assert(outbox->depth().ops == 2);
+    }
+  }
+
+  // 4) An op larger than high_water_bytes can never fit
+  {
+    Outbox outbox(Outbox::Config{.backpressure = limits(true, 2, 1, Outbox::OverflowPolicy::DropOldest)}, memory_store());
+    outbox.enqueue(make_op(), 0);
+    outbox.enqueue(make_op(), 0);
+    assert(rejected([&]
+                    { outbox.enqueue(make_op(0, 4 * op_bytes()), 0); }));
+    assert(outbox.depth().ops == 2);
+  }
+
+  std::cout << "OK: backpressure policies bound the outbox by ops and bytes\n";
+  return 0;
+}
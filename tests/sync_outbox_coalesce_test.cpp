@@ -0,0 +1,133 @@
+/**
+ *
+ *  @file sync_outbox_coalesce_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+
+static vix::sync::Operation make_op(const std::string &target, const std::string &coalesce_key = {})
+{
+  vix::sync::Operation op;
+  op.kind = "profile.update";
+  op.target = target;
+  op.payload = "{}";
+  op.coalesce_key = coalesce_key;
+  return op;
+}
+
+static std::shared_ptr<vix::sync::outbox::FileOutboxStore> memory_store()
+{
+  return std::make_shared<vix::sync::outbox::FileOutboxStore>(
+      vix::sync::outbox::FileOutboxStore::Config{.file_path = ""});
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+
+  // 1) OnEnqueue: only the newest op per coalesce_key survives
+  {
+    auto store = memory_store();
+    Outbox outbox(Outbox::Config{.coalesce = Outbox::CoalesceMode::OnEnqueue}, store);
+
+    const auto a1 = outbox.enqueue(make_op("/a", "user:1"), 1'000);
+    const auto a2 = outbox.enqueue(make_op("/a", "user:1"), 1'001);
+    const auto b1 = outbox.enqueue(make_op("/b", "user:2"), 1'002);
+    const auto a3 = outbox.enqueue(make_op("/a", "user:1"), 1'003);
+
+    assert(!store->get(a1) && !store->get(a2));
+    assert(store->get(a3) && store->get(b1));
+    assert(outbox.depth().ops == 2);
+  }
+
+  // 2) In-flight ops are never coalesced
+  {
+    auto store = memory_store();
+    Outbox outbox(Outbox::Config{.coalesce = Outbox::CoalesceMode::OnEnqueue}, store);
+
+    const auto sent = outbox.enqueue(make_op("/a", "user:1"), 1'000);
+    assert(outbox.claim(sent, 1'000));
+
+    const auto pending = outbox.enqueue(make_op("/a", "user:1"), 1'001);
+    const auto newest = outbox.enqueue(make_op("/a", "user:1"), 1'002);
+
+    assert(store->get(sent)->status == OperationStatus::InFlight);
+    assert(!store->get(pending));
+    assert(store->get(newest));
+
+    // Once settled, the in-flight op leaves the key alone
+    assert(outbox.complete(sent, 1'003));
+    assert(outbox.depth().ops == 1);
+  }
+
+  // 3) coalesce_by_kind_target derives the key from kind and target
+  {
+    auto store = memory_store();
+    Outbox outbox(Outbox::Config{.coalesce = Outbox::CoalesceMode::OnEnqueue}, store);
+
+    const auto a1 = outbox.enqueue(make_op("/a"), 1'000);
+    const auto b1 = outbox.enqueue(make_op("/b"), 1'001);
+    const auto a2 = outbox.enqueue(make_op("/a"), 1'002);
+
+    assert(!store->get(a1));
+    assert(store->get(b1));
+    assert(store->get(a2)->coalesce_key == "profile.update\n/a");
+
+    auto plain = memory_store();
+    Outbox keyless(Outbox::Config{.coalesce = Outbox::CoalesceMode::OnEnqueue, .coalesce_by_kind_target = false}, plain);
+    keyless.enqueue(make_op("/a"), 1'000);
+    keyless.enqueue(make_op("/a"), 1'001);
+    assert(keyless.depth().ops == 2);
+  }
+
+  // 4) OnClaim: every op is recorded, only the newest is handed out
+  {
+    auto store = memory_store();
+    Outbox outbox(Outbox::Config{.coalesce = Outbox::CoalesceMode::OnClaim}, store);
+
+    const auto a1 = outbox.enqueue(make_op("/a", "user:1"), 1'000);
+    const auto a2 = outbox.enqueue(make_op("/a", "user:1"), 1'001);
+    const auto b1 = outbox.enqueue(make_op("/b", "user:2"), 1'002);
+    assert(outbox.depth().ops == 3);
+
+    const auto ready = outbox.peek_ready(2'000, 10);
+    assert(ready.size() == 2);
+    assert(ready[0].id == a2 && ready[1].id == b1);
+    assert(!store->get(a1));
+    assert(outbox.depth().ops == 2);
+  }
+
+  // 5) Disabled: everything stays queued and no key is derived
+  {
+    auto store = memory_store();
+    Outbox outbox(Outbox::Config{}, store);
+
+    const auto a1 = outbox.enqueue(make_op("/a", "user:1"), 1'000);
+    outbox.enqueue(make_op("/a", "user:1"), 1'001);
+    const auto c1 = outbox.enqueue(make_op("/c"), 1'002);
+    outbox.enqueue(make_op("/c"), 1'003);
+
+    assert(outbox.depth().ops == 4);
+    assert(store->get(a1));
+    assert(store->get(c1)->coalesce_key.empty());
+    assert(outbox.peek_ready(2'000, 10).size() == 4);
+  }
+
+  std::cout << "OK: coalescing keeps only the newest pending op per key\n";
+  return 0;
+}
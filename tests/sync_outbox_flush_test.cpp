@@ -0,0 +1,133 @@
+/**
+ *
+ *  @file sync_outbox_flush_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+
+static void reset_test_dir(const std::filesystem::path &dir)
+{
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  std::filesystem::create_directories(dir, ec);
+}
+
+static vix::sync::Operation make_op(const std::string &target)
+{
+  vix::sync::Operation op;
+  op.kind = "http.post";
+  op.target = target;
+  op.payload = std::string(2'000, 'x');
+  return op;
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+
+  const std::filesystem::path test_dir = "./.vix_test_outbox_flush";
+  reset_test_dir(test_dir);
+  const auto file = test_dir / "outbox.json";
+  const auto tmp = test_dir / "outbox.json.tmp";
+
+  // 1) Synchronous writes go through a temporary file, synced and renamed
+  {
+    std::ofstream(tmp) << "left over by a crash";
+
+    FileOutboxStore::Config scfg;
+    scfg.file_path = file;
+    scfg.fsync_on_write = true;
+    scfg.blob_threshold_bytes = 1'000;
+    auto store = std::make_shared<FileOutboxStore>(scfg);
+    Outbox outbox(Outbox::Config{.owner = "test"}, store);
+
+    const auto id = outbox.enqueue(make_op("/a"), 1'000);
+    assert(std::filesystem::exists(file));
+    assert(!std::filesystem::exists(tmp));
+    assert(!store->dirty());
+    assert(store->bytes_written() == std::filesystem::file_size(file));
+
+    FileOutboxStore reloaded(FileOutboxStore::Config{.file_path = file});
+    assert(reloaded.get(id)->payload == std::string(2'000, 'x'));
+  }
+
+  // 2) With an interval, mutations only mark the store dirty
+  reset_test_dir(test_dir);
+  {
+    FileOutboxStore::Config scfg;
+    scfg.file_path = file;
+    scfg.flush_interval_ms = 60'000;
+    auto store = std::make_shared<FileOutboxStore>(scfg);
+    Outbox outbox(Outbox::Config{.owner = "test"}, store);
+
+    const auto id1 = outbox.enqueue(make_op("/a"), 1'000);
+    const auto id2 = outbox.enqueue(make_op("/b"), 1'001);
+    assert(outbox.claim(id1, 1'100));
+    assert(store->dirty());
+    assert(!std::filesystem::exists(file));
+
+    store->flush();
+    assert(!store->dirty());
+    {
+      FileOutboxStore reloaded(FileOutboxStore::Config{.file_path = file});
+      assert(reloaded.get(id1)->status == OperationStatus::InFlight);
+      assert(reloaded.get(id2).has_value());
+    }
+
+    // 3) The destructor writes what is pending
+    assert(outbox.complete(id1, 1'200));
+    assert(store->dirty());
+  }
+  {
+    FileOutboxStore reloaded(FileOutboxStore::Config{.file_path = file});
+    assert(reloaded.depth().ops == 1);
+  }
+
+  // 4) The background flusher writes bursts of mutations together
+  reset_test_dir(test_dir);
+  {
+    FileOutboxStore::Config scfg;
+    scfg.file_path = file;
+    scfg.flush_interval_ms = 20;
+    auto store = std::make_shared<FileOutboxStore>(scfg);
+    Outbox outbox(Outbox::Config{.owner = "test"}, store);
+
+    for (int i = 0; i < 50; ++i)
+      outbox.enqueue(make_op("/burst"), 1'000 + i);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (store->dirty() && std::chrono::steady_clock::now() < deadline)
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    assert(!store->dirty());
+
+    FileOutboxStore reloaded(FileOutboxStore::Config{.file_path = file});
+    assert(reloaded.depth().ops == 50);
+
+    // far fewer writes than mutations
+    assert(store->bytes_written() < 10 * std::filesystem::file_size(file));
+  }
+
+  std::filesystem::remove_all(test_dir);
+
+  std::cout << "OK: outbox file writes are atomic and batched by the background flusher\n";
+  return 0;
+}
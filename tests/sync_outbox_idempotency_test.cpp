@@ -0,0 +1,81 @@
+/**
+ *
+ *  @file sync_outbox_idempotency_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
+#include <vix/sync/outbox/Outbox.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+
+static void reset_test_dir(const std::filesystem::path &dir)
+{
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  std::filesystem::create_directories(dir, ec);
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+
+  const std::filesystem::path test_dir = "./.vix_test_idempotency";
+  reset_test_dir(test_dir);
+
+  FileOutboxStore::Config scfg;
+  scfg.file_path = test_dir / "outbox.json";
+  scfg.idempotency_retention_ms = 10'000;
+
+  auto store = std::make_shared<FileOutboxStore>(scfg);
+  Outbox outbox(Outbox::Config{.owner = "test"}, store);
+
+  Operation op;
+  op.kind = "http.post";
+  op.target = "/api/messages";
+  op.payload = R"({"text":"hello"})";
+  op.idempotency_key = "msg-42";
+
+  // 1) A retried enqueue returns the existing id and persists nothing
+  const auto id = outbox.enqueue(op, 1'000);
+  assert(outbox.enqueue(op, 1'100) == id);
+  assert(outbox.depth().ops == 1);
+
+  // 2) Still deduplicated after completion and pruning, within retention
+  assert(outbox.claim(id, 2'000));
+  assert(outbox.complete(id, 2'000));
+  assert(store->prune_done(2'000) == 1);
+  assert(!store->get(id).has_value());
+  assert(outbox.enqueue(op, 5'000) == id);
+  assert(outbox.depth().ops == 0);
+
+  // 3) The retained key survives a reload
+  {
+    auto reloaded = std::make_shared<FileOutboxStore>(scfg);
+    assert(reloaded->find_by_idempotency_key("msg-42", 5'000) == id);
+  }
+
+  // 4) Once the retention window has elapsed, the key is free again
+  const auto id2 = outbox.enqueue(op, 12'001);
+  assert(id2 != id);
+  assert(outbox.depth().ops == 1);
+
+  // 5) Operations without a caller key are never deduplicated
+  Operation anon = op;
+  anon.idempotency_key.clear();
+  assert(outbox.enqueue(anon, 12'002) != outbox.enqueue(anon, 12'003));
+
+  std::cout << "OK: duplicate enqueues return the existing id\n";
+  return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ *
+ *  @file sync_outbox_incremental_flush_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <vix/sync/Metrics.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+
+static void reset_test_dir(const std::filesystem::path &dir)
+{
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  std::filesystem::create_directories(dir, ec);
+}
+
+// The file must always describe the store exactly.
+static void check_reload(
+    vix::sync::outbox::FileOutboxStore &store,
+    const std::filesystem::path &file,
+    bool pretty,
+    const std::vector<std::string> &ids)
+{
+  using vix::sync::outbox::FileOutboxStore;
+
+  FileOutboxStore reloaded(FileOutboxStore::Config{.file_path = file, .pretty_json = pretty});
+  for (const auto &id : ids)
+  {
+    const auto a = store.get(id);
+    const auto b = reloaded.get(id);
+    assert(a.has_value() == b.has_value());
+    if (!a)
+      continue;
+    assert(a->status == b->status);
+    assert(a->attempt == b->attempt);
+    assert(a->updated_at_ms == b->updated_at_ms);
+    assert(a->next_retry_at_ms == b->next_retry_at_ms);
+    assert(a->last_error == b->last_error);
+    assert(a->payload == b->payload);
+  }
+  assert(store.depth().ops == reloaded.depth().ops);
+}
+
+static void run(bool pretty)
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+
+  const std::filesystem::path test_dir = "./.vix_test_incremental_flush";
+  reset_test_dir(test_dir);
+  const auto file = test_dir / "outbox.json";
+
+  auto metrics = std::make_shared<SyncMetrics>();
+  auto &encoded = metrics->store_ops_encoded;
+
+  FileOutboxStore::Config scfg;
+  scfg.file_path = file;
+  scfg.pretty_json = pretty;
+  scfg.blob_threshold_bytes = 256;
+  scfg.blob_compact_min_bytes = 0;
+  scfg.metrics = metrics;
+  FileOutboxStore store(scfg);
+
+  std::vector<std::string> ids;
+  for (int i = 0; i < 20; ++i)
+  {
+    Operation op;
+    op.id = "op-" + std::to_string(i);
+    op.kind = "http.post";
+    op.target = "/t\"" + std::to_string(i % 3); // escaped in the file
+    op.payload = i % 2 ? std::string(1'024, 'a' + i) : "{\"n\":" + std::to_string(i) + "}";
+    op.created_at_ms = 1'000 + i;
+    op.updated_at_ms = 1'000 + i;
+    op.deadline_at_ms = i == 7 ? 1'500 : 0;
+    store.put(op);
+    ids.push_back(op.id);
+  }
+  assert(encoded.value() == 20);
+  check_reload(store, file, pretty, ids);
+
+  // 1) One mutation re-encodes one operation
+  auto before = encoded.value();
+  assert(store.claim("op-0", "w", 2'000));
+  assert(encoded.value() == before + 1);
+  assert(store.mark_done("op-0", 2'001));
+  assert(store.claim("op-2", "w", 2'002));
+  assert(store.mark_failed("op-2", "boom", 2'003, 3'000));
+  assert(store.claim("op-4", "w", 2'004));
+  assert(store.mark_permanent_failed("op-4", "rejected", 2'005));
+  assert(store.claim("op-6", "w", 2'006));
+  assert(encoded.value() == before + 7);
+  check_reload(store, file, pretty, ids);
+
+  // 2) Batch mutations re-encode what they touched
+  before = encoded.value();
+  assert(store.requeue_inflight_older_than(10'000, 1'000) == 1);
+  assert(encoded.value() == before + 1);
+  assert(store.expire_due(2'000) == 1);
+  assert(encoded.value() == before + 2);
+  check_reload(store, file, pretty, ids);
+
+  // 3) Removed operations leave the file
+  before = encoded.value();
+  assert(store.prune_done(5'000) == 2); // op-0 done, op-7 expired
+  assert(store.remove("op-1").has_value());
+  assert(store.remove("op-3").has_value());
+  assert(store.remove("op-5").has_value());
+  assert(encoded.value() == before);
+  check_reload(store, file, pretty, ids);
+
+  // 4) Compacting the blob file moves payloads: their refs are re-encoded
+  before = encoded.value();
+  store.compact_blobs();
+  assert(encoded.value() > before);
+  check_reload(store, file, pretty, ids);
+
+  // 5) Re-putting an operation replaces its entry
+  auto op = *store.get("op-9");
+  op.payload = "short now";
+  store.put(op);
+  check_reload(store, file, pretty, ids);
+  assert(store.get("op-9")->payload == "short now");
+}
+
+int main()
+{
+  run(false);
+  run(true);
+
+  std::filesystem::remove_all("./.vix_test_incremental_flush");
+
+  std::cout << "OK: outbox file writes only re-encode changed operations\n";
+  return 0;
+}
@@ -0,0 +1,66 @@
+/**
+ *
+ *  @file sync_outbox_memory_store_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+
+  const std::filesystem::path test_dir = "./.vix_test_memory_store";
+  std::error_code ec;
+  std::filesystem::remove_all(test_dir, ec);
+  std::filesystem::create_directories(test_dir, ec);
+  const auto cwd = std::filesystem::current_path();
+  std::filesystem::current_path(test_dir);
+
+  FileOutboxStore::Config scfg;
+  scfg.file_path.clear();
+  scfg.blob_threshold_bytes = 16; // ignored without a file
+
+  auto store = std::make_shared<FileOutboxStore>(scfg);
+  Outbox outbox(Outbox::Config{.owner = "test"}, store);
+
+  Operation op;
+  op.kind = "http.post";
+  op.target = "/api/messages";
+  op.payload = std::string(1'024, 'x');
+
+  const auto id1 = outbox.enqueue(op, 1'000);
+  const auto id2 = outbox.enqueue(op, 1'001);
+
+  // 1) The store works as usual...
+  assert(outbox.depth().ops == 2);
+  assert(store->get(id1)->payload == std::string(1'024, 'x'));
+  assert(outbox.peek_ready(1'001).size() == 2);
+  assert(outbox.claim(id1, 1'100));
+  assert(outbox.complete(id1, 1'200));
+  assert(outbox.depth().ops == 1);
+  assert(store->prune_done(2'000) == 1);
+  assert(store->get(id2).has_value());
+
+  // 2) ...without touching the filesystem
+  assert(std::filesystem::is_empty(std::filesystem::current_path()));
+
+  std::filesystem::current_path(cwd);
+  std::cout << "OK: an outbox store without a file path stays in memory\n";
+  return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ *
+ *  @file sync_outbox_payload_dedup_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <vix/sync/outbox/Outbox.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+
+static void reset_test_dir(const std::filesystem::path &dir)
+{
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  std::filesystem::create_directories(dir, ec);
+}
+
+static std::string read_file(const std::filesystem::path &p)
+{
+  std::ifstream in(p, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+
+  const std::filesystem::path test_dir = "./.vix_test_payload_dedup";
+  reset_test_dir(test_dir);
+
+  FileOutboxStore::Config scfg;
+  scfg.file_path = test_dir / "outbox.json";
+  scfg.dedupe_payloads = true;
+  scfg.blob_threshold_bytes = 4 * 1024;
+
+  auto store = std::make_shared<FileOutboxStore>(scfg);
+  Outbox outbox(Outbox::Config{.owner = "test"}, store);
+
+  const std::string note = R"({"title":"maintenance tonight"})";
+  const std::string image(16 * 1024, 'i');
+
+  // 1) Fan-out: one payload to many targets is stored once
+  std::vector<std::string> ids;
+  for (int i = 0; i < 50; ++i)
+  {
+    Operation op;
+    op.kind = "notify";
+    op.target = "/users/" + std::to_string(i);
+    op.payload = note;
+    ids.push_back(outbox.enqueue(op, 1'000 + i));
+
+    op.kind = "upload";
+    op.payload = image;
+    outbox.enqueue(op, 1'000 + i);
+  }
+
+  const auto json_text = read_file(scfg.file_path);
+  assert(json_text.find("maintenance tonight") == json_text.rfind("maintenance tonight"));
+  assert(std::filesystem::file_size(test_dir / "outbox.blob.0") == image.size());
+
+  auto a = store->get(ids[0]);
+  auto b = store->get(ids[49]);
+  assert(a->payload == note);
+  assert(a->payload.shares_buffer_with(b->payload));
+  assert(outbox.depth().bytes >= 50 * (note.size() + image.size()));
+
+  // 2) Shared payloads survive a reload
+  {
+    FileOutboxStore reloaded(scfg);
+    assert(reloaded.get(ids[7])->payload == note);
+  }
+
+  // 3) The content lives until its last reference is dropped
+  for (std::size_t i = 0; i + 1 < ids.size(); ++i)
+    store->remove(ids[i]);
+  assert(store->get(ids.back())->payload == note);
+
+  store->remove(ids.back());
+  assert(read_file(scfg.file_path).find("maintenance tonight") == std::string::npos);
+
+  std::cout << "OK: identical payloads are stored once\n";
+  return 0;
+}
@@ -0,0 +1,72 @@
+/**
+ *
+ *  @file sync_outbox_payload_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <vix/sync/outbox/Outbox.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+
+static void reset_test_dir(const std::filesystem::path &dir)
+{
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  std::filesystem::create_directories(dir, ec);
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+
+  const std::filesystem::path test_dir = "./.vix_test_payload";
+  reset_test_dir(test_dir);
+
+  auto store = std::make_shared<FileOutboxStore>(FileOutboxStore::Config{
+      .file_path = test_dir / "outbox.json"});
+  Outbox outbox(Outbox::Config{.owner = "test"}, store);
+
+  Operation op;
+  op.kind = "http.upload";
+  op.target = "/api/images";
+  op.payload = std::string(200 * 1024, 'x');
+
+  const auto *bytes = op.payload.data();
+  const auto id = outbox.enqueue(op, 1'000);
+
+  // 1) The store keeps the enqueued buffer; reads share it
+  auto a = store->get(id);
+  auto b = store->get(id);
+  assert(a && b);
+  assert(a->payload.data() == bytes);
+  assert(a->payload.shares_buffer_with(b->payload));
+
+  auto ready = outbox.peek_ready(1'000);
+  assert(ready.size() == 1);
+  assert(ready[0].payload.data() == bytes);
+
+  // 2) Bytes round-trip through the file
+  {
+    FileOutboxStore reloaded(FileOutboxStore::Config{.file_path = test_dir / "outbox.json"});
+    auto c = reloaded.get(id);
+    assert(c.has_value());
+    assert(c->payload == op.payload);
+    assert(!c->payload.shares_buffer_with(op.payload));
+  }
+
+  std::cout << "OK: payload buffers are shared, not copied\n";
+  return 0;
+}
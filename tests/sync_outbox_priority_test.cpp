@@ -0,0 +1,107 @@
+/**
+ *
+ *  @file sync_outbox_priority_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
+#include <vix/sync/outbox/Outbox.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+
+static void reset_test_dir(const std::filesystem::path &dir)
+{
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  std::filesystem::create_directories(dir, ec);
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+
+  const std::filesystem::path test_dir = "./.vix_test_priority";
+  reset_test_dir(test_dir);
+
+  auto store = std::make_shared<FileOutboxStore>(FileOutboxStore::Config{
+      .file_path = test_dir / "outbox.json",
+      .pretty_json = false,
+      .fsync_on_write = false});
+
+  Outbox outbox(Outbox::Config{.owner = "test"}, store);
+
+  const std::int64_t t0 = 1'000'000;
+
+  // 1) Telemetry backlog (priority 0), then one user-visible message (priority 10)
+  for (int i = 0; i < 20; ++i)
+  {
+    Operation op;
+    op.kind = "telemetry";
+    op.target = "/api/telemetry";
+    outbox.enqueue(op, t0 + i);
+  }
+
+  Operation msg;
+  msg.kind = "chat.send";
+  msg.target = "/api/messages";
+  msg.priority = 10;
+  const auto msg_id = outbox.enqueue(msg, t0 + 100);
+
+  // 2) Highest priority first, then FIFO within a priority
+  auto ready = outbox.peek_ready(t0 + 100, 5);
+  assert(ready.size() == 5);
+  assert(ready[0].id == msg_id);
+  for (std::size_t i = 2; i < ready.size(); ++i)
+    assert(ready[i - 1].created_at_ms <= ready[i].created_at_ms);
+
+  // 3) Depth per priority
+  auto depth = outbox.depth_by_priority();
+  assert(depth.size() == 2);
+  assert(depth[0] == 20);
+  assert(depth[10] == 1);
+
+  assert(outbox.claim(msg_id, t0 + 101));
+  assert(outbox.complete(msg_id, t0 + 102));
+  depth = outbox.depth_by_priority();
+  assert(depth.size() == 1 && depth[0] == 20);
+
+  // 4) Priority is persisted
+  {
+    FileOutboxStore reloaded(FileOutboxStore::Config{.file_path = test_dir / "outbox.json"});
+    auto d = reloaded.depth_by_priority();
+    assert(d.size() == 1 && d[0] == 20);
+    auto done = reloaded.get(msg_id);
+    assert(done.has_value() && done->priority == 10);
+  }
+
+  // 5) Aging: an old low-priority op overtakes a fresh higher-priority one
+  Operation urgent;
+  urgent.kind = "chat.send";
+  urgent.target = "/api/messages";
+  urgent.priority = 2;
+  const auto urgent_id = outbox.enqueue(urgent, t0 + 10'000);
+
+  ListOptions opt;
+  opt.limit = 1;
+  opt.now_ms = t0 + 10'000;
+  opt.priority_aging_ms = 0;
+  assert(store->list(opt)[0].id == urgent_id);
+
+  opt.priority_aging_ms = 1'000; // 2 levels == 2s of waiting; backlog waited ~10s
+  assert(store->list(opt)[0].id != urgent_id);
+  assert(store->list(opt)[0].priority == 0);
+
+  std::cout << "OK: ready ops are returned by priority with aging\n";
+  return 0;
+}
@@ -0,0 +1,206 @@
+/**
+ *
+ *  @file sync_payload_compression_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <vix/sync/Codec.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+#include <vix/sync/wal/Wal.hpp>
+
+static void reset_test_dir(const std::filesystem::path &dir)
+{
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  std::filesystem::create_directories(dir, ec);
+}
+
+static std::string json_like(std::size_t n)
+{
+  std::string s;
+  for (int i = 0; s.size() < n; ++i)
+    s += "{\"id\":" + std::to_string(i) + ",\"status\":\"pending\",\"user\":\"alice\"},";
+  s.resize(n);
+  return s;
+}
+
+static std::string random_bytes(std::size_t n, unsigned seed)
+{
+  std::mt19937 rng(seed);
+  std::string s(n, '\0');
+  for (auto &c : s)
+    c = static_cast<char>(rng() & 0xff);
+  return s;
+}
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+
+  // 1) The in-tree codec is always available and round-trips
+  auto lz = find_codec(CodecId::Lz);
+  assert(lz && lz->name() == "lz");
+  assert(find_codec("lz") == lz);
+  assert(!find_codec(CodecId::None));
+
+  const std::vector<std::string> samples = {
+      "",
+      "a",
+      "abcdefghijkl",
+      std::string(100'000, 'x'),
+      json_like(50'000),
+      random_bytes(10'000, 1),
+      random_bytes(300, 2) + std::string(70'000, 'z') + random_bytes(300, 3),
+  };
+  for (const auto &s : samples)
+    assert(lz->decompress(lz->compress(s), s.size()) == s);
+
+  const auto doc = json_like(8'192);
+  const auto packed = lz->compress(doc);
+  assert(packed.size() * 4 < doc.size());
+
+  // 2) Corrupted input is rejected, never read or written out of bounds
+  bool threw = false;
+  try
+  {
+    lz->decompress(packed.substr(0, packed.size() / 2), doc.size());
+  }
+  catch (const std::runtime_error &)
+  {
+    threw = true;
+  }
+  assert(threw);
+
+  threw = false;
+  try
+  {
+    lz->decompress(packed, doc.size() + 1);
+  }
+  catch (const std::runtime_error &)
+  {
+    threw = true;
+  }
+  assert(threw);
+
+  // 3) Thresholds: small or incompressible payloads stay raw
+  Compression cfg;
+  cfg.codec = CodecId::Lz;
+  cfg.min_bytes = 256;
+  assert(!compress_payload(cfg, json_like(100)).has_value());
+  assert(!compress_payload(cfg, random_bytes(4'096, 4)).has_value());
+  assert(compress_payload(cfg, doc).has_value());
+  assert(!compress_payload(Compression{}, doc).has_value());
+
+  const std::filesystem::path test_dir = "./.vix_test_compression";
+  reset_test_dir(test_dir);
+
+  // 4) WAL: compressed records are flagged and replay decompressed
+  {
+    wal::Wal::Config wcfg;
+    wcfg.file_path = test_dir / "wal.log";
+    wcfg.compression = cfg;
+    wal::Wal w(wcfg);
+
+    wal::WalRecord big;
+    big.id = "op_big";
+    big.type = wal::RecordType::PutOperation;
+    big.payload.assign(doc.begin(), doc.end());
+    w.append(big);
+
+    wal::WalRecord small;
+    small.id = "op_small";
+    small.type = wal::RecordType::PutOperation;
+    small.payload = {'h', 'i'};
+    w.append(small);
+
+    assert(std::filesystem::file_size(wcfg.file_path) < doc.size() / 2);
+
+    std::vector<wal::WalRecord> seen;
+    w.replay(0, [&](const wal::WalRecord &r)
+             { seen.push_back(r); });
+    assert(seen.size() == 2);
+    assert(std::string(seen[0].payload.begin(), seen[0].payload.end()) == doc);
+    assert(seen[1].payload == small.payload);
+  }
+
+  // 5) Store: inline, blob and shared payloads are kept compressed,
+  //    budgets count original bytes, reload restores the original bytes
+  {
+    FileOutboxStore::Config scfg;
+    scfg.file_path = test_dir / "outbox.json";
+    scfg.compression = cfg;
+    scfg.blob_threshold_bytes = 32 * 1024;
+
+    auto store = std::make_shared<FileOutboxStore>(scfg);
+    Outbox outbox(Outbox::Config{.owner = "test"}, store);
+
+    Operation op;
+    op.kind = "http.post";
+    op.target = "/api/messages";
+    op.payload = doc;
+    const auto inline_id = outbox.enqueue(op, 1'000);
+
+    op.payload = json_like(64 * 1024);
+    const auto blob_id = outbox.enqueue(op, 1'001);
+
+    op.payload = "tiny";
+    const auto raw_id = outbox.enqueue(op, 1'002);
+
+    assert(store->get(inline_id)->payload == doc);
+    assert(store->get(blob_id)->payload == json_like(64 * 1024));
+    assert(store->get(raw_id)->payload == "tiny");
+    assert(outbox.depth().bytes > doc.size() + 64 * 1024);
+    assert(std::filesystem::file_size(scfg.file_path) < doc.size());
+    assert(std::filesystem::file_size(test_dir / "outbox.blob.0") < 16 * 1024);
+
+    FileOutboxStore reloaded(scfg);
+    assert(reloaded.get(inline_id)->payload == doc);
+    assert(reloaded.get(blob_id)->payload == json_like(64 * 1024));
+    assert(reloaded.get(raw_id)->payload == "tiny");
+  }
+
+  {
+    FileOutboxStore::Config scfg;
+    scfg.file_path = test_dir / "dedup.json";
+    scfg.compression = cfg;
+    scfg.dedupe_payloads = true;
+
+    auto store = std::make_shared<FileOutboxStore>(scfg);
+    Outbox outbox(Outbox::Config{.owner = "test"}, store);
+
+    Operation op;
+    op.kind = "http.post";
+    op.payload = doc;
+    op.target = "/a";
+    const auto a = outbox.enqueue(op, 1'000);
+    op.target = "/b";
+    const auto b = outbox.enqueue(op, 1'001);
+
+    assert(std::filesystem::file_size(scfg.file_path) < doc.size());
+
+    FileOutboxStore reloaded(scfg);
+    assert(reloaded.get(a)->payload == doc);
+    assert(reloaded.get(b)->payload == doc);
+  }
+
+  std::cout << "OK: payloads are compressed in the WAL and the outbox store\n";
+  return 0;
+}
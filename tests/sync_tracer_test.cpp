@@ -0,0 +1,149 @@
+/**
+ *
+ *  @file sync_tracer_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <vix/sync/Clock.hpp>
+#include <vix/sync/Tracer.hpp>
+#include <vix/sync/engine/SyncEngine.hpp>
+#include <vix/sync/outbox/FileOutboxStore.hpp>
+#include <vix/sync/outbox/Outbox.hpp>
+
+#include "fake_http_transport.hpp"
+
+int main()
+{
+  using namespace vix::sync;
+  using namespace vix::sync::outbox;
+  using namespace vix::sync::engine;
+
+  // 1) Stages from explicit timestamps: one failed attempt, then success
+  {
+    Tracer tracer(Tracer::Config{.keep_spans = true});
+
+    tracer.record("a", TraceEvent::Enqueue, 0);
+    tracer.record("a", TraceEvent::Ready, 100);
+    tracer.record("a", TraceEvent::Ready, 120); // same attempt: ignored
+    tracer.record("a", TraceEvent::Claim, 150);
+    tracer.record("a", TraceEvent::SendStart, 160);
+    tracer.record("a", TraceEvent::SendEnd, 400);
+    tracer.record("a", TraceEvent::Fail, 410);
+    tracer.record("a", TraceEvent::Ready, 1'410);
+    tracer.record("a", TraceEvent::Claim, 1'420);
+    tracer.record("a", TraceEvent::SendStart, 1'420);
+    tracer.record("a", TraceEvent::SendEnd, 1'500);
+    tracer.record("a", TraceEvent::Complete, 1'510);
+
+    // Events of untracked ops are ignored
+    tracer.record("zzz", TraceEvent::Complete, 2'000);
+
+    const auto st = tracer.stats();
+    assert(st.tracked == 0);
+    assert(st.stage(TraceStage::Queue).count == 1);
+    assert(st.stage(TraceStage::Queue).sum == 100);
+    assert(st.stage(TraceStage::RetryWait).sum == 1'000);
+    assert(st.stage(TraceStage::ClaimWait).count == 2);
+    assert(st.stage(TraceStage::ClaimWait).sum == 50 + 10);
+    assert(st.stage(TraceStage::Dispatch).sum == 10);
+    assert(st.stage(TraceStage::Send).count == 2);
+    assert(st.stage(TraceStage::Send).sum == 240 + 80);
+    assert(st.stage(TraceStage::Settle).sum == 10 + 10);
+    assert(st.stage(TraceStage::EndToEnd).count == 1);
+    assert(st.stage(TraceStage::EndToEnd).sum == 1'510);
+    assert(st.attempts.count == 1 && st.attempts.max == 2);
+
+    const auto spans = tracer.spans();
+    assert(spans.size() == 11);
+    assert(spans.back().stage == TraceStage::EndToEnd);
+    assert(spans.back().attempt == 2);
+  }
+
+  // 2) Bounded tracking: the oldest unfinished op is forgotten
+  {
+    Tracer tracer(Tracer::Config{.max_tracked_ops = 2});
+    tracer.record("a", TraceEvent::Enqueue, 0);
+    tracer.record("b", TraceEvent::Enqueue, 1);
+    tracer.record("c", TraceEvent::Enqueue, 2);
+
+    auto st = tracer.stats();
+    assert(st.tracked == 2);
+    assert(st.evicted == 1);
+
+    tracer.record("a", TraceEvent::Complete, 10);
+    tracer.record("c", TraceEvent::Complete, 10);
+    st = tracer.stats();
+    assert(st.stage(TraceStage::EndToEnd).count == 1);
+    assert(st.tracked == 1);
+  }
+
+  // 3) Hooks in Outbox and SyncWorker
+  auto tracer = std::make_shared<Tracer>(Tracer::Config{.keep_spans = true});
+
+  FileOutboxStore::Config scfg;
+  scfg.file_path.clear();
+  auto store = std::make_shared<FileOutboxStore>(scfg);
+
+  Outbox::Config ocfg;
+  ocfg.owner = "test";
+  ocfg.clock = std::make_shared<VirtualClock>(1'000);
+  ocfg.tracer = tracer;
+  auto outbox = std::make_shared<Outbox>(ocfg, store);
+
+  auto transport = std::make_shared<FakeHttpTransport>();
+  transport->setDefault({.ok = true});
+  transport->setRuleForTarget("/bad", {.ok = false, .retryable = false});
+
+  SyncEngine engine(SyncEngine::Config{}, outbox, nullptr, transport);
+  assert(engine.tracer() == tracer);
+
+  for (const char *target : {"/a", "/a", "/b", "/bad"})
+  {
+    Operation op;
+    op.kind = "http.post";
+    op.target = target;
+    op.payload = "{}";
+    outbox->enqueue(op);
+  }
+  assert(tracer->stats().tracked == 4);
+
+  assert(engine.tick() == 4);
+
+  const auto st = tracer->stats();
+  assert(st.tracked == 0);
+  assert(st.stage(TraceStage::EndToEnd).count == 4);
+  assert(st.stage(TraceStage::Queue).count == 4);
+  assert(st.stage(TraceStage::Send).count == 4);
+  assert(st.attempts.max == 1);
+
+  const auto trace = tracer->to_chrome_trace();
+  assert(trace.find("\"traceEvents\"") != std::string::npos);
+  assert(trace.find("\"ph\":\"b\"") != std::string::npos);
+  assert(trace.find("\"end_to_end\"") != std::string::npos);
+
+  // Replaces the previous trace through a temporary file
+  const std::filesystem::path out = "./.vix_test_tracer/trace.json";
+  std::filesystem::create_directories(out.parent_path());
+  std::ofstream(out) << std::string(trace.size() * 2, 'x');
+  tracer->write_chrome_trace(out);
+  assert(std::filesystem::file_size(out) == trace.size());
+  assert(!std::filesystem::exists(std::filesystem::path(out).concat(".tmp")));
+  std::filesystem::remove_all(out.parent_path());
+
+  std::cout << "OK: tracer breaks operation latency down by stage\n";
+  return 0;
+}